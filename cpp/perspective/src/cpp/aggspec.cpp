@@ -10,6 +10,7 @@
 #include <perspective/first.h>
 #include <perspective/aggspec.h>
 #include <perspective/base.h>
+#include <perspective/hyperloglog.h>
 #include <sstream>
 
 namespace perspective {
@@ -65,6 +66,22 @@ t_aggspec::t_aggspec(const std::string& aggname, const std::string& disp_aggname
     , m_agg_one_weight(agg_one_weight)
     , m_agg_two_weight(agg_two_weight) {}
 
+t_aggspec::t_aggspec(const std::string& aggname, t_aggtype agg,
+    const std::vector<t_dep>& dependencies, double quantile)
+    : m_name(aggname)
+    , m_disp_name(aggname)
+    , m_agg(agg)
+    , m_dependencies(dependencies)
+    , m_quantile(quantile) {}
+
+t_aggspec::t_aggspec(
+    const std::string& aggname, const std::vector<t_dep>& dependencies, std::uint8_t precision)
+    : m_name(aggname)
+    , m_disp_name(aggname)
+    , m_agg(AGGTYPE_APPROX_DISTINCT_COUNT)
+    , m_dependencies(dependencies)
+    , m_precision(precision) {}
+
 t_aggspec::~t_aggspec() {}
 
 std::string
@@ -193,6 +210,15 @@ t_aggspec::agg_str() const {
         case AGGTYPE_PCT_SUM_GRAND_TOTAL: {
             return "pct_sum_grand_total";
         }
+        case AGGTYPE_PERCENTILE: {
+            return "percentile";
+        }
+        case AGGTYPE_APPROX_DISTINCT_COUNT: {
+            return "approx_distinct_count";
+        }
+        case AGGTYPE_APPROX_PERCENTILE: {
+            return "approx_percentile";
+        }
         default: {
             PSP_COMPLAIN_AND_ABORT("Unknown agg type");
             return "unknown";
@@ -256,6 +282,19 @@ t_aggspec::get_agg_two_weight() const {
     return m_agg_two_weight;
 }
 
+double
+t_aggspec::get_quantile() const {
+    if (m_agg == AGGTYPE_PERCENTILE || m_agg == AGGTYPE_APPROX_PERCENTILE) {
+        return m_quantile;
+    }
+    return 0.5;
+}
+
+std::uint8_t
+t_aggspec::get_precision() const {
+    return m_agg == AGGTYPE_APPROX_DISTINCT_COUNT ? m_precision : PSP_HLL_DEFAULT_PRECISION;
+}
+
 t_invmode
 t_aggspec::get_inv_mode() const {
     return m_invmode;
@@ -298,6 +337,7 @@ t_aggspec::get_output_specs(const t_schema& schema) const {
         case AGGTYPE_UNIQUE:
         case AGGTYPE_DOMINANT:
         case AGGTYPE_MEDIAN:
+        case AGGTYPE_PERCENTILE:
         case AGGTYPE_FIRST:
         case AGGTYPE_LAST_BY_INDEX:
         case AGGTYPE_OR:
@@ -327,7 +367,8 @@ t_aggspec::get_output_specs(const t_schema& schema) const {
         }
         case AGGTYPE_SCALED_DIV:
         case AGGTYPE_SCALED_ADD:
-        case AGGTYPE_SCALED_MUL: {
+        case AGGTYPE_SCALED_MUL:
+        case AGGTYPE_APPROX_PERCENTILE: {
             return mk_col_name_type_vec(name(), DTYPE_FLOAT64);
         }
         case AGGTYPE_UDF_COMBINER:
@@ -343,7 +384,8 @@ t_aggspec::get_output_specs(const t_schema& schema) const {
         case AGGTYPE_AND: {
             return mk_col_name_type_vec(name(), DTYPE_BOOL);
         }
-        case AGGTYPE_DISTINCT_COUNT: {
+        case AGGTYPE_DISTINCT_COUNT:
+        case AGGTYPE_APPROX_DISTINCT_COUNT: {
             return mk_col_name_type_vec(name(), DTYPE_UINT32);
         }
         default: { PSP_COMPLAIN_AND_ABORT("Unknown agg type"); }
@@ -384,6 +426,27 @@ t_aggspec::is_non_delta() const {
     return false;
 }
 
+bool
+t_aggspec::is_order_statistic() const {
+    return m_agg == AGGTYPE_MEDIAN || m_agg == AGGTYPE_PERCENTILE;
+}
+
+bool
+t_aggspec::tracks_values() const {
+    switch (m_agg) {
+        case AGGTYPE_UNIQUE:
+        case AGGTYPE_JOIN:
+        case AGGTYPE_DISTINCT_COUNT:
+        case AGGTYPE_DISTINCT_LEAF:
+        case AGGTYPE_APPROX_DISTINCT_COUNT:
+        case AGGTYPE_APPROX_PERCENTILE: {
+            return true;
+        }
+        default:
+            return is_order_statistic();
+    }
+}
+
 std::string
 t_aggspec::get_first_depname() const {
     if (m_dependencies.empty())
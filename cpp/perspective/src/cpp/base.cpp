@@ -9,7 +9,10 @@
 
 #include <perspective/first.h>
 #include <perspective/base.h>
+#include <perspective/hyperloglog.h>
+#include <cctype>
 #include <cstdint>
+#include <cstdlib>
 #include <limits>
 #ifdef PSP_ENABLE_WASM
 #include <emscripten.h>
@@ -416,6 +419,94 @@ str_to_sorttype(const std::string& str) {
     }
 }
 
+namespace {
+
+/**
+ * @brief Parse a percentile aggregate string, `p` followed by a number
+ * between 0 and 100, returning false if `str` is not one.
+ */
+bool
+parse_percentile_str(const std::string& str, double& percentile) {
+    if (str.size() < 2 || str[0] != 'p') {
+        return false;
+    }
+
+    const char* begin = str.c_str() + 1;
+    char* end = nullptr;
+    percentile = std::strtod(begin, &end);
+    return std::isdigit(static_cast<unsigned char>(*begin)) && *end == '\0'
+        && percentile >= 0 && percentile <= 100;
+}
+
+bool
+is_percentile_str(const std::string& str) {
+    double percentile;
+    return parse_percentile_str(str, percentile);
+}
+
+/**
+ * @brief Parse an approximate percentile aggregate string, `approx median`
+ * or `approx ` followed by a percentile string, returning false if `str` is
+ * not one.
+ */
+bool
+parse_approx_percentile_str(const std::string& str, double& percentile) {
+    if (str.size() < 8
+        || (str.compare(0, 7, "approx ") != 0 && str.compare(0, 7, "approx_") != 0)) {
+        return false;
+    }
+
+    std::string rest = str.substr(7);
+    if (rest == "median") {
+        percentile = 50;
+        return true;
+    }
+
+    return parse_percentile_str(rest, percentile);
+}
+
+bool
+is_approx_percentile_str(const std::string& str) {
+    double percentile;
+    return parse_approx_percentile_str(str, percentile);
+}
+
+/**
+ * @brief Parse an approximate distinct count aggregate string, returning
+ * false if `str` is not one.
+ */
+bool
+parse_hll_str(const std::string& str, std::uint8_t& precision) {
+    if (str == "approx distinct count" || str == "approx_distinct_count") {
+        precision = PSP_HLL_DEFAULT_PRECISION;
+        return true;
+    }
+
+    if (str.size() < 4 || str.compare(0, 3, "hll") != 0) {
+        return false;
+    }
+
+    const char* begin = str.c_str() + 3;
+    char* end = nullptr;
+    long value = std::strtol(begin, &end, 10);
+
+    if (!std::isdigit(static_cast<unsigned char>(*begin)) || *end != '\0'
+        || value < PSP_HLL_MIN_PRECISION || value > PSP_HLL_MAX_PRECISION) {
+        return false;
+    }
+
+    precision = static_cast<std::uint8_t>(value);
+    return true;
+}
+
+bool
+is_hll_str(const std::string& str) {
+    std::uint8_t precision;
+    return parse_hll_str(str, precision);
+}
+
+} // namespace
+
 t_aggtype
 str_to_aggtype(const std::string& str) {
     if (str == "distinct count" || str == "distinctcount" || str == "distinct"
@@ -477,6 +568,12 @@ str_to_aggtype(const std::string& str) {
         return t_aggtype::AGGTYPE_PCT_SUM_PARENT;
     } else if (str == "pct sum grand total" || str == "pct_sum_grand_total") {
         return t_aggtype::AGGTYPE_PCT_SUM_GRAND_TOTAL;
+    } else if (is_percentile_str(str)) {
+        return t_aggtype::AGGTYPE_PERCENTILE;
+    } else if (is_hll_str(str)) {
+        return t_aggtype::AGGTYPE_APPROX_DISTINCT_COUNT;
+    } else if (is_approx_percentile_str(str)) {
+        return t_aggtype::AGGTYPE_APPROX_PERCENTILE;
     } else if (str.find("udf_combiner_") != std::string::npos) {
         return t_aggtype::AGGTYPE_UDF_COMBINER;
     } else if (str.find("udf_reducer_") != std::string::npos) {
@@ -488,6 +585,26 @@ str_to_aggtype(const std::string& str) {
     }
 }
 
+double
+str_to_quantile(const std::string& str) {
+    double percentile;
+    if (!parse_percentile_str(str, percentile)
+        && !parse_approx_percentile_str(str, percentile)) {
+        PSP_COMPLAIN_AND_ABORT("Encountered unknown percentile aggregate `" + str + "`.");
+    }
+    return percentile / 100;
+}
+
+std::uint8_t
+str_to_hll_precision(const std::string& str) {
+    std::uint8_t precision;
+    if (!parse_hll_str(str, precision)) {
+        PSP_COMPLAIN_AND_ABORT(
+            "Encountered unknown approximate distinct count aggregate `" + str + "`.");
+    }
+    return precision;
+}
+
 t_aggtype
 _get_default_aggregate(t_dtype dtype) {
     t_aggtype agg_op;
@@ -14,14 +14,18 @@ SUPPRESS_WARNINGS_VC(4505)
 #include <perspective/defaults.h>
 #include <perspective/base.h>
 #include <perspective/sym_table.h>
+#include <perspective/snapshot.h>
 #include <tsl/hopscotch_set.h>
+#include <bitset>
 
 namespace perspective {
 // TODO : move to delegated constructors in C++11
 
 t_column_recipe::t_column_recipe()
     : m_vlenidx(0)
-    , m_size(0) {}
+    , m_size(0)
+    , m_status_enabled(false)
+    , m_status_packed(false) {}
 
 t_column::t_column()
     : m_dtype(DTYPE_NONE)
@@ -30,8 +34,10 @@ t_column::t_column()
     , m_data(nullptr)
     , m_vocab(nullptr)
     , m_status(nullptr)
+    , m_cleared(nullptr)
     , m_size(0)
     , m_status_enabled(false)
+    , m_status_packed(false)
     , m_from_recipe(false)
 
 {
@@ -43,6 +49,7 @@ t_column::t_column(const t_column_recipe& recipe)
     , m_init(false)
     , m_size(recipe.m_size)
     , m_status_enabled(recipe.m_status_enabled)
+    , m_status_packed(recipe.m_status_enabled && recipe.m_status_packed)
     , m_from_recipe(true)
 
 {
@@ -61,6 +68,12 @@ t_column::t_column(const t_column_recipe& recipe)
     } else {
         m_status.reset(new t_lstore);
     }
+
+    if (m_status_packed) {
+        m_cleared.reset(new t_lstore(recipe.m_cleared));
+    } else {
+        m_cleared.reset(new t_lstore);
+    }
 }
 
 void
@@ -68,13 +81,15 @@ t_column::column_copy_helper(const t_column& other) {
     m_dtype = other.m_dtype;
     m_init = false;
     m_isvlen = other.m_isvlen;
-    m_data.reset(new t_lstore(other.m_data->get_recipe()));
-    m_vocab.reset(new t_vocab(other.m_vocab->get_vlendata()->get_recipe(),
-        other.m_vocab->get_extents()->get_recipe()));
-    m_status.reset(new t_lstore(other.m_status->get_recipe()));
+    m_data.reset(new t_lstore(other.m_data->get_empty_recipe()));
+    m_vocab.reset(new t_vocab(other.m_vocab->get_vlendata()->get_empty_recipe(),
+        other.m_vocab->get_extents()->get_empty_recipe()));
+    m_status.reset(new t_lstore(other.m_status->get_empty_recipe()));
+    m_cleared.reset(new t_lstore(other.m_cleared->get_empty_recipe()));
 
     m_size = other.m_size;
     m_status_enabled = other.m_status_enabled;
+    m_status_packed = other.m_status_packed;
     m_from_recipe = false;
 }
 
@@ -101,6 +116,7 @@ t_column::t_column(
     , m_init(false)
     , m_size(0)
     , m_status_enabled(missing_enabled)
+    , m_status_packed(false)
     , m_from_recipe(false) {
 
     m_data.reset(new t_lstore(a));
@@ -134,6 +150,8 @@ t_column::t_column(
     } else {
         m_status.reset(new t_lstore);
     }
+
+    m_cleared.reset(new t_lstore);
 }
 
 bool
@@ -141,6 +159,223 @@ t_column::is_status_enabled() const {
     return m_status_enabled;
 }
 
+bool
+t_column::is_status_packed() const {
+    return m_status_packed;
+}
+
+t_memory_report
+t_column::get_memory_usage() const {
+    t_memory_report rval;
+    rval.push_back(perspective::get_memory_usage("data", *m_data));
+
+    t_memory_usage status = perspective::get_memory_usage("status", *m_status);
+    status += perspective::get_memory_usage("status", *m_cleared);
+    rval.push_back(status);
+
+    if (m_isvlen) {
+        rval.push_back(m_vocab->get_memory_usage("vocab"));
+    }
+
+    return rval;
+}
+
+void
+t_column::set_access_hint(t_access_hint hint) {
+    m_data->set_access_hint(hint);
+    m_vocab->get_vlendata()->set_access_hint(hint);
+    m_vocab->get_extents()->set_access_hint(hint);
+    m_status->set_access_hint(hint);
+    m_cleared->set_access_hint(hint);
+}
+
+t_uindex
+t_column::status_nbytes(t_uindex num_rows) const {
+    if (m_status_packed) {
+        return ((num_rows + 63) / 64) * sizeof(std::uint64_t);
+    }
+
+    return num_rows * sizeof(t_status);
+}
+
+void
+t_column::resize_status(t_uindex num_rows) {
+    t_uindex nbytes = status_nbytes(num_rows);
+    m_status->reserve(nbytes);
+    m_status->set_size(nbytes);
+
+    if (m_status_packed) {
+        m_cleared->reserve(nbytes);
+        m_cleared->set_size(nbytes);
+    }
+}
+
+void
+t_column::push_status(t_uindex idx, t_status status) {
+    if (!m_status_packed) {
+        m_status->push_back(status);
+        return;
+    }
+
+    resize_status(idx + 1);
+    set_status(idx, status);
+}
+
+void
+t_column::fill_status(const t_column& other) {
+    if (m_status_packed == other.m_status_packed) {
+        m_status->fill(*other.m_status);
+        if (m_status_packed) {
+            m_cleared->fill(*other.m_cleared);
+        }
+        return;
+    }
+
+    resize_status(other.size());
+    copy_status(other, 0, 0, other.size());
+}
+
+void
+t_column::set_status_packed(bool packed) {
+    if (!is_status_enabled() || packed == m_status_packed) {
+        return;
+    }
+
+    t_uindex num_rows = size();
+    std::vector<t_status> statuses(num_rows);
+    for (t_uindex idx = 0; idx < num_rows; ++idx) {
+        statuses[idx] = get_status(idx);
+    }
+
+    t_uindex elem_size = get_dtype_size(m_dtype);
+    t_uindex row_capacity
+        = elem_size > 0 ? std::max(num_rows, m_data->capacity() / elem_size) : num_rows;
+    t_lstore_recipe status_args(m_status->get_empty_recipe());
+    t_lstore_recipe cleared_args(status_args);
+    cleared_args.m_colname = status_args.m_colname + std::string("_cleared");
+
+    // Release the old stores before creating new ones from their recipes.
+    m_status.reset();
+    m_cleared.reset();
+    m_status_packed = packed;
+
+    status_args.m_capacity = status_nbytes(row_capacity);
+    m_status.reset(new t_lstore(status_args));
+    m_status->init();
+
+    if (m_status_packed) {
+        cleared_args.m_capacity = status_nbytes(row_capacity);
+        m_cleared.reset(new t_lstore(cleared_args));
+        m_cleared->init();
+    } else {
+        m_cleared.reset(new t_lstore);
+    }
+
+    resize_status(num_rows);
+    for (t_uindex idx = 0; idx < num_rows; ++idx) {
+        set_status(idx, statuses[idx]);
+    }
+}
+
+std::uint64_t
+t_column::get_valid_word(t_uindex offset, t_uindex num_rows) const {
+    std::uint64_t rows_mask = num_rows >= 64 ? ~std::uint64_t(0)
+                                             : (std::uint64_t(1) << num_rows) - 1;
+
+    if (!is_status_enabled() || num_rows == 0) {
+        return rows_mask;
+    }
+
+    if (!m_status_packed) {
+        const t_status* status = m_status->get_nth<t_status>(offset);
+        std::uint64_t rval = 0;
+        for (t_uindex idx = 0; idx < num_rows; ++idx) {
+            rval |= std::uint64_t(status[idx] == STATUS_VALID) << idx;
+        }
+        return rval;
+    }
+
+    const std::uint64_t* words = m_status->get_nth<std::uint64_t>(offset >> 6);
+    t_uindex shift = offset & 63;
+    std::uint64_t rval = words[0] >> shift;
+
+    if (shift != 0 && shift + num_rows > 64) {
+        rval |= words[1] << (64 - shift);
+    }
+
+    return rval & rows_mask;
+}
+
+t_uindex
+t_column::count_valid() const {
+    t_uindex num_rows = size();
+    t_uindex rval = 0;
+
+    if (!is_status_enabled()) {
+        return num_rows;
+    }
+
+    if (!m_status_packed) {
+        for (t_uindex idx = 0; idx < num_rows; ++idx) {
+            rval += get_status(idx) == STATUS_VALID;
+        }
+        return rval;
+    }
+
+    for (t_uindex offset = 0; offset < num_rows; offset += 64) {
+        t_uindex block_rows = std::min(num_rows - offset, t_uindex(64));
+        rval += std::bitset<64>(get_valid_word(offset, block_rows)).count();
+    }
+
+    return rval;
+}
+
+t_mask
+t_column::get_valid_mask() const {
+    const t_uindex bits_per_block = t_mask::BITS_PER_BLOCK;
+    t_uindex num_rows = size();
+    std::vector<t_mask::t_block> blocks((num_rows + bits_per_block - 1) / bits_per_block);
+
+    for (t_uindex bidx = 0, loop_end = blocks.size(); bidx < loop_end; ++bidx) {
+        t_uindex offset = bidx * bits_per_block;
+        t_uindex block_rows = std::min(num_rows - offset, bits_per_block);
+        blocks[bidx] = static_cast<t_mask::t_block>(get_valid_word(offset, block_rows));
+    }
+
+    return t_mask(blocks, num_rows);
+}
+
+const std::uint64_t*
+t_column::get_validity_bitmap() const {
+    PSP_VERBOSE_ASSERT(m_status_packed, "Status is not packed for column");
+    return m_status->get_nth<std::uint64_t>(0);
+}
+
+void
+t_column::copy_status(
+    const t_column& other, t_uindex src_offset, t_uindex dst_offset, t_uindex num_rows) {
+    t_uindex idx = 0;
+
+    // Copy whole words between packed columns at word-aligned offsets.
+    if (m_status_packed && other.m_status_packed && src_offset % 64 == 0
+        && dst_offset % 64 == 0) {
+        t_uindex num_words = num_rows / 64;
+        if (num_words > 0) {
+            std::memcpy(m_status->get_nth<std::uint64_t>(dst_offset / 64),
+                other.m_status->get_nth<std::uint64_t>(src_offset / 64),
+                num_words * sizeof(std::uint64_t));
+            std::memcpy(m_cleared->get_nth<std::uint64_t>(dst_offset / 64),
+                other.m_cleared->get_nth<std::uint64_t>(src_offset / 64),
+                num_words * sizeof(std::uint64_t));
+        }
+        idx = num_words * 64;
+    }
+
+    for (; idx < num_rows; ++idx) {
+        set_status(dst_offset + idx, other.get_status(src_offset + idx));
+    }
+}
+
 void
 t_column::init() {
     LOG_INIT("t_column");
@@ -155,6 +390,10 @@ t_column::init() {
         m_status->init();
     }
 
+    if (m_status_packed) {
+        m_cleared->init();
+    }
+
     if (is_deterministic_sized(m_dtype))
         m_elemsize = get_dtype_size(m_dtype);
     m_init = true;
@@ -177,9 +416,7 @@ t_column::extend_dtype(t_uindex idx) {
     m_size = m_data->size() / get_dtype_size(m_dtype);
 
     if (is_status_enabled()) {
-        t_uindex sz = idx * get_dtype_size(DTYPE_UINT8);
-        m_status->reserve(sz);
-        m_status->set_size(sz);
+        resize_status(idx);
     }
 }
 
@@ -230,7 +467,7 @@ void
 t_column::push_back<const char*>(const char* elem, t_status status) {
     COLUMN_CHECK_STRCOL();
     push_back(elem);
-    m_status->push_back(status);
+    push_status(m_data->size() / sizeof(t_uindex) - 1, status);
     ++m_size;
 }
 
@@ -239,7 +476,7 @@ void
 t_column::push_back<char*>(char* elem, t_status status) {
     COLUMN_CHECK_STRCOL();
     push_back(elem);
-    m_status->push_back(status);
+    push_status(m_data->size() / sizeof(t_uindex) - 1, status);
     ++m_size;
 }
 
@@ -248,7 +485,7 @@ void
 t_column::push_back<std::string>(std::string elem, t_status status) {
     COLUMN_CHECK_STRCOL();
     push_back(elem);
-    m_status->push_back(status);
+    push_status(m_data->size() / sizeof(t_uindex) - 1, status);
     ++m_size;
 }
 
@@ -330,15 +567,116 @@ t_column::set_size(t_uindex size) {
     m_size = size;
     m_data->set_size(m_elemsize * size);
 
-    if (is_status_enabled())
-        m_status->set_size(get_dtype_size(DTYPE_UINT8) * size);
+    if (is_status_enabled()) {
+        if (m_status_packed) {
+            resize_status(size);
+        } else {
+            m_status->set_size(status_nbytes(size));
+        }
+    }
+}
+
+void
+t_column::shrink(t_uindex size) {
+    m_data->shrink(m_elemsize * size);
+    if (is_status_enabled()) {
+        m_status->shrink(status_nbytes(size));
+        if (m_status_packed) {
+            m_cleared->shrink(status_nbytes(size));
+        }
+    }
+}
+
+void
+t_column::save(t_snapshot_writer& writer) const {
+    if (m_dtype == DTYPE_OBJECT) {
+        PSP_COMPLAIN_AND_ABORT("Cannot snapshot a column of objects");
+    }
+
+    writer.write<std::uint32_t>(m_dtype);
+    writer.write<std::uint8_t>(is_status_enabled());
+    writer.write<std::uint8_t>(m_status_packed);
+    writer.write<std::uint64_t>(m_size);
+    writer.write(*m_data);
+
+    if (is_status_enabled()) {
+        writer.write(*m_status);
+        if (m_status_packed) {
+            writer.write(*m_cleared);
+        }
+    }
+
+    if (m_dtype == DTYPE_STR) {
+        writer.write<std::uint64_t>(m_vocab->get_vlenidx());
+        writer.write(*m_vocab->get_vlendata());
+        writer.write(*m_vocab->get_extents());
+    }
+}
+
+void
+t_column::load(t_snapshot_reader& reader) {
+    t_dtype dtype = static_cast<t_dtype>(reader.read<std::uint32_t>());
+    bool status_enabled = reader.read<std::uint8_t>() != 0;
+    bool status_packed = reader.read<std::uint8_t>() != 0;
+    t_uindex size = reader.read<std::uint64_t>();
+
+    if (dtype != m_dtype || status_enabled != is_status_enabled()) {
+        PSP_COMPLAIN_AND_ABORT("Snapshot column does not match the schema");
+    }
+
+    set_status_packed(status_packed);
+    reader.read(*m_data);
+    PSP_VERBOSE_ASSERT(m_data->size() == size * m_elemsize, "Snapshot column is corrupt");
+
+    if (status_enabled) {
+        reader.read(*m_status);
+        if (m_status_packed) {
+            reader.read(*m_cleared);
+        }
+    }
+
+    if (m_dtype == DTYPE_STR) {
+        t_uindex vlenidx = reader.read<std::uint64_t>();
+        reader.read(*m_vocab->get_vlendata());
+        reader.read(*m_vocab->get_extents());
+        m_vocab->set_vlenidx(vlenidx);
+        m_vocab->rebuild_map();
+    }
+
+    m_size = size;
+}
+
+void
+t_column::copy_rows(const std::vector<t_uindex>& src, const std::vector<t_uindex>& dst) {
+    PSP_VERBOSE_ASSERT(src.size() == dst.size(), "Mismatched row counts");
+    unsigned char* base = static_cast<unsigned char*>(m_data->get_ptr(0));
+    bool status_enabled = is_status_enabled();
+
+    for (t_uindex idx = 0, loop_end = src.size(); idx < loop_end; ++idx) {
+        memcpy(base + dst[idx] * m_elemsize, base + src[idx] * m_elemsize, m_elemsize);
+        if (status_enabled) {
+            set_status(dst[idx], get_status(src[idx]));
+        }
+    }
 }
 
 void
 t_column::reserve(t_uindex size) {
     m_data->reserve(get_dtype_size(m_dtype) * size);
-    if (is_status_enabled())
-        m_status->reserve(get_dtype_size(DTYPE_UINT8) * size);
+    if (is_status_enabled()) {
+        m_status->reserve(status_nbytes(size));
+        if (m_status_packed) {
+            m_cleared->reserve(status_nbytes(size));
+        }
+    }
+}
+
+void
+t_column::detach_pool() {
+    m_data->detach_pool();
+    m_status->detach_pool();
+    m_cleared->detach_pool();
+    m_vocab->detach_pool();
 }
 
 //object storage, specialize only for std::uint64_t
@@ -346,7 +684,7 @@ template <>
 void t_column::object_copied<std::uint64_t>(std::uint64_t ptr) const {}
 
 void t_column::notify_object_copied(std::uint64_t idx) const {
-    if (*get_nth_status(idx) == STATUS_VALID)
+    if (get_status(idx) == STATUS_VALID)
         object_copied<PSP_OBJECT_TYPE>(*(get_nth<std::uint64_t>(idx)));
 }
 
@@ -354,7 +692,7 @@ template <>
 void t_column::object_cleared<std::uint64_t>(std::uint64_t ptr) const {}
 
 void t_column::notify_object_cleared(std::uint64_t idx) const {
-    if (*get_nth_status(idx) == STATUS_VALID)
+    if (get_status(idx) == STATUS_VALID)
         object_cleared<PSP_OBJECT_TYPE>(*(get_nth<std::uint64_t>(idx)));
 }
 
@@ -446,7 +784,7 @@ t_column::get_scalar(t_uindex idx) const {
     }
 
     if (is_status_enabled())
-        rv.m_status = *get_nth_status(idx);
+        rv.m_status = get_status(idx);
     return rv;
 }
 
@@ -522,6 +860,7 @@ t_column::get_nth<const char>(t_uindex idx) const {
 const t_status*
 t_column::get_nth_status(t_uindex idx) const {
     PSP_VERBOSE_ASSERT(is_status_enabled(), "Status not available for column");
+    PSP_VERBOSE_ASSERT(!m_status_packed, "Status is packed for column");
     COLUMN_CHECK_ACCESS(idx);
     t_status* status = m_status->get_nth<t_status>(idx);
     return status;
@@ -530,17 +869,13 @@ t_column::get_nth_status(t_uindex idx) const {
 bool
 t_column::is_valid(t_uindex idx) const {
     PSP_VERBOSE_ASSERT(is_status_enabled(), "Status not available for column");
-    COLUMN_CHECK_ACCESS(idx);
-    t_status status = *m_status->get_nth<t_status>(idx);
-    return status == STATUS_VALID;
+    return get_status(idx) == STATUS_VALID;
 }
 
 bool
 t_column::is_cleared(t_uindex idx) const {
     PSP_VERBOSE_ASSERT(is_status_enabled(), "Status not available for column");
-    COLUMN_CHECK_ACCESS(idx);
-    t_status status = *m_status->get_nth<t_status>(idx);
-    return status == STATUS_CLEAR;
+    return get_status(idx) == STATUS_CLEAR;
 }
 
 template <>
@@ -576,11 +911,6 @@ t_column::set_valid(t_uindex idx, bool valid) {
     set_status(idx, valid ? STATUS_VALID : STATUS_INVALID);
 }
 
-void
-t_column::set_status(t_uindex idx, t_status status) {
-    m_status->set_nth<t_status>(idx, status);
-}
-
 void
 t_column::set_scalar(t_uindex idx, t_tscalar value) {
     COLUMN_CHECK_ACCESS(idx);
@@ -676,7 +1006,7 @@ t_column::append(const t_column& other) {
             m_data->fill(*other.m_data);
 
             if (other.is_status_enabled()) {
-                m_status->fill(*other.m_status);
+                fill_status(other);
             }
 
             m_vocab->fill(*(other.m_vocab->get_vlendata()), *(other.m_vocab->get_extents()),
@@ -685,20 +1015,33 @@ t_column::append(const t_column& other) {
             set_size(other.size());
             m_vocab->rebuild_map();
         } else {
+            t_uindex offset = m_size;
+
             for (t_uindex idx = 0, loop_end = other.size(); idx < loop_end; ++idx) {
                 const char* s = other.get_nth<const char>(idx);
                 push_back(s);
             }
 
             if (is_status_enabled()) {
-                m_status->append(*other.m_status);
+                if (m_status_packed || other.m_status_packed) {
+                    resize_status(offset + other.size());
+                    copy_status(other, 0, offset, other.size());
+                } else {
+                    m_status->append(*other.m_status);
+                }
             }
         }
     } else {
+        t_uindex offset = m_size;
         m_data->append(*other.m_data);
 
         if (is_status_enabled()) {
-            m_status->append(*other.m_status);
+            if (m_status_packed || other.m_status_packed) {
+                resize_status(offset + other.size());
+                copy_status(other, 0, offset, other.size());
+            } else {
+                m_status->append(*other.m_status);
+            }
         }
     }
     COLUMN_CHECK_VALUES();
@@ -713,6 +1056,9 @@ t_column::clear() {
     if (is_status_enabled()) {
         m_status->clear();
     }
+    if (m_status_packed) {
+        m_cleared->clear();
+    }
     m_size = 0;
 }
 
@@ -744,9 +1090,13 @@ t_column::get_recipe() const {
     }
 
     rval.m_status_enabled = m_status_enabled;
+    rval.m_status_packed = m_status_packed;
     if (m_status_enabled) {
         rval.m_status = m_status->get_recipe();
     }
+    if (m_status_packed) {
+        rval.m_cleared = m_cleared->get_recipe();
+    }
 
     rval.m_vlenidx = get_vlenidx();
     rval.m_size = m_size;
@@ -781,6 +1131,10 @@ t_column::clone() const {
         rval->m_status->fill(*m_status);
     }
 
+    if (rval->m_status_packed) {
+        rval->m_cleared->fill(*m_cleared);
+    }
+
     if (is_vlen_dtype(get_dtype())) {
         rval->m_vocab->clone(*m_vocab);
     }
@@ -804,7 +1158,15 @@ t_column::clone(const t_mask& mask) const {
     rval->m_data->fill(*m_data, mask, get_dtype_size(get_dtype()));
 
     if (rval->is_status_enabled()) {
-        rval->m_status->fill(*m_status, mask, sizeof(t_status));
+        if (m_status_packed) {
+            t_uindex dst = 0;
+            for (t_uindex idx = mask.find_first(); idx < mask.size();
+                 idx = mask.find_next(idx)) {
+                rval->set_status(dst++, get_status(idx));
+            }
+        } else {
+            rval->m_status->fill(*m_status, mask, sizeof(t_status));
+        }
     }
 
     if (is_vlen_dtype(get_dtype())) {
@@ -816,9 +1178,36 @@ t_column::clone(const t_mask& mask) const {
     return rval;
 }
 
+void
+t_column::retain(const t_mask& mask) {
+    PSP_VERBOSE_ASSERT(mask.size() == size(), "Mask does not match the column size");
+    unsigned char* base = static_cast<unsigned char*>(m_data->get_ptr(0));
+    bool status_enabled = is_status_enabled();
+    t_uindex dst = 0;
+
+    // Rows only move towards the front, so each row is read before it is
+    // overwritten.
+    for (t_uindex idx = mask.find_first(); idx < mask.size(); idx = mask.find_next(idx)) {
+        if (idx != dst) {
+            memcpy(base + dst * m_elemsize, base + idx * m_elemsize, m_elemsize);
+            if (status_enabled) {
+                set_status(dst, get_status(idx));
+            }
+        }
+        ++dst;
+    }
+
+    set_size(dst);
+}
+
 void
 t_column::valid_raw_fill() {
-    m_status->raw_fill(STATUS_VALID);
+    if (m_status_packed) {
+        m_status->raw_fill(~std::uint64_t(0));
+        m_cleared->raw_fill(std::uint64_t(0));
+    } else {
+        m_status->raw_fill(STATUS_VALID);
+    }
 }
 
 void
@@ -927,7 +1316,7 @@ t_column::verify_size(t_uindex idx) const {
         "Not enough space reserved for column");
 
     if (is_status_enabled()) {
-        PSP_VERBOSE_ASSERT(idx * get_dtype_size(DTYPE_UINT8) <= m_status->capacity(),
+        PSP_VERBOSE_ASSERT(status_nbytes(idx) <= m_status->capacity(),
             "Not enough space reserved for column");
     }
 
@@ -956,4 +1345,45 @@ t_column::borrow_vocabulary(const t_column& o) {
     m_vocab = const_cast<t_column&>(o).m_vocab;
 }
 
+t_uindex
+t_column::compact_vocabulary() {
+    std::vector<t_uindex> remap;
+    return compact_vocabulary(remap);
+}
+
+t_uindex
+t_column::compact_vocabulary(std::vector<t_uindex>& remap) {
+    remap.clear();
+
+    if (m_dtype != DTYPE_STR || size() == 0) {
+        return 0;
+    }
+
+    t_uindex num_rows = size();
+    t_uindex* base = m_data->get_nth<t_uindex>(0);
+    std::vector<bool> live(m_vocab->get_vlenidx(), false);
+
+    // Cleared rows hold id 0, which must keep its id.
+    if (!live.empty()) {
+        live[0] = true;
+    }
+
+    for (t_uindex idx = 0; idx < num_rows; ++idx) {
+        live[base[idx]] = true;
+    }
+
+    t_uindex reclaimed = m_vocab->compact(live, remap);
+
+    if (reclaimed == 0) {
+        remap.clear();
+        return 0;
+    }
+
+    for (t_uindex idx = 0; idx < num_rows; ++idx) {
+        base[idx] = remap[base[idx]];
+    }
+
+    return reclaimed;
+}
+
 } // end namespace perspective
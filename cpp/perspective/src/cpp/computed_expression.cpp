@@ -14,6 +14,8 @@ namespace perspective {
 std::shared_ptr<exprtk::parser<t_tscalar>>
 t_computed_expression_parser::PARSER = std::make_shared<exprtk::parser<t_tscalar>>();
 
+std::mutex t_computed_expression_parser::PARSER_MUTEX;
+
 // Exprtk functions without any state can be initialized statically
 computed_function::bucket t_computed_expression_parser::BUCKET_FN
     = computed_function::bucket();
@@ -63,34 +65,7 @@ computed_function::length
 t_computed_expression_parser::LENGTH_VALIDATOR_FN = computed_function::length(nullptr);
 
 // Register functions in a centralized macro instead of copy-pasting the same
-// lines between compute/recompute
-#define REGISTER_COMPUTE_FUNCTIONS()                                                        \
-    computed_function::day_of_week day_of_week_fn = computed_function::day_of_week(m_expression_vocab);         \
-    computed_function::month_of_year month_of_year_fn = computed_function::month_of_year(m_expression_vocab);   \
-    computed_function::intern intern_fn = computed_function::intern(m_expression_vocab);    \
-    computed_function::concat concat_fn = computed_function::concat(m_expression_vocab);    \
-    computed_function::order order_fn = computed_function::order(m_expression_vocab);       \
-    computed_function::upper upper_fn = computed_function::upper(m_expression_vocab);       \
-    computed_function::lower lower_fn = computed_function::lower(m_expression_vocab);       \
-    computed_function::length length_fn = computed_function::length(m_expression_vocab);    \
-    sym_table.add_function("today", computed_function::today);                              \
-    sym_table.add_function("now", computed_function::now);                                  \
-    sym_table.add_function("bucket", t_computed_expression_parser::BUCKET_FN);              \
-    sym_table.add_function("hour_of_day", t_computed_expression_parser::HOUR_OF_DAY_FN);    \
-    sym_table.add_function("day_of_week", day_of_week_fn);                                  \
-    sym_table.add_function("month_of_year", month_of_year_fn);                              \
-    sym_table.add_function("intern", intern_fn);                                            \
-    sym_table.add_function("concat", concat_fn);                                            \
-    sym_table.add_function("order", order_fn);                                              \
-    sym_table.add_function("upper", upper_fn);                                              \
-    sym_table.add_function("lower", lower_fn);                                              \
-    sym_table.add_function("length", length_fn);                                            \
-    sym_table.add_reserved_function("min", t_computed_expression_parser::MIN_FN);           \
-    sym_table.add_reserved_function("max", t_computed_expression_parser::MAX_FN);           \
-    sym_table.add_function("percent_of", t_computed_expression_parser::PERCENT_OF_FN);      \
-    sym_table.add_function("is_null", t_computed_expression_parser::IS_NULL_FN);            \
-    sym_table.add_function("is_not_null", t_computed_expression_parser::IS_NOT_NULL_FN);    \
-
+// lines between precompute/get_dtype
 #define REGISTER_VALIDATION_FUNCTIONS()                                                     \
     sym_table.add_function("today", computed_function::today);                              \
     sym_table.add_function("now", computed_function::now);                                  \
@@ -110,6 +85,52 @@ t_computed_expression_parser::LENGTH_VALIDATOR_FN = computed_function::length(nu
     sym_table.add_function("is_null", t_computed_expression_parser::IS_NULL_FN);            \
     sym_table.add_function("is_not_null", t_computed_expression_parser::IS_NOT_NULL_FN);    \
 
+/******************************************************************************
+ *
+ * t_compiled_expression
+ */
+
+t_compiled_expression::t_compiled_expression(
+    std::shared_ptr<t_vocab> expression_vocab,
+    const std::vector<std::pair<std::string, std::string>>& column_ids)
+    : m_day_of_week_fn(expression_vocab)
+    , m_month_of_year_fn(expression_vocab)
+    , m_intern_fn(expression_vocab)
+    , m_concat_fn(expression_vocab)
+    , m_order_fn(expression_vocab)
+    , m_upper_fn(expression_vocab)
+    , m_lower_fn(expression_vocab)
+    , m_length_fn(expression_vocab)
+    , m_values(column_ids.size())
+    , m_lowered(false)
+    , m_vectorized(nullptr) {
+    m_sym_table.add_constants();
+
+    m_sym_table.add_function("today", computed_function::today);
+    m_sym_table.add_function("now", computed_function::now);
+    m_sym_table.add_function("bucket", t_computed_expression_parser::BUCKET_FN);
+    m_sym_table.add_function("hour_of_day", t_computed_expression_parser::HOUR_OF_DAY_FN);
+    m_sym_table.add_function("day_of_week", m_day_of_week_fn);
+    m_sym_table.add_function("month_of_year", m_month_of_year_fn);
+    m_sym_table.add_function("intern", m_intern_fn);
+    m_sym_table.add_function("concat", m_concat_fn);
+    m_sym_table.add_function("order", m_order_fn);
+    m_sym_table.add_function("upper", m_upper_fn);
+    m_sym_table.add_function("lower", m_lower_fn);
+    m_sym_table.add_function("length", m_length_fn);
+    m_sym_table.add_reserved_function("min", t_computed_expression_parser::MIN_FN);
+    m_sym_table.add_reserved_function("max", t_computed_expression_parser::MAX_FN);
+    m_sym_table.add_function("percent_of", t_computed_expression_parser::PERCENT_OF_FN);
+    m_sym_table.add_function("is_null", t_computed_expression_parser::IS_NULL_FN);
+    m_sym_table.add_function("is_not_null", t_computed_expression_parser::IS_NOT_NULL_FN);
+
+    for (t_uindex cidx = 0, loop_end = column_ids.size(); cidx < loop_end; ++cidx) {
+        m_sym_table.add_variable(column_ids[cidx].first, m_values[cidx]);
+    }
+
+    m_expression.register_symbol_table(m_sym_table);
+}
+
 /******************************************************************************
  *
  * t_computed_expression
@@ -128,40 +149,43 @@ t_computed_expression::t_computed_expression(
     , m_expression_vocab(nullptr)
     , m_dtype(dtype) {}
 
-void
-t_computed_expression::compute(
-    std::shared_ptr<t_data_table> data_table) const {
-    // TODO: share symtables across pre/re/compute
-    exprtk::symbol_table<t_tscalar> sym_table;
-    sym_table.add_constants();
-
-    REGISTER_COMPUTE_FUNCTIONS()
-
-    exprtk::expression<t_tscalar> expr_definition;
-    std::vector<std::pair<std::string, t_tscalar>> values;
-    tsl::hopscotch_map<std::string, std::shared_ptr<t_column>> columns;
-
-    auto num_input_columns = m_column_ids.size();
-    values.resize(num_input_columns);
-    columns.reserve(num_input_columns);
-
-    for (t_uindex cidx = 0; cidx < num_input_columns; ++cidx) {
-        const std::string& column_id = m_column_ids[cidx].first;
-        const std::string& column_name = m_column_ids[cidx].second;
-        columns[column_id] = data_table->get_column(column_name);
+t_computed_expression::t_computed_expression(const t_computed_expression& other)
+    : m_expression_alias(other.m_expression_alias)
+    , m_expression_string(other.m_expression_string)
+    , m_parsed_expression_string(other.m_parsed_expression_string)
+    , m_column_ids(other.m_column_ids)
+    , m_expression_vocab(other.m_expression_vocab)
+    , m_dtype(other.m_dtype) {}
+
+t_computed_expression&
+t_computed_expression::operator=(const t_computed_expression& other) {
+    if (this != &other) {
+        m_expression_alias = other.m_expression_alias;
+        m_expression_string = other.m_expression_string;
+        m_parsed_expression_string = other.m_parsed_expression_string;
+        m_column_ids = other.m_column_ids;
+        m_expression_vocab = other.m_expression_vocab;
+        m_dtype = other.m_dtype;
+        m_compiled_expression.reset();
+    }
+    return *this;
+}
 
-        t_tscalar rval;
-        rval.m_type = columns[column_id]->get_dtype();
+t_compiled_expression&
+t_computed_expression::get_compiled_expression(const char* caller) const {
+    std::lock_guard<std::mutex> lock(t_computed_expression_parser::PARSER_MUTEX);
 
-        values[cidx] = std::pair<std::string, t_tscalar>(column_id, rval);
-        sym_table.add_variable(column_id, values[cidx].second);
+    if (m_compiled_expression != nullptr) {
+        return *m_compiled_expression;
     }
 
-    expr_definition.register_symbol_table(sym_table);
+    std::unique_ptr<t_compiled_expression> compiled(
+        new t_compiled_expression(m_expression_vocab, m_column_ids));
 
-    if (!t_computed_expression_parser::PARSER->compile(m_parsed_expression_string, expr_definition)) {
+    if (!t_computed_expression_parser::PARSER->compile(
+            m_parsed_expression_string, compiled->m_expression)) {
         std::stringstream ss;
-        ss << "[t_computed_expression::compute] Failed to parse expression: `"
+        ss << "[" << caller << "] Failed to parse expression: `"
             << m_parsed_expression_string
             << "`, failed with error: "
             << t_computed_expression_parser::PARSER->error()
@@ -170,6 +194,52 @@ t_computed_expression::compute(
         PSP_COMPLAIN_AND_ABORT(ss.str());
     }
 
+    m_compiled_expression = std::move(compiled);
+    return *m_compiled_expression;
+}
+
+const t_vectorized_expression*
+t_computed_expression::get_vectorized_expression(
+    t_compiled_expression& compiled, const std::vector<t_dtype>& input_dtypes) const {
+    if (m_dtype != DTYPE_FLOAT64) {
+        return nullptr;
+    }
+
+    if (!compiled.m_lowered) {
+        compiled.m_vectorized = t_vectorized_expression::lower(
+            m_parsed_expression_string, m_column_ids, input_dtypes);
+        compiled.m_lowered = true;
+    }
+
+    if (compiled.m_vectorized == nullptr || !compiled.m_vectorized->accepts(input_dtypes)) {
+        return nullptr;
+    }
+
+    return compiled.m_vectorized.get();
+}
+
+void
+t_computed_expression::compute(
+    std::shared_ptr<t_data_table> data_table) const {
+    t_compiled_expression& compiled =
+        get_compiled_expression("t_computed_expression::compute");
+
+    std::vector<t_tscalar>& values = compiled.m_values;
+    std::vector<std::shared_ptr<t_column>> columns;
+    std::vector<t_dtype> input_dtypes;
+
+    auto num_input_columns = m_column_ids.size();
+    columns.reserve(num_input_columns);
+    input_dtypes.reserve(num_input_columns);
+
+    for (t_uindex cidx = 0; cidx < num_input_columns; ++cidx) {
+        const std::string& column_name = m_column_ids[cidx].second;
+        columns.push_back(data_table->get_column(column_name));
+        input_dtypes.push_back(columns[cidx]->get_dtype());
+        values[cidx].clear();
+        values[cidx].m_type = input_dtypes[cidx];
+    }
+
     // create or get output column using m_expression_alias
     auto output_column = data_table->add_column_sptr(m_expression_alias, m_dtype, true);
 
@@ -189,20 +259,56 @@ t_computed_expression::compute(
     auto num_rows = data_table->size();
     output_column->reserve(num_rows);
 
-    for (t_uindex ridx = 0; ridx < num_rows; ++ridx) {
+    auto compute_row = [&](t_uindex ridx) {
         for (t_uindex cidx = 0; cidx < num_input_columns; ++cidx) {
-            const std::string& column_id = m_column_ids[cidx].first;
-            values[cidx].second.set(columns[column_id]->get_scalar(ridx));
+            values[cidx].set(columns[cidx]->get_scalar(ridx));
         }
     
-        t_tscalar value = expr_definition.value();
+        t_tscalar value = compiled.m_expression.value();
 
         if (!value.is_valid() || value.is_none()) {
             output_column->clear(ridx);
-            continue;
+            return;
         }
     
         output_column->set_scalar(ridx, value);
+    };
+
+    const t_vectorized_expression* vectorized =
+        get_vectorized_expression(compiled, input_dtypes);
+
+    if (vectorized == nullptr) {
+        for (t_uindex ridx = 0; ridx < num_rows; ++ridx) {
+            compute_row(ridx);
+        }
+
+        return;
+    }
+
+    t_vectorized_block block(vectorized->num_slots());
+    const double* result = block.m_values[vectorized->get_result_slot()].data();
+    const std::uint8_t* result_valid = block.m_valid[vectorized->get_result_slot()].data();
+
+    for (t_uindex offset = 0; offset < num_rows; offset += PSP_EXPRESSION_BLOCK_SIZE) {
+        t_uindex block_size = std::min(PSP_EXPRESSION_BLOCK_SIZE, num_rows - offset);
+
+        for (t_uindex cidx = 0; cidx < num_input_columns; ++cidx) {
+            vectorized->load(block, cidx, columns[cidx].get(), offset, block_size);
+        }
+
+        vectorized->evaluate(block, block_size);
+
+        for (t_uindex bidx = 0; bidx < block_size; ++bidx) {
+            t_uindex ridx = offset + bidx;
+
+            if (block.m_fallback[bidx]) {
+                compute_row(ridx);
+            } else if (result_valid[bidx]) {
+                output_column->set_nth<double>(ridx, result[bidx]);
+            } else {
+                output_column->clear(ridx);
+            }
+        }
     }
 };
 
@@ -211,13 +317,10 @@ t_computed_expression::recompute(
     std::shared_ptr<t_data_table> gstate_table,
     std::shared_ptr<t_data_table> flattened,
     const std::vector<t_rlookup>& changed_rows) const {
-    exprtk::symbol_table<t_tscalar> sym_table;
-    sym_table.add_constants();
-
-    REGISTER_COMPUTE_FUNCTIONS()
+    t_compiled_expression& compiled =
+        get_compiled_expression("t_computed_expression::recompute");
 
-    exprtk::expression<t_tscalar> expr_definition;
-    std::vector<std::pair<std::string, t_tscalar>> values;
+    std::vector<t_tscalar>& values = compiled.m_values;
 
     /**
      * To properly recompute columns when updates have been applied, we need 
@@ -229,38 +332,24 @@ t_computed_expression::recompute(
      * `null` or `undefined`, and we need to apply/not apply computations
      * based on both the value in `flattened` and the `gstate_table`.
      */
-    tsl::hopscotch_map<std::string, std::shared_ptr<t_column>> flattened_columns;
-    tsl::hopscotch_map<std::string, std::shared_ptr<t_column>> gstate_table_columns;
+    std::vector<std::shared_ptr<t_column>> flattened_columns;
+    std::vector<std::shared_ptr<t_column>> gstate_table_columns;
 
     auto num_input_columns = m_column_ids.size();
 
-    values.resize(num_input_columns);
     flattened_columns.reserve(num_input_columns);
     gstate_table_columns.reserve(num_input_columns);
 
+    std::vector<t_dtype> input_dtypes;
+    input_dtypes.reserve(num_input_columns);
+
     for (t_uindex cidx = 0; cidx < num_input_columns; ++cidx) {
-        const std::string& column_id = m_column_ids[cidx].first;
         const std::string& column_name = m_column_ids[cidx].second;
-        flattened_columns[column_id] = flattened->get_column(column_name);
-        gstate_table_columns[column_id] = gstate_table->get_column(column_name);
-
-        t_tscalar rval;
-        rval.m_type = flattened_columns[column_id]->get_dtype();
-        values[cidx] = std::pair<std::string, t_tscalar>(column_id, rval);
-        sym_table.add_variable(column_id, values[cidx].second);
-    }
-
-    expr_definition.register_symbol_table(sym_table);
-
-    if (!t_computed_expression_parser::PARSER->compile(m_parsed_expression_string, expr_definition)) {
-        std::stringstream ss;
-        ss << "[t_computed_expression::recompute] Failed to parse expression: `"
-            << m_parsed_expression_string
-            << "`, failed with error: "
-            << t_computed_expression_parser::PARSER->error()
-            << std::endl;
-
-        PSP_COMPLAIN_AND_ABORT(ss.str());
+        flattened_columns.push_back(flattened->get_column(column_name));
+        gstate_table_columns.push_back(gstate_table->get_column(column_name));
+        input_dtypes.push_back(flattened_columns[cidx]->get_dtype());
+        values[cidx].clear();
+        values[cidx].m_type = input_dtypes[cidx];
     }
 
     // get or create the output column
@@ -287,85 +376,149 @@ t_computed_expression::recompute(
         num_rows = gstate_table->size();
     } 
 
-    for (t_uindex idx = 0; idx < num_rows; ++idx) {
-        bool row_already_exists = false;
-
-        // if changed_rows is not empty, ridx will point to a row index in
-        // the gnode state master table, whereas idx will always point to
-        // the row index in the flattened table containing the data from
-        // this update/process cycle.
+    // if changed_rows is not empty, ridx will point to a row index in
+    // the gnode state master table, whereas idx will always point to
+    // the row index in the flattened table containing the data from
+    // this update/process cycle.
+    auto get_gstate_row = [&](t_uindex idx, bool& row_already_exists) {
+        row_already_exists = false;
         t_uindex ridx = idx;
 
         if (changed_rows.size() > 0) {
             ridx = changed_rows[idx].m_idx;
             row_already_exists = changed_rows[idx].m_exists;
         }
-    
-        bool skip_row = false;
 
-        for (t_uindex cidx = 0; cidx < num_input_columns; ++cidx) {
-            const std::string& column_id = m_column_ids[cidx].first;
+        return ridx;
+    };
 
-            t_tscalar arg = flattened_columns[column_id]->get_scalar(idx);
+    /**
+     * TODO: should these semantics change now that we don't
+     * check or maintain intermediates?
+     * 
+     * If the row already exists on the gstate table and the cell
+     * in `flattened` is `STATUS_CLEAR`, do not compute the row and
+     * unset its value in the output column.
+     * 
+     * If the row does not exist, and the cell in `flattened` is
+     * `STATUS_INVALID`, do not compute the row and unset its value
+     * in the output column.
+     * 
+     * `idx` is used here instead of `ridx`, as `ridx` refers
+     * to the row index in changed_rows, i.e. the changed row
+     * on the gstate table, whereas idx is the row index
+     * in the flattened table.
+     */
+    auto should_unset = [&](t_uindex cidx, t_uindex idx, bool row_already_exists) {
+        return (row_already_exists && flattened_columns[cidx]->is_cleared(idx)) ||
+            (!row_already_exists && !flattened_columns[cidx]->is_valid(idx));
+    };
 
-            if (!arg.is_valid()) {
-                /**
-                 * TODO: should these semantics change now that we don't
-                 * check or maintain intermediates?
-                 * 
-                 * If the row already exists on the gstate table and the cell
-                 * in `flattened` is `STATUS_CLEAR`, do not compute the row and
-                 * unset its value in the output column.
-                 * 
-                 * If the row does not exist, and the cell in `flattened` is
-                 * `STATUS_INVALID`, do not compute the row and unset its value
-                 * in the output column.
-                 * 
-                 * `idx` is used here instead of `ridx`, as `ridx` refers
-                 * to the row index in changed_rows, i.e. the changed row
-                 * on the gstate table, whereas idx is the row index
-                 * in the flattened table.
-                 */
-                bool should_unset = 
-                    (row_already_exists && flattened_columns[column_id]->is_cleared(idx)) ||
-                    (!row_already_exists && !flattened_columns[column_id]->is_valid(idx));
+    auto recompute_row = [&](t_uindex idx) {
+        bool row_already_exists;
+        t_uindex ridx = get_gstate_row(idx, row_already_exists);
 
+        for (t_uindex cidx = 0; cidx < num_input_columns; ++cidx) {
+            t_tscalar arg = flattened_columns[cidx]->get_scalar(idx);
+
+            if (!arg.is_valid()) {
                 /**
                  * Use `unset` instead of `clear`, as
                  * `t_gstate::update_master_table` will reconcile `STATUS_CLEAR`
                  * into `STATUS_INVALID`.
                  */
-                if (should_unset) {
+                if (should_unset(cidx, idx, row_already_exists)) {
                     output_column->unset(idx);
-                    skip_row = true;
-                    break;  
+                    return;
                 } else {
                     // Get the value from the master table using `ridx`,
                     // which points to a row in the master table that is
                     // being overwritten in this partial update.
-                    arg = gstate_table_columns[column_id]->get_scalar(ridx);
+                    arg = gstate_table_columns[cidx]->get_scalar(ridx);
                 }
             }
 
-            values[cidx].second.set(arg);
+            values[cidx].set(arg);
         }
 
-        if (skip_row) continue;
-
-        t_tscalar value = expr_definition.value();
+        t_tscalar value = compiled.m_expression.value();
 
         if (!value.is_valid() || value.is_none()) {
             output_column->clear(idx);
-            continue;
+            return;
         }
         
         output_column->set_scalar(idx, value);
+    };
+
+    const t_vectorized_expression* vectorized =
+        get_vectorized_expression(compiled, input_dtypes);
+
+    if (vectorized == nullptr) {
+        for (t_uindex idx = 0; idx < num_rows; ++idx) {
+            recompute_row(idx);
+        }
+
+        return;
+    }
+
+    t_vectorized_block block(vectorized->num_slots());
+    const double* result = block.m_values[vectorized->get_result_slot()].data();
+    const std::uint8_t* result_valid = block.m_valid[vectorized->get_result_slot()].data();
+    std::vector<std::uint8_t> skip_row(PSP_EXPRESSION_BLOCK_SIZE);
+
+    for (t_uindex offset = 0; offset < num_rows; offset += PSP_EXPRESSION_BLOCK_SIZE) {
+        t_uindex block_size = std::min(PSP_EXPRESSION_BLOCK_SIZE, num_rows - offset);
+
+        for (t_uindex cidx = 0; cidx < num_input_columns; ++cidx) {
+            vectorized->load(block, cidx, flattened_columns[cidx].get(), offset, block_size);
+        }
+
+        // Apply the same rules as `recompute_row` to the null cells of the
+        // block, reading the partially updated cells from the master table.
+        for (t_uindex bidx = 0; bidx < block_size; ++bidx) {
+            t_uindex idx = offset + bidx;
+            bool row_already_exists;
+            t_uindex ridx = get_gstate_row(idx, row_already_exists);
+            skip_row[bidx] = false;
+
+            for (t_uindex cidx = 0; cidx < num_input_columns; ++cidx) {
+                if (block.m_valid[cidx][bidx]) {
+                    continue;
+                }
+
+                if (should_unset(cidx, idx, row_already_exists)) {
+                    output_column->unset(idx);
+                    skip_row[bidx] = true;
+                    break;
+                }
+
+                vectorized->load_row(block, cidx, gstate_table_columns[cidx].get(), ridx, bidx);
+            }
+        }
+
+        vectorized->evaluate(block, block_size);
+
+        for (t_uindex bidx = 0; bidx < block_size; ++bidx) {
+            t_uindex idx = offset + bidx;
+
+            if (skip_row[bidx]) {
+                continue;
+            } else if (block.m_fallback[bidx]) {
+                recompute_row(idx);
+            } else if (result_valid[bidx]) {
+                output_column->set_nth<double>(idx, result[bidx]);
+            } else {
+                output_column->clear(idx);
+            }
+        }
     }
 }
 
 void
 t_computed_expression::set_expression_vocab(std::shared_ptr<t_vocab> expression_vocab) {
     m_expression_vocab = expression_vocab;
+    m_compiled_expression = nullptr;
 }
 
 const std::string&
@@ -441,6 +594,8 @@ t_computed_expression_parser::precompute(
     exprtk::expression<t_tscalar> expr_definition;
     expr_definition.register_symbol_table(sym_table);
 
+    std::lock_guard<std::mutex> lock(t_computed_expression_parser::PARSER_MUTEX);
+
     if (!t_computed_expression_parser::PARSER->compile(parsed_expression_string, expr_definition)) {
         std::stringstream ss;
         ss << "[t_computed_expression_parser::precompute] Failed to parse expression: `"
@@ -502,6 +657,8 @@ t_computed_expression_parser::get_dtype(
     exprtk::expression<t_tscalar> expr_definition;
     expr_definition.register_symbol_table(sym_table);
 
+    std::lock_guard<std::mutex> lock(t_computed_expression_parser::PARSER_MUTEX);
+
     if (!t_computed_expression_parser::PARSER->compile(parsed_expression_string, expr_definition)) {
         auto error = t_computed_expression_parser::PARSER->error();
         // strip the Exprtk error codes such as "ERR001 -"
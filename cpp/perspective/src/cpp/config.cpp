@@ -184,17 +184,14 @@ t_config::setup(const std::vector<std::string>& detail_columns,
             case AGGTYPE_LAST_BY_INDEX:
             case AGGTYPE_MEAN:
             case AGGTYPE_WEIGHTED_MEAN:
-            case AGGTYPE_UNIQUE:
-            case AGGTYPE_MEDIAN:
-            case AGGTYPE_JOIN:
             case AGGTYPE_DOMINANT:
             case AGGTYPE_PY_AGG:
             case AGGTYPE_SUM_NOT_NULL:
             case AGGTYPE_SUM_ABS:
             case AGGTYPE_ABS_SUM:
             case AGGTYPE_MUL:
-            case AGGTYPE_DISTINCT_COUNT:
-            case AGGTYPE_DISTINCT_LEAF:
+            case AGGTYPE_APPROX_DISTINCT_COUNT:
+            case AGGTYPE_APPROX_PERCENTILE:
                 m_has_pkey_agg = true;
                 break;
             default:
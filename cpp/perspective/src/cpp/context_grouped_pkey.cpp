@@ -456,6 +456,15 @@ t_ctx_grouped_pkey::has_deltas() const {
     return true;
 }
 
+t_memory_report
+t_ctx_grouped_pkey::get_memory_usage() const {
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    t_memory_report rval;
+    append_memory_usage(rval, "tree", m_tree->get_memory_usage());
+    rval.push_back(m_traversal->get_memory_usage("traversal"));
+    return rval;
+}
+
 template <typename DATA_T>
 void
 rebuild_helper(t_column*) {}
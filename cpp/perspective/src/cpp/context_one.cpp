@@ -542,6 +542,15 @@ t_ctx1::has_deltas() const {
     return m_tree->has_deltas();
 }
 
+t_memory_report
+t_ctx1::get_memory_usage() const {
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    t_memory_report rval;
+    append_memory_usage(rval, "tree", m_tree->get_memory_usage());
+    rval.push_back(m_traversal->get_memory_usage("traversal"));
+    return rval;
+}
+
 void
 t_ctx1::notify(const t_data_table& flattened) {
     PSP_TRACE_SENTINEL();
@@ -550,6 +559,14 @@ t_ctx1::notify(const t_data_table& flattened) {
         m_config.get_sortby_pairs(), m_sortby, flattened, m_config, *m_gstate);
 }
 
+void
+t_ctx1::notify(const t_ring_step& step) {
+    PSP_TRACE_SENTINEL();
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    notify_sparse_tree(m_tree, m_traversal, true, m_config.get_aggregates(),
+        m_config.get_sortby_pairs(), m_sortby, step, m_config, *m_gstate);
+}
+
 void
 t_ctx1::pprint() const {
     std::cout << "\t" << std::endl;
@@ -943,6 +943,19 @@ t_ctx2::has_deltas() const {
     return has_deltas;
 }
 
+t_memory_report
+t_ctx2::get_memory_usage() const {
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    t_memory_report rval;
+    for (t_uindex idx = 0, loop_end = m_trees.size(); idx < loop_end; ++idx) {
+        append_memory_usage(
+            rval, "trees." + std::to_string(idx), m_trees[idx]->get_memory_usage());
+    }
+    rval.push_back(m_rtraversal->get_memory_usage("row_traversal"));
+    rval.push_back(m_ctraversal->get_memory_usage("column_traversal"));
+    return rval;
+}
+
 void
 t_ctx2::notify(const t_data_table& flattened) {
     for (t_uindex tree_idx = 0, loop_end = m_trees.size(); tree_idx < loop_end; ++tree_idx) {
@@ -963,6 +976,27 @@ t_ctx2::notify(const t_data_table& flattened) {
     }
 }
 
+void
+t_ctx2::notify(const t_ring_step& step) {
+    for (t_uindex tree_idx = 0, loop_end = m_trees.size(); tree_idx < loop_end; ++tree_idx) {
+        if (is_rtree_idx(tree_idx)) {
+            notify_sparse_tree(rtree(), m_rtraversal, true, m_config.get_aggregates(),
+                m_config.get_sortby_pairs(), m_sortby, step, m_config, *m_gstate);
+        } else if (is_ctree_idx(tree_idx)) {
+            notify_sparse_tree(ctree(), m_ctraversal, true, m_config.get_aggregates(),
+                m_config.get_sortby_pairs(), m_column_sortby, step, m_config, *m_gstate);
+        } else {
+            notify_sparse_tree(m_trees[tree_idx], std::shared_ptr<t_traversal>(0), false,
+                m_config.get_aggregates(), m_config.get_sortby_pairs(),
+                std::vector<t_sortspec>(), step, m_config, *m_gstate);
+        }
+    }
+
+    if (!m_sortby.empty()) {
+        sort_by(m_sortby);
+    }
+}
+
 void
 t_ctx2::pprint() const {}
 
@@ -119,6 +119,20 @@ t_ctxunit::notify(const t_data_table& flattened) {
     }
 }
 
+void
+t_ctxunit::notify(const t_ring_step& step) {
+    const t_data_table& appended = *(step.m_appended);
+    std::shared_ptr<const t_column> pkey_sptr = appended.get_const_column("psp_pkey");
+    const t_column* pkey_col = pkey_sptr.get();
+
+    m_has_delta = true;
+
+    // Each evicted row shares its pkey with the row that replaced it.
+    for (t_uindex idx = 0, loop_end = appended.size(); idx < loop_end; ++idx) {
+        add_delta_pkey(pkey_col->get_scalar(idx));
+    }
+}
+
 std::pair<t_tscalar, t_tscalar> 
 t_ctxunit::get_min_max(const std::string& colname) const {
     auto col = m_gstate->get_table()->get_const_column(colname);
@@ -425,6 +439,14 @@ t_ctxunit::has_deltas() const {
     return m_has_delta;
 }
 
+t_memory_report
+t_ctxunit::get_memory_usage() const {
+    // A unit context reads its rows from the `t_gstate` in place.
+    t_memory_report rval;
+    rval.push_back(get_hash_memory_usage("delta_pkeys", m_delta_pkeys));
+    return rval;
+}
+
 t_dtype
 t_ctxunit::get_column_dtype(t_uindex idx) const {
     if (idx >= static_cast<t_uindex>(get_column_count()))
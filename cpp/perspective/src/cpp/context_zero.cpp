@@ -168,6 +168,61 @@ t_ctx0::notify(const t_data_table& flattened, const t_data_table& delta,
     
 }
 
+/**
+ * @brief Given the rows one update wrote to a ring buffer, update the
+ * traversal from whether the evicted and appended row in each slot pass
+ * the filters - as with `existed` and `prev` in the general case, but
+ * without the transitional tables.
+ *
+ * @param step
+ */
+void
+t_ctx0::notify(const t_ring_step& step) {
+    const t_data_table& appended = *(step.m_appended);
+    t_uindex nrecs = appended.size();
+    std::shared_ptr<const t_column> pkey_sptr = appended.get_const_column("psp_pkey");
+    const t_column* pkey_col = pkey_sptr.get();
+
+    m_has_delta = true;
+
+    if (m_config.has_filters()) {
+        t_mask msk_prev = filter_table_for_config(*(step.m_evicted), m_config);
+        t_mask msk_curr = filter_table_for_config(appended, m_config);
+
+        for (t_uindex idx = 0; idx < nrecs; ++idx) {
+            t_tscalar pkey = m_symtable.get_interned_tscalar(pkey_col->get_scalar(idx));
+            bool filter_curr = msk_curr.get(idx);
+            bool filter_prev = step.is_evicted(idx) && msk_prev.get(idx);
+
+            if (filter_prev) {
+                if (filter_curr) {
+                    m_traversal->update_row(m_gstate, m_config, pkey);
+                } else {
+                    m_traversal->delete_row(pkey);
+                }
+            } else if (filter_curr) {
+                m_traversal->add_row(m_gstate, m_config, pkey);
+            }
+
+            add_delta_pkey(pkey);
+        }
+
+        return;
+    }
+
+    for (t_uindex idx = 0; idx < nrecs; ++idx) {
+        t_tscalar pkey = m_symtable.get_interned_tscalar(pkey_col->get_scalar(idx));
+
+        if (step.is_evicted(idx)) {
+            m_traversal->update_row(m_gstate, m_config, pkey);
+        } else {
+            m_traversal->add_row(m_gstate, m_config, pkey);
+        }
+
+        add_delta_pkey(pkey);
+    }
+}
+
 /**
  * @brief Given new data from the gnode after its first update (going from 
  * 0 rows to n > 0 rows), add each row to the traversal.
@@ -658,6 +713,15 @@ t_ctx0::has_deltas() const {
     return m_has_delta;
 }
 
+t_memory_report
+t_ctx0::get_memory_usage() const {
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    t_memory_report rval;
+    append_memory_usage(rval, "traversal", m_traversal->get_memory_usage());
+    rval.push_back(get_hash_memory_usage("delta_pkeys", m_delta_pkeys));
+    return rval;
+}
+
 t_dtype
 t_ctx0::get_column_dtype(t_uindex idx) const {
     if (idx >= static_cast<t_uindex>(get_column_count()))
@@ -34,12 +34,35 @@ t_data_table::set_capacity(t_uindex idx) {
 #endif
 }
 
+void
+t_data_table::set_lstore_pool(std::shared_ptr<t_lstore_pool> pool) {
+    m_lstore_pool = pool;
+}
+
+t_memory_report
+t_data_table::get_memory_usage() const {
+    t_memory_report rval;
+    for (t_uindex idx = 0, loop_end = m_schema.size(); idx < loop_end; ++idx) {
+        append_memory_usage(rval, m_schema.m_columns[idx], m_columns[idx]->get_memory_usage());
+    }
+    return rval;
+}
+
+void
+t_data_table::set_access_hint(t_access_hint hint) {
+    m_access_hint = hint;
+    for (auto& column : m_columns) {
+        column->set_access_hint(hint);
+    }
+}
+
 t_data_table::t_data_table(const t_schema& s, t_uindex init_cap)
     : m_name("")
     , m_dirname("")
     , m_schema(s)
     , m_size(0)
     , m_backing_store(BACKING_STORE_MEMORY)
+    , m_access_hint(ACCESS_HINT_NORMAL)
     , m_init(false) {
     PSP_TRACE_SENTINEL();
     LOG_CONSTRUCTOR("t_data_table");
@@ -53,6 +76,7 @@ t_data_table::t_data_table(const std::string& name, const std::string& dirname,
     , m_schema(s)
     , m_size(0)
     , m_backing_store(backing_store)
+    , m_access_hint(ACCESS_HINT_NORMAL)
     , m_init(false) {
     PSP_TRACE_SENTINEL();
     LOG_CONSTRUCTOR("t_data_table");
@@ -66,6 +90,7 @@ t_data_table::t_data_table(const t_schema& s, const std::vector<std::vector<t_ts
     , m_schema(s)
     , m_size(0)
     , m_backing_store(BACKING_STORE_MEMORY)
+    , m_access_hint(ACCESS_HINT_NORMAL)
     , m_init(false) {
     PSP_TRACE_SENTINEL();
     LOG_CONSTRUCTOR("t_data_table");
@@ -103,6 +128,7 @@ t_data_table::init() {
     PSP_TRACE_SENTINEL();
     LOG_INIT("t_data_table");
     m_columns = std::vector<std::shared_ptr<t_column>>(m_schema.size());
+    m_shared = std::vector<std::uint8_t>(m_schema.size(), 0);
 
 #ifdef PSP_PARALLEL_FOR
     tbb::parallel_for(0, int(m_schema.size()), 1,
@@ -127,6 +153,8 @@ std::shared_ptr<t_column>
 t_data_table::make_column(const std::string& colname, t_dtype dtype, bool status_enabled) {
     t_lstore_recipe a(m_dirname, m_name + std::string("_") + colname,
         m_capacity * get_dtype_size(dtype), m_backing_store);
+    a.m_pool = m_lstore_pool;
+    a.m_access_hint = m_access_hint;
     return std::make_shared<t_column>(dtype, status_enabled, a, m_capacity);
 }
 
@@ -289,6 +317,20 @@ t_data_table::reserve(t_uindex capacity) {
     set_capacity(std::max(capacity, m_capacity));
 }
 
+void
+t_data_table::shrink(t_uindex capacity) {
+    PSP_TRACE_SENTINEL();
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    capacity = std::max(capacity, m_size);
+    if (capacity >= m_capacity)
+        return;
+
+    for (t_uindex idx = 0, loop_end = m_schema.size(); idx < loop_end; ++idx) {
+        m_columns[idx]->shrink(capacity);
+    }
+    set_capacity(capacity);
+}
+
 t_column*
 t_data_table::_get_column(const std::string& colname) {
     PSP_TRACE_SENTINEL();
@@ -309,13 +351,67 @@ t_data_table::flatten() const {
     PSP_TRACE_SENTINEL();
     PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
     PSP_VERBOSE_ASSERT(is_pkey_table(), "Not a pkeyed table");
+
+    // Flattening would copy every row to the same position.
+    if (is_flat()) {
+        return share();
+    }
+
     std::shared_ptr<t_data_table> flattened = std::make_shared<t_data_table>(
         "", "", m_schema, DEFAULT_EMPTY_CAPACITY, BACKING_STORE_MEMORY);
+    flattened->set_lstore_pool(m_lstore_pool);
     flattened->init();
     flatten_body<std::shared_ptr<t_data_table>>(flattened);
     return flattened;
 }
 
+bool
+t_data_table::is_flat() const {
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    if (!is_pkey_table() || size() == 0)
+        return false;
+
+    switch (get_const_column("psp_pkey")->get_dtype()) {
+        case DTYPE_INT64:
+        case DTYPE_TIME: {
+            return is_flat_helper<std::int64_t>();
+        }
+        case DTYPE_INT32: {
+            return is_flat_helper<std::int32_t>();
+        }
+        case DTYPE_INT16: {
+            return is_flat_helper<std::int16_t>();
+        }
+        case DTYPE_INT8: {
+            return is_flat_helper<std::int8_t>();
+        }
+        case DTYPE_UINT64: {
+            return is_flat_helper<std::uint64_t>();
+        }
+        case DTYPE_UINT32:
+        case DTYPE_DATE: {
+            return is_flat_helper<std::uint32_t>();
+        }
+        case DTYPE_UINT16: {
+            return is_flat_helper<std::uint16_t>();
+        }
+        case DTYPE_UINT8: {
+            return is_flat_helper<std::uint8_t>();
+        }
+        case DTYPE_STR: {
+            // `flatten` orders string primary keys by their vocabulary index
+            return is_flat_helper<t_uindex>();
+        }
+        case DTYPE_FLOAT64: {
+            return is_flat_helper<double>();
+        }
+        case DTYPE_FLOAT32: {
+            return is_flat_helper<float>();
+        }
+        default: { return false; }
+    }
+}
+
 bool
 t_data_table::is_pkey_table() const {
     PSP_TRACE_SENTINEL();
@@ -408,6 +504,10 @@ t_data_table::append(const t_data_table& other) {
 
     t_uindex cursize = size();
 
+    for (t_uindex idx = 0, loop_end = m_columns.size(); idx < loop_end; ++idx) {
+        detach_column(idx, true);
+    }
+
     std::vector<const t_column*> src_cols;
     std::vector<t_column*> dst_cols;
 
@@ -462,6 +562,7 @@ t_data_table::clear() {
     PSP_TRACE_SENTINEL();
     PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
     for (t_uindex idx = 0, loop_end = m_columns.size(); idx < loop_end; ++idx) {
+        detach_column(idx, false);
         m_columns[idx]->clear();
     }
     m_size = 0;
@@ -472,71 +573,56 @@ t_data_table::filter_cpp(t_filter_op combiner, const std::vector<t_fterm>& fterm
     auto self = const_cast<t_data_table*>(this);
     auto fterms = fterms_;
 
-    t_mask mask(size());
     t_uindex fterm_size = fterms.size();
-    std::vector<t_uindex> indices(fterm_size);
-    std::vector<const t_column*> columns(fterm_size);
+    std::vector<t_fterm_kernel> kernels;
+    kernels.reserve(fterm_size);
 
     for (t_uindex idx = 0; idx < fterm_size; ++idx) {
-        indices[idx] = m_schema.get_colidx(fterms[idx].m_colname);
-        columns[idx] = get_const_column(fterms[idx].m_colname).get();
-        fterms[idx].coerce_numeric(columns[idx]->get_dtype());
-        if (fterms[idx].m_use_interned) {
-            t_tscalar& thr = fterms[idx].m_threshold;
-            auto col = self->get_column(fterms[idx].m_colname);
-            auto interned = col->get_interned(thr.get_char_ptr());
-            thr.set(interned);
-        }
+        auto col = self->get_column(fterms[idx].m_colname);
+        fterms[idx].coerce_numeric(col->get_dtype());
+        kernels.emplace_back(fterms[idx], col.get());
     }
 
-    switch (combiner) {
-        case FILTER_OP_AND: {
-            t_tscalar cell_val;
-
-            for (t_uindex ridx = 0, rloop_end = size(); ridx < rloop_end; ++ridx) {
-                bool pass = true;
-
-                for (t_uindex cidx = 0; cidx < fterm_size; ++cidx) {
-                    if (!pass)
-                        break;
+    if (combiner != FILTER_OP_AND && combiner != FILTER_OP_OR) {
+        PSP_COMPLAIN_AND_ABORT("Unknown filter op");
+    }
 
-                    const auto& ft = fterms[cidx];
-                    bool tval;
+    // Evaluate each term a block of rows at a time, and combine the blocks
+    // of every term bitwise into the blocks of the mask.
+    const t_uindex bits_per_block = t_mask::BITS_PER_BLOCK;
+    t_uindex num_rows = size();
+    t_uindex num_blocks = (num_rows + bits_per_block - 1) / bits_per_block;
+    std::vector<t_mask::t_block> blocks(num_blocks);
 
-                    if (ft.m_use_interned) {
-                        cell_val.set(*(columns[cidx]->get_nth<t_uindex>(ridx)));
-                        tval = ft(cell_val);
-                    } else {
-                        cell_val = columns[cidx]->get_scalar(ridx);
-                        tval = ft(cell_val);
-                    }
+    for (t_uindex bidx = 0; bidx < num_blocks; ++bidx) {
+        t_uindex offset = bidx * bits_per_block;
+        t_uindex block_rows = std::min(bits_per_block, num_rows - offset);
+        t_mask::t_block all_rows = block_rows == bits_per_block
+            ? ~t_mask::t_block(0)
+            : (t_mask::t_block(1) << block_rows) - 1;
 
-                    if ((ft.m_op != FILTER_OP_IS_NULL && !cell_val.is_valid()) || !tval) {
-                        pass = false;
-                        break;
-                    }
-                }
+        t_mask::t_block block;
 
-                mask.set(ridx, pass);
+        if (combiner == FILTER_OP_AND) {
+            block = all_rows;
+            for (const auto& kernel : kernels) {
+                if (block == 0)
+                    break;
+                block &= kernel.evaluate(offset, block_rows);
             }
-        } break;
-        case FILTER_OP_OR: {
-            for (t_uindex ridx = 0, rloop_end = size(); ridx < rloop_end; ++ridx) {
-                bool pass = false;
-                for (t_uindex cidx = 0; cidx < fterm_size; ++cidx) {
-                    t_tscalar cell_val = columns[cidx]->get_scalar(ridx);
-                    if (fterms[cidx](cell_val)) {
-                        pass = true;
-                        break;
-                    }
-                }
-                mask.set(ridx, pass);
+        } else {
+            block = 0;
+            for (const auto& kernel : kernels) {
+                if (block == all_rows)
+                    break;
+                block |= kernel.evaluate(offset, block_rows);
             }
-        } break;
-        default: { PSP_COMPLAIN_AND_ABORT("Unknown filter op"); } break;
+        }
+
+        blocks[bidx] = block;
     }
 
-    return mask;
+    return t_mask(blocks, num_rows);
 }
 
 t_uindex
@@ -607,6 +693,109 @@ t_data_table::borrow(const std::vector<std::string>& columns) const {
     return rval;
 }
 
+std::shared_ptr<t_data_table>
+t_data_table::share() const {
+    PSP_TRACE_SENTINEL();
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    auto rval = std::make_shared<t_data_table>(
+        "", "", m_schema, m_capacity, BACKING_STORE_MEMORY);
+    rval->set_lstore_pool(m_lstore_pool);
+    rval->m_columns = m_columns;
+    rval->m_shared = std::vector<std::uint8_t>(m_columns.size(), 1);
+    rval->m_size = m_size;
+    rval->m_init = true;
+    std::fill(m_shared.begin(), m_shared.end(), 1);
+    return rval;
+}
+
+bool
+t_data_table::share_columns(const t_data_table& other) {
+    PSP_TRACE_SENTINEL();
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+
+    if (size() != 0 || other.num_columns() != num_columns())
+        return false;
+
+    for (t_uindex idx = 0, loop_end = m_schema.size(); idx < loop_end; ++idx) {
+        const std::string& cname = m_schema.m_columns[idx];
+        if (!other.m_schema.has_column(cname))
+            return false;
+
+        const t_column* column = other.m_columns[other.m_schema.get_colidx(cname)].get();
+        if (column->get_dtype() != m_schema.m_types[idx]
+            || column->is_status_enabled() != m_columns[idx]->is_status_enabled()) {
+            return false;
+        }
+    }
+
+    for (t_uindex idx = 0, loop_end = m_schema.size(); idx < loop_end; ++idx) {
+        m_columns[idx] = other.share_column(m_schema.m_columns[idx]);
+        m_shared[idx] = 1;
+    }
+
+    set_capacity(other.get_capacity());
+    m_size = other.num_rows();
+    return true;
+}
+
+std::shared_ptr<t_column>
+t_data_table::share_column(const std::string& colname) const {
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    t_uindex idx = m_schema.get_colidx(colname);
+    m_shared[idx] = 1;
+    return m_columns[idx];
+}
+
+void
+t_data_table::retain(const t_mask& mask) {
+    PSP_TRACE_SENTINEL();
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    PSP_VERBOSE_ASSERT(mask.size() == size(), "Mask does not match the table size");
+
+#ifdef PSP_PARALLEL_FOR
+    tbb::parallel_for(0, int(m_columns.size()), 1,
+        [&mask, this](int idx)
+#else
+    for (t_uindex idx = 0, loop_end = m_columns.size(); idx < loop_end; ++idx)
+#endif
+        {
+            if (is_column_shared(idx)) {
+                m_columns[idx] = m_columns[idx]->clone(mask);
+                m_columns[idx]->set_size(mask.count());
+                m_shared[idx] = 0;
+            } else {
+                m_columns[idx]->retain(mask);
+            }
+        }
+#ifdef PSP_PARALLEL_FOR
+    );
+#endif
+
+    m_size = mask.count();
+}
+
+bool
+t_data_table::is_column_shared(t_uindex idx) const {
+    // Once the other tables release a shared column, this table owns it.
+    return m_shared[idx] && m_columns[idx].use_count() > 1;
+}
+
+void
+t_data_table::detach_column(t_uindex idx, bool copy) {
+    bool shared = is_column_shared(idx);
+    m_shared[idx] = 0;
+    if (!shared)
+        return;
+
+    if (copy) {
+        m_columns[idx] = m_columns[idx]->clone();
+    } else {
+        m_columns[idx] = make_column(m_schema.m_columns[idx], m_schema.m_types[idx],
+            m_columns[idx]->is_status_enabled());
+        m_columns[idx]->init();
+    }
+}
+
 std::shared_ptr<t_column>
 t_data_table::add_column_sptr(const std::string& name, t_dtype dtype, bool status_enabled) {
     PSP_TRACE_SENTINEL();
@@ -617,6 +806,7 @@ t_data_table::add_column_sptr(const std::string& name, t_dtype dtype, bool statu
     }
     m_schema.add_column(name, dtype);
     m_columns.push_back(make_column(name, dtype, status_enabled));
+    m_shared.push_back(0);
     m_columns.back()->init();
     m_columns.back()->reserve(std::max(size(), std::max(static_cast<t_uindex>(8), m_capacity)));
     m_columns.back()->set_size(size());
@@ -637,6 +827,7 @@ t_data_table::drop_column(const std::string& name) {
         auto idx = m_schema.get_colidx(name);
         auto col = m_columns[idx];
         // FIXME: make sure that we can erase columns from m_schema eventually.
+        detach_column(idx, false);
         m_columns[idx]->clear();
     }
 }
@@ -700,6 +891,7 @@ t_data_table::promote_column(
 void
 t_data_table::set_column(t_uindex idx, std::shared_ptr<t_column> col) {
     m_columns[idx] = col;
+    m_shared[idx] = 0;
 }
 
 void
@@ -722,6 +914,7 @@ t_data_table::clone_column(const std::string& existing_col, const std::string& n
 
     m_schema.add_column(new_colname, m_columns[idx]->get_dtype());
     m_columns.push_back(m_columns[idx]->clone());
+    m_shared.push_back(0);
     m_columns.back()->reserve(std::max(size(), std::max(static_cast<t_uindex>(8), m_capacity)));
     m_columns.back()->set_size(size());
     return m_columns.back().get();
@@ -749,6 +942,9 @@ t_data_table::verify() const {
 void
 t_data_table::reset() {
     for (t_uindex idx = 0, loop_end = m_columns.size(); idx < loop_end; ++idx) {
+        // `init` replaces the columns, so shared columns are left as they are
+        if (is_column_shared(idx))
+            continue;
         if (m_columns[idx]->get_dtype() == DTYPE_OBJECT){
             m_columns[idx]->clear_objects();
         }
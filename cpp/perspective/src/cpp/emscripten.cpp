@@ -1779,7 +1779,8 @@ EMSCRIPTEN_BINDINGS(perspective) {
         .function("remove_port", &Table::remove_port)
         .function("get_id", &Table::get_id)
         .function("get_pool", &Table::get_pool)
-        .function("get_gnode", &Table::get_gnode);
+        .function("get_gnode", &Table::get_gnode)
+        .function("get_memory_usage", &Table::get_memory_usage);
     /******************************************************************************
      *
      * View
@@ -1810,6 +1811,7 @@ EMSCRIPTEN_BINDINGS(perspective) {
         .function("get_filter", &View<t_ctxunit>::get_filter)
         .function("get_sort", &View<t_ctxunit>::get_sort)
         .function("get_step_delta", &View<t_ctxunit>::get_step_delta)
+        .function("get_memory_usage", &View<t_ctxunit>::get_memory_usage)
         .function("get_column_dtype", &View<t_ctxunit>::get_column_dtype)
         .function("is_column_only", &View<t_ctxunit>::is_column_only);
 
@@ -1838,6 +1840,7 @@ EMSCRIPTEN_BINDINGS(perspective) {
         .function("get_filter", &View<t_ctx0>::get_filter)
         .function("get_sort", &View<t_ctx0>::get_sort)
         .function("get_step_delta", &View<t_ctx0>::get_step_delta)
+        .function("get_memory_usage", &View<t_ctx0>::get_memory_usage)
         .function("get_column_dtype", &View<t_ctx0>::get_column_dtype)
         .function("is_column_only", &View<t_ctx0>::is_column_only);
 
@@ -1869,6 +1872,7 @@ EMSCRIPTEN_BINDINGS(perspective) {
         .function("get_filter", &View<t_ctx1>::get_filter)
         .function("get_sort", &View<t_ctx1>::get_sort)
         .function("get_step_delta", &View<t_ctx1>::get_step_delta)
+        .function("get_memory_usage", &View<t_ctx1>::get_memory_usage)
         .function("get_column_dtype", &View<t_ctx1>::get_column_dtype)
         .function("is_column_only", &View<t_ctx1>::is_column_only);
 
@@ -1901,6 +1905,7 @@ EMSCRIPTEN_BINDINGS(perspective) {
         .function("get_sort", &View<t_ctx2>::get_sort)
         .function("get_row_path", &View<t_ctx2>::get_row_path)
         .function("get_step_delta", &View<t_ctx2>::get_step_delta)
+        .function("get_memory_usage", &View<t_ctx2>::get_memory_usage)
         .function("get_column_dtype", &View<t_ctx2>::get_column_dtype)
         .function("is_column_only", &View<t_ctx2>::is_column_only);
 
@@ -2025,7 +2030,13 @@ EMSCRIPTEN_BINDINGS(perspective) {
         .smart_ptr<std::shared_ptr<t_pool>>("shared_ptr<t_pool>")
         .function("unregister_gnode", &t_pool::unregister_gnode)
         .function("_process", &t_pool::_process)
-        .function("set_update_delegate", &t_pool::set_update_delegate);
+        .function("set_update_delegate", &t_pool::set_update_delegate)
+        .function("set_batching", &t_pool::set_batching)
+        .function("is_batching", &t_pool::is_batching)
+        .function("is_batch_ready", &t_pool::is_batch_ready)
+        .function("get_batch_wait_ms", &t_pool::get_batch_wait_ms)
+        .function("get_num_batches", &t_pool::get_num_batches)
+        .function("get_num_rows_coalesced", &t_pool::get_num_rows_coalesced);
 
     /******************************************************************************
      *
@@ -2069,6 +2080,15 @@ EMSCRIPTEN_BINDINGS(perspective) {
         .field("columns_changed", &t_stepdelta::columns_changed)
         .field("cells", &t_stepdelta::cells);
 
+    /******************************************************************************
+     *
+     * t_memory_usage
+     */
+    value_object<t_memory_usage>("t_memory_usage")
+        .field("name", &t_memory_usage::m_name)
+        .field("reserved", &t_memory_usage::m_reserved)
+        .field("used", &t_memory_usage::m_used);
+
 
     /******************************************************************************
      *
@@ -2082,6 +2102,7 @@ EMSCRIPTEN_BINDINGS(perspective) {
     register_vector<t_updctx>("std::vector<t_updctx>");
     register_vector<t_uindex>("std::vector<t_uindex>");
     register_vector<t_val>("std::vector<t_val>");
+    register_vector<t_memory_usage>("std::vector<t_memory_usage>");
     register_vector<std::vector<t_tscalar>>("std::vector<std::vector<t_tscalar>>");
     register_vector<std::vector<std::string>>("std::vector<std::vector<std::string>>");
     register_vector<std::vector<t_val>>("std::vector<std::vector<t_val>>");
@@ -53,6 +53,7 @@ extract_aggregate(
         case AGGTYPE_ANY:
         case AGGTYPE_DOMINANT:
         case AGGTYPE_MEDIAN:
+        case AGGTYPE_PERCENTILE:
         case AGGTYPE_FIRST:
         case AGGTYPE_AND:
         case AGGTYPE_OR:
@@ -68,6 +69,8 @@ extract_aggregate(
         case AGGTYPE_JOIN:
         case AGGTYPE_IDENTITY:
         case AGGTYPE_DISTINCT_COUNT:
+        case AGGTYPE_APPROX_DISTINCT_COUNT:
+        case AGGTYPE_APPROX_PERCENTILE:
         case AGGTYPE_DISTINCT_LEAF: {
             t_tscalar rval = aggcol->get_scalar(ridx);
             return rval;
@@ -81,6 +81,287 @@ t_fterm::get_expr() const {
     return ss.str();
 }
 
+namespace {
+
+template <typename DATA_T>
+inline std::uint64_t
+value_bits(DATA_T value) {
+    std::uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(DATA_T));
+    return bits;
+}
+
+inline t_mask::t_block
+block_bit(t_uindex idx) {
+    return t_mask::t_block(1) << idx;
+}
+
+} // end anonymous namespace
+
+t_fterm_kernel::t_fterm_kernel(const t_fterm& fterm, t_column* column)
+    : m_fterm(fterm)
+    , m_column(column)
+    , m_type(KERNEL_SCALAR)
+    , m_dtype(column->get_dtype())
+    , m_threshold_bits(0)
+    , m_threshold_exists(false) {
+    t_filter_op op = m_fterm.m_op;
+    const t_tscalar& threshold = m_fterm.m_threshold;
+
+    if (op == FILTER_OP_IS_NULL || op == FILTER_OP_IS_NOT_NULL) {
+        m_type = KERNEL_STATUS;
+        return;
+    }
+
+    bool in_op = op == FILTER_OP_IN || op == FILTER_OP_NOT_IN;
+
+    if (m_dtype == DTYPE_STR) {
+        const t_vocab* vocab = m_column->_get_vocab();
+
+        if (m_fterm.m_use_interned) {
+            t_uindex interned;
+            m_threshold_exists = vocab->string_exists(threshold.get_char_ptr(), interned);
+            m_threshold_bits = interned;
+            m_type = KERNEL_VOCAB;
+        } else if (in_op) {
+            for (const auto& s : m_fterm.m_bag) {
+                t_uindex interned;
+                if (s.m_type == DTYPE_STR && s.is_valid()
+                    && vocab->string_exists(s.get_char_ptr(), interned)) {
+                    m_bag_bits.push_back(interned);
+                }
+            }
+            m_type = KERNEL_VOCAB;
+        }
+        return;
+    }
+
+    switch (m_dtype) {
+        case DTYPE_INT64:
+        case DTYPE_INT32:
+        case DTYPE_INT16:
+        case DTYPE_INT8:
+        case DTYPE_UINT64:
+        case DTYPE_UINT32:
+        case DTYPE_UINT16:
+        case DTYPE_UINT8:
+        case DTYPE_FLOAT64:
+        case DTYPE_FLOAT32:
+        case DTYPE_DATE:
+        case DTYPE_TIME:
+        case DTYPE_BOOL: break;
+        default: return;
+    }
+
+    switch (op) {
+        case FILTER_OP_LT:
+        case FILTER_OP_LTEQ:
+        case FILTER_OP_GT:
+        case FILTER_OP_GTEQ:
+        case FILTER_OP_EQ:
+        case FILTER_OP_NE: {
+            // A threshold of a different dtype or status orders by dtype or
+            // status rather than by value, so leave it to `t_tscalar`.
+            if (threshold.m_type != m_dtype || !threshold.is_valid())
+                return;
+            m_threshold_bits = threshold.m_data.m_uint64;
+            m_type = KERNEL_VALUE;
+        } break;
+        case FILTER_OP_IN:
+        case FILTER_OP_NOT_IN: {
+            // A valid cell can only equal valid bag elements of its dtype.
+            for (const auto& s : m_fterm.m_bag) {
+                if (s.m_type == m_dtype && s.is_valid()) {
+                    m_bag_bits.push_back(s.m_data.m_uint64);
+                }
+            }
+            m_type = KERNEL_VALUE;
+        } break;
+        default: break;
+    }
+}
+
+t_mask::t_block
+t_fterm_kernel::evaluate(t_uindex offset, t_uindex num_rows) const {
+    switch (m_type) {
+        case KERNEL_STATUS: {
+            return evaluate_status(offset, num_rows);
+        } break;
+        case KERNEL_VOCAB: {
+            return evaluate_vocab(offset, num_rows);
+        } break;
+        case KERNEL_VALUE: {
+            switch (m_dtype) {
+                case DTYPE_INT64: {
+                    return evaluate_value<std::int64_t>(offset, num_rows);
+                } break;
+                case DTYPE_INT32: {
+                    return evaluate_value<std::int32_t>(offset, num_rows);
+                } break;
+                case DTYPE_INT16: {
+                    return evaluate_value<std::int16_t>(offset, num_rows);
+                } break;
+                case DTYPE_INT8: {
+                    return evaluate_value<std::int8_t>(offset, num_rows);
+                } break;
+                case DTYPE_UINT64: {
+                    return evaluate_value<std::uint64_t>(offset, num_rows);
+                } break;
+                case DTYPE_UINT32: {
+                    return evaluate_value<std::uint32_t>(offset, num_rows);
+                } break;
+                case DTYPE_UINT16: {
+                    return evaluate_value<std::uint16_t>(offset, num_rows);
+                } break;
+                case DTYPE_UINT8: {
+                    return evaluate_value<std::uint8_t>(offset, num_rows);
+                } break;
+                case DTYPE_FLOAT64: {
+                    return evaluate_value<double>(offset, num_rows);
+                } break;
+                case DTYPE_FLOAT32: {
+                    return evaluate_value<float>(offset, num_rows);
+                } break;
+                case DTYPE_DATE: {
+                    return evaluate_value<t_date::t_rawtype>(offset, num_rows);
+                } break;
+                case DTYPE_TIME: {
+                    return evaluate_value<t_time::t_rawtype>(offset, num_rows);
+                } break;
+                case DTYPE_BOOL: {
+                    return evaluate_value<bool>(offset, num_rows);
+                } break;
+                default: { PSP_COMPLAIN_AND_ABORT("Unexpected dtype for filter kernel"); } break;
+            }
+        } break;
+        default: break;
+    }
+
+    return evaluate_scalar(offset, num_rows);
+}
+
+template <typename DATA_T>
+t_mask::t_block
+t_fterm_kernel::evaluate_value(t_uindex offset, t_uindex num_rows) const {
+    const DATA_T* data = m_column->get_nth<DATA_T>(offset);
+    DATA_T threshold;
+    std::memcpy(&threshold, &m_threshold_bits, sizeof(DATA_T));
+    bool negated = m_fterm.m_negated;
+    t_mask::t_block rval = 0;
+
+    // Equality is on the raw bits of the value, as in `t_tscalar::operator==`.
+    for (t_uindex idx = 0; idx < num_rows; ++idx) {
+        DATA_T value = data[idx];
+        std::uint64_t bits = value_bits(value);
+        bool r;
+
+        switch (m_fterm.m_op) {
+            case FILTER_OP_LT: {
+                r = value < threshold;
+            } break;
+            case FILTER_OP_LTEQ: {
+                r = value < threshold || bits == m_threshold_bits;
+            } break;
+            case FILTER_OP_GT: {
+                r = value > threshold;
+            } break;
+            case FILTER_OP_GTEQ: {
+                r = value > threshold || bits == m_threshold_bits;
+            } break;
+            case FILTER_OP_EQ: {
+                r = bits == m_threshold_bits;
+            } break;
+            case FILTER_OP_NE: {
+                r = bits != m_threshold_bits;
+            } break;
+            case FILTER_OP_IN: {
+                r = in_bag(bits);
+            } break;
+            case FILTER_OP_NOT_IN: {
+                r = !in_bag(bits);
+            } break;
+            default: { r = false; } break;
+        }
+
+        if (r != negated) {
+            rval |= block_bit(idx);
+        }
+    }
+
+    return rval & get_valid_block(offset, num_rows);
+}
+
+t_mask::t_block
+t_fterm_kernel::evaluate_status(t_uindex offset, t_uindex num_rows) const {
+    bool want_valid = (m_fterm.m_op == FILTER_OP_IS_NOT_NULL) != m_fterm.m_negated;
+    t_mask::t_block valid = get_valid_block(offset, num_rows);
+
+    if (want_valid) {
+        return valid;
+    }
+
+    t_mask::t_block all_rows = num_rows == t_mask::BITS_PER_BLOCK
+        ? ~t_mask::t_block(0)
+        : block_bit(num_rows) - 1;
+
+    return ~valid & all_rows;
+}
+
+t_mask::t_block
+t_fterm_kernel::evaluate_vocab(t_uindex offset, t_uindex num_rows) const {
+    const t_uindex* data = m_column->get_nth<t_uindex>(offset);
+    bool negated = m_fterm.m_negated;
+    t_mask::t_block rval = 0;
+
+    if (m_fterm.m_use_interned) {
+        // Interned comparisons are on the vocab id alone - a threshold
+        // missing from the vocab equals no cell.
+        bool ne = m_fterm.m_op == FILTER_OP_NE;
+        for (t_uindex idx = 0; idx < num_rows; ++idx) {
+            bool r = m_threshold_exists && data[idx] == m_threshold_bits;
+            if ((r != ne) != negated) {
+                rval |= block_bit(idx);
+            }
+        }
+        return rval;
+    }
+
+    bool not_in = m_fterm.m_op == FILTER_OP_NOT_IN;
+    for (t_uindex idx = 0; idx < num_rows; ++idx) {
+        bool r = in_bag(data[idx]);
+        if ((r != not_in) != negated) {
+            rval |= block_bit(idx);
+        }
+    }
+
+    return rval & get_valid_block(offset, num_rows);
+}
+
+t_mask::t_block
+t_fterm_kernel::evaluate_scalar(t_uindex offset, t_uindex num_rows) const {
+    t_mask::t_block rval = 0;
+
+    for (t_uindex idx = 0; idx < num_rows; ++idx) {
+        t_tscalar cell_val = m_column->get_scalar(offset + idx);
+        if (cell_val.is_valid() && m_fterm(cell_val)) {
+            rval |= block_bit(idx);
+        }
+    }
+
+    return rval;
+}
+
+t_mask::t_block
+t_fterm_kernel::get_valid_block(t_uindex offset, t_uindex num_rows) const {
+    return static_cast<t_mask::t_block>(m_column->get_valid_word(offset, num_rows));
+}
+
+bool
+t_fterm_kernel::in_bag(std::uint64_t bits) const {
+    return std::find(m_bag_bits.begin(), m_bag_bits.end(), bits) != m_bag_bits.end();
+}
+
+
 t_filter::t_filter()
     : m_mode(SELECT_MODE_ALL) {}
 
@@ -354,6 +354,20 @@ t_ftrav::empty_sort_by() const {
     return m_sortby.empty();
 }
 
+t_memory_report
+t_ftrav::get_memory_usage() const {
+    t_memory_usage sort_index = get_vector_memory_usage("sort_index", *m_index);
+    for (const t_mselem& elem : *m_index) {
+        sort_index.m_reserved += elem.m_row.capacity() * sizeof(t_tscalar);
+        sort_index.m_used += elem.m_row.size() * sizeof(t_tscalar);
+    }
+
+    t_memory_report rval;
+    rval.push_back(sort_index);
+    rval.push_back(get_hash_memory_usage("pkey_index", m_pkeyidx));
+    return rval;
+}
+
 void
 t_ftrav::reset_step_state() {
     m_step_deletes = 0;
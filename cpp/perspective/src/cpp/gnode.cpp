@@ -45,14 +45,24 @@ calc_negate(t_tscalar val) {
 }
 
 t_gnode::t_gnode(const t_schema& input_schema, const t_schema& output_schema)
+    : t_gnode(input_schema, output_schema, GNODE_TYPE_PKEYED) {}
+
+t_gnode::t_gnode(const t_schema& input_schema, const t_schema& output_schema,
+    t_gnode_type gnode_type)
+    : t_gnode(input_schema, output_schema, gnode_type, std::numeric_limits<t_uindex>::max()) {}
+
+t_gnode::t_gnode(const t_schema& input_schema, const t_schema& output_schema,
+    t_gnode_type gnode_type, t_uindex limit)
     : m_mode(NODE_PROCESSING_SIMPLE_DATAFLOW)
-    , m_gnode_type(GNODE_TYPE_PKEYED)
+    , m_gnode_type(gnode_type)
+    , m_limit(limit)
     , m_input_schema(input_schema)
     , m_output_schema(output_schema)
     , m_init(false)
     , m_id(0)
     , m_last_input_port_id(0)
-    , m_pool_cleanup([]() {}) {
+    , m_pool_cleanup([]() {})
+    , m_vocab_bytes_reclaimed(0) {
     PSP_TRACE_SENTINEL();
     LOG_CONSTRUCTOR("t_gnode");
 
@@ -83,11 +93,21 @@ t_gnode::init() {
     m_gstate = std::make_shared<t_gstate>(m_input_schema, m_output_schema);
     m_gstate->init();
 
+    if (m_gnode_type == GNODE_TYPE_APPEND_ONLY || m_gnode_type == GNODE_TYPE_RING) {
+        m_gstate->set_implicit_pkeys();
+    }
+
+    // The input, flattened and transitional tables are rebuilt on every
+    // update, so their stores are recycled through a pool that is reset
+    // in `clear_output_ports`.
+    m_lstore_pool = std::make_shared<t_lstore_pool>();
+
     // Create and store the main input port, which is always port 0. The next
     // input port will be port 1, and so on
     std::shared_ptr<t_port> input_port = 
         std::make_shared<t_port>(PORT_MODE_PKEYED, m_input_schema);
 
+    input_port->set_lstore_pool(m_lstore_pool);
     input_port->init();
 
     m_input_ports[0] = input_port;
@@ -97,6 +117,7 @@ t_gnode::init() {
 
         std::shared_ptr<t_port> port = std::make_shared<t_port>(mode, m_transitional_schemas[idx]);
 
+        port->set_lstore_pool(m_lstore_pool);
         port->init();
         m_oports.push_back(port);
     }
@@ -129,6 +150,7 @@ t_gnode::make_input_port() {
     PSP_VERBOSE_ASSERT(m_init, "Cannot `make_input_port` on an uninited gnode.");
     std::shared_ptr<t_port> input_port = 
         std::make_shared<t_port>(PORT_MODE_PKEYED, m_input_schema);
+    input_port->set_lstore_pool(m_lstore_pool);
     input_port->init();
 
     t_uindex port_id = m_last_input_port_id + 1;
@@ -278,6 +300,28 @@ t_gnode::_process_table(t_uindex port_id) {
     }
 
     m_was_updated = true;
+
+    // Compact string vocabularies before the transitional tables borrow
+    // them again, as compaction renumbers the ids the previous update left
+    // in those tables.
+    m_vocab_bytes_reclaimed += m_gstate->compact_vocabularies();
+
+    // Row lookups below index into the compacted master table.
+    compact_rows();
+
+    if (m_gnode_type == GNODE_TYPE_APPEND_ONLY
+        && m_gstate->is_append(input_port->get_table().get())) {
+        return _process_appended_table(input_port);
+    }
+
+    // The first update to a ring is written by the usual process, which
+    // takes the columns of the input table.
+    if (m_gnode_type == GNODE_TYPE_RING && m_gstate->mapping_size() > 0
+        && _supports_ring_process()
+        && m_gstate->is_ring_write(input_port->get_table().get(), m_limit)) {
+        return _process_ring_table(input_port);
+    }
+
     flattened = input_port->get_table()->flatten();
 
     PSP_GNODE_VERIFY_TABLE(flattened);
@@ -285,14 +329,10 @@ t_gnode::_process_table(t_uindex port_id) {
 
     t_uindex flattened_num_rows = flattened->num_rows();
 
-    std::vector<t_rlookup> row_lookup(flattened_num_rows);
     t_column* pkey_col = flattened->get_column("psp_pkey").get();
-    
-    for (t_uindex idx = 0; idx < flattened_num_rows; ++idx) {
-        // See if each primary key in flattened already exist in the dataset
-        t_tscalar pkey = pkey_col->get_scalar(idx);
-        row_lookup[idx] = m_gstate->lookup(pkey);
-    }
+
+    // See if each primary key in flattened already exist in the dataset
+    std::vector<t_rlookup> row_lookup = m_gstate->lookup(pkey_col);
 
     // first update - master table is empty
     if (m_gstate->mapping_size() == 0) {
@@ -355,8 +395,12 @@ t_gnode::_process_table(t_uindex port_id) {
     // Clear delta, prev, current, transitions, existed on EACH call.
     _process_state.clear_transitional_data_tables();
 
+    // Only write delta, prev, current and transitions if a context reads
+    // them - otherwise they are left empty for this update.
+    _process_state.m_materialize_transitions = _requires_transitional_tables();
+
     // compute values on transitional tables before reserve
-    if (m_expression_map.size() > 0) {
+    if (_process_state.m_materialize_transitions && m_expression_map.size() > 0) {
         _compute_expressions({
             _process_state.m_delta_data_table,
             _process_state.m_prev_data_table,
@@ -381,7 +425,7 @@ t_gnode::_process_table(t_uindex port_id) {
     }
 
 
-    t_uindex ncols = column_names.size();
+    t_uindex ncols = _process_state.m_materialize_transitions ? column_names.size() : 0;
 
 #ifdef PSP_PARALLEL_FOR
     tbb::parallel_for(0, int(ncols), 1,
@@ -402,43 +446,43 @@ t_gnode::_process_table(t_uindex port_id) {
 
             switch (col_dtype) {
                 case DTYPE_INT64: {
-                    _process_column<std::int64_t>(fcolumn, scolumn, dcolumn, pcolumn, ccolumn, tcolumn, _process_state);
+                    _process_numeric_column<std::int64_t>(fcolumn, scolumn, dcolumn, pcolumn, ccolumn, tcolumn, _process_state);
                 } break;
                 case DTYPE_INT32: {
-                    _process_column<std::int32_t>(fcolumn, scolumn, dcolumn, pcolumn, ccolumn, tcolumn, _process_state);
+                    _process_numeric_column<std::int32_t>(fcolumn, scolumn, dcolumn, pcolumn, ccolumn, tcolumn, _process_state);
                 } break;
                 case DTYPE_INT16: {
-                    _process_column<std::int16_t>(fcolumn, scolumn, dcolumn, pcolumn, ccolumn, tcolumn, _process_state);
+                    _process_numeric_column<std::int16_t>(fcolumn, scolumn, dcolumn, pcolumn, ccolumn, tcolumn, _process_state);
                 } break;
                 case DTYPE_INT8: {
-                    _process_column<std::int8_t>(fcolumn, scolumn, dcolumn, pcolumn, ccolumn, tcolumn, _process_state);
+                    _process_numeric_column<std::int8_t>(fcolumn, scolumn, dcolumn, pcolumn, ccolumn, tcolumn, _process_state);
                 } break;
                 case DTYPE_UINT64: {
-                    _process_column<std::uint64_t>(fcolumn, scolumn, dcolumn, pcolumn, ccolumn, tcolumn, _process_state);
+                    _process_numeric_column<std::uint64_t>(fcolumn, scolumn, dcolumn, pcolumn, ccolumn, tcolumn, _process_state);
                 } break;
                 case DTYPE_UINT32: {
-                    _process_column<std::uint32_t>(fcolumn, scolumn, dcolumn, pcolumn, ccolumn, tcolumn, _process_state);
+                    _process_numeric_column<std::uint32_t>(fcolumn, scolumn, dcolumn, pcolumn, ccolumn, tcolumn, _process_state);
                 } break;
                 case DTYPE_UINT16: {
-                    _process_column<std::uint16_t>(fcolumn, scolumn, dcolumn, pcolumn, ccolumn, tcolumn, _process_state);
+                    _process_numeric_column<std::uint16_t>(fcolumn, scolumn, dcolumn, pcolumn, ccolumn, tcolumn, _process_state);
                 } break;
                 case DTYPE_UINT8: {
-                    _process_column<std::uint8_t>(fcolumn, scolumn, dcolumn, pcolumn, ccolumn, tcolumn, _process_state);
+                    _process_numeric_column<std::uint8_t>(fcolumn, scolumn, dcolumn, pcolumn, ccolumn, tcolumn, _process_state);
                 } break;
                 case DTYPE_FLOAT64: {
-                    _process_column<double>(fcolumn, scolumn, dcolumn, pcolumn, ccolumn, tcolumn, _process_state);
+                    _process_numeric_column<double>(fcolumn, scolumn, dcolumn, pcolumn, ccolumn, tcolumn, _process_state);
                 } break;
                 case DTYPE_FLOAT32: {
-                    _process_column<float>(fcolumn, scolumn, dcolumn, pcolumn, ccolumn, tcolumn, _process_state);
+                    _process_numeric_column<float>(fcolumn, scolumn, dcolumn, pcolumn, ccolumn, tcolumn, _process_state);
                 } break;
                 case DTYPE_BOOL: {
-                    _process_column<std::uint8_t>(fcolumn, scolumn, dcolumn, pcolumn, ccolumn, tcolumn, _process_state);
+                    _process_numeric_column<std::uint8_t>(fcolumn, scolumn, dcolumn, pcolumn, ccolumn, tcolumn, _process_state);
                 } break;
                 case DTYPE_TIME: {
-                    _process_column<std::int64_t>(fcolumn, scolumn, dcolumn, pcolumn, ccolumn, tcolumn, _process_state);
+                    _process_numeric_column<std::int64_t>(fcolumn, scolumn, dcolumn, pcolumn, ccolumn, tcolumn, _process_state);
                 } break;
                 case DTYPE_DATE: {
-                    _process_column<std::uint32_t>(fcolumn, scolumn, dcolumn, pcolumn, ccolumn, tcolumn, _process_state);
+                    _process_numeric_column<std::uint32_t>(fcolumn, scolumn, dcolumn, pcolumn, ccolumn, tcolumn, _process_state);
                 } break;
                 case DTYPE_STR: {
                     _process_column<std::string>(fcolumn, scolumn, dcolumn, pcolumn, ccolumn, tcolumn, _process_state);
@@ -453,7 +497,7 @@ t_gnode::_process_table(t_uindex port_id) {
     );
 #endif
     // After transitional tables are written, compute their values
-    if (m_expression_map.size() > 0) {
+    if (_process_state.m_materialize_transitions && m_expression_map.size() > 0) {
         _compute_expressions({
             _process_state.m_delta_data_table,
             _process_state.m_prev_data_table,
@@ -468,16 +512,14 @@ t_gnode::_process_table(t_uindex port_id) {
      * added rows, updated in-place rows, and rows to be removed.
      * 
      * `existed_mask` is a bitset marked true for `OP_INSERT`, and false for
-     * `OP_DELETE`. If there are any `OP_DELETE`s, the next step returns a
-     * new `t_data_table` with the deleted rows masked out.
+     * `OP_DELETE`s of rows that do not exist. If there are any, the next
+     * step removes them from `flattened` in place - the transitional tables
+     * are already written, so nothing reads the removed rows.
      */
-    std::shared_ptr<t_data_table> flattened_masked;
+    std::shared_ptr<t_data_table> flattened_masked = _process_state.m_flattened_data_table;
 
-    if (existed_mask.count() == _process_state.m_flattened_data_table->size()) {
-        flattened_masked = _process_state.m_flattened_data_table;
-    } else {
-        flattened_masked = 
-            _process_state.m_flattened_data_table->clone(existed_mask);
+    if (existed_mask.count() != flattened_masked->size()) {
+        flattened_masked->retain(existed_mask);
     }
 
     PSP_GNODE_VERIFY_TABLE(flattened_masked);
@@ -506,6 +548,126 @@ t_gnode::_process_table(t_uindex port_id) {
     return result;
 }
 
+bool
+t_gnode::_requires_transitional_tables() const {
+    // `_process_column` also maintains the reference counts of object
+    // columns, so they must always be processed.
+    for (t_dtype dtype : m_output_schema.m_types) {
+        if (dtype == DTYPE_OBJECT)
+            return true;
+    }
+
+    for (const auto& kv : m_contexts) {
+        const t_ctx_handle& ctxh = kv.second;
+        switch (ctxh.get_type()) {
+            case TWO_SIDED_CONTEXT:
+            case ONE_SIDED_CONTEXT: {
+                // Sparse trees are updated from all transitional tables.
+                return true;
+            } break;
+            case ZERO_SIDED_CONTEXT: {
+                // Filtered rows are compared against `prev` and `current`.
+                if (ctxh.get<t_ctx0>()->get_config().has_filters())
+                    return true;
+            } break;
+            case UNIT_CONTEXT:
+            case GROUPED_PKEY_CONTEXT: {
+                // Only read `flattened` and `existed`.
+            } break;
+            default: { PSP_COMPLAIN_AND_ABORT("Unexpected context type"); } break;
+        }
+    }
+
+    return false;
+}
+
+t_process_table_result
+t_gnode::_process_appended_table(std::shared_ptr<t_port>& input_port) {
+    t_process_table_result result;
+    result.m_flattened_data_table = nullptr;
+
+    // The input table is already sorted by pkey without duplicates, so it
+    // does not need to be flattened - take ownership of it instead.
+    std::shared_ptr<t_data_table> appended = input_port->get_table();
+    input_port->release();
+
+    if (m_expression_map.size() > 0) {
+        _compute_expressions({appended});
+    }
+
+    m_gstate->append_master_table(appended.get());
+
+    #ifdef PSP_GNODE_VERIFY
+    {
+        auto updated_table = get_table();
+        PSP_GNODE_VERIFY_TABLE(updated_table);
+    }
+    #endif
+
+    m_oports[PSP_PORT_FLATTENED]->set_table(appended);
+
+    // Contexts read the appended rows from `appended` and gnode state, so
+    // this must happen after the master table has been updated.
+    _notify_contexts_appended(appended);
+
+    release_outputs();
+
+    result.m_should_notify_userspace = true;
+    return result;
+}
+
+bool
+t_gnode::_supports_ring_process() const {
+    for (t_dtype dtype : m_output_schema.m_types) {
+        if (dtype == DTYPE_OBJECT)
+            return false;
+    }
+
+    for (const auto& kv : m_contexts) {
+        if (kv.second.get_type() == GROUPED_PKEY_CONTEXT)
+            return false;
+    }
+
+    return true;
+}
+
+t_process_table_result
+t_gnode::_process_ring_table(std::shared_ptr<t_port>& input_port) {
+    t_process_table_result result;
+    result.m_flattened_data_table = nullptr;
+
+    // Each slot is written at most once, so the input table does not need
+    // to be flattened - take ownership of it instead.
+    std::shared_ptr<t_data_table> appended = input_port->get_table();
+    input_port->release();
+
+    if (m_expression_map.size() > 0) {
+        _compute_expressions({appended});
+    }
+
+    // Evicted rows are only copied out of the master table for contexts
+    // that read their values, i.e. those that would otherwise read `prev`.
+    t_ring_step step = m_gstate->write_ring(appended, _requires_transitional_tables());
+
+    #ifdef PSP_GNODE_VERIFY
+    {
+        auto updated_table = get_table();
+        PSP_GNODE_VERIFY_TABLE(updated_table);
+    }
+    #endif
+
+    m_oports[PSP_PORT_FLATTENED]->set_table(appended);
+
+    // Contexts read the written rows from gnode state as well as `step`, so
+    // this must happen after the master table has been updated.
+    _notify_contexts_ring(step);
+
+    release_outputs();
+
+    result.m_should_notify_userspace = true;
+    return result;
+}
+
 template <>
 void
 t_gnode::_process_column<std::string>(
@@ -615,6 +777,14 @@ t_gnode::process(t_uindex port_id) {
     PerspectiveScopedGILRelease acquire(m_event_loop_thread_id);
 #endif
 
+    return _process(port_id);
+}
+
+bool
+t_gnode::_process(t_uindex port_id) {
+    PSP_TRACE_SENTINEL();
+    PSP_VERBOSE_ASSERT(m_init, "Cannot `_process` on an uninited gnode.");
+
     t_process_table_result result = _process_table(port_id);
 
     if (result.m_flattened_data_table) {
@@ -745,6 +915,76 @@ t_gnode::_update_contexts_from_state(std::shared_ptr<t_data_table> tbl) {
     }
 }
 
+void
+t_gnode::_notify_contexts_ring(const t_ring_step& step) {
+    PSP_TRACE_SENTINEL();
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+
+    for (auto& kv : m_contexts) {
+        auto& ctxh = kv.second;
+        switch (ctxh.m_ctx_type) {
+            case TWO_SIDED_CONTEXT: {
+                auto ctx = static_cast<t_ctx2*>(ctxh.m_ctx);
+                ctx->step_begin();
+                ctx->notify(step);
+                ctx->step_end();
+            } break;
+            case ONE_SIDED_CONTEXT: {
+                auto ctx = static_cast<t_ctx1*>(ctxh.m_ctx);
+                ctx->step_begin();
+                ctx->notify(step);
+                ctx->step_end();
+            } break;
+            case ZERO_SIDED_CONTEXT: {
+                auto ctx = static_cast<t_ctx0*>(ctxh.m_ctx);
+                ctx->step_begin();
+                ctx->notify(step);
+                ctx->step_end();
+            } break;
+            case UNIT_CONTEXT: {
+                auto ctx = static_cast<t_ctxunit*>(ctxh.m_ctx);
+                ctx->step_begin();
+                ctx->notify(step);
+                ctx->step_end();
+            } break;
+            default: { PSP_COMPLAIN_AND_ABORT("Unexpected context type"); } break;
+        }
+    }
+}
+
+void
+t_gnode::_notify_contexts_appended(std::shared_ptr<t_data_table> tbl) {
+    PSP_TRACE_SENTINEL();
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+
+    for (auto& kv : m_contexts) {
+        auto& ctxh = kv.second;
+        switch (ctxh.m_ctx_type) {
+            case TWO_SIDED_CONTEXT: {
+                auto ctx = static_cast<t_ctx2*>(ctxh.m_ctx);
+                update_context_from_state<t_ctx2>(ctx, tbl);
+            } break;
+            case ONE_SIDED_CONTEXT: {
+                auto ctx = static_cast<t_ctx1*>(ctxh.m_ctx);
+                update_context_from_state<t_ctx1>(ctx, tbl);
+            } break;
+            case ZERO_SIDED_CONTEXT: {
+                auto ctx = static_cast<t_ctx0*>(ctxh.m_ctx);
+                update_context_from_state<t_ctx0>(ctx, tbl);
+            } break;
+            case UNIT_CONTEXT: {
+                auto ctx = static_cast<t_ctxunit*>(ctxh.m_ctx);
+                update_context_from_state<t_ctxunit>(ctx, tbl);
+            } break;
+            case GROUPED_PKEY_CONTEXT: {
+                auto ctx = static_cast<t_ctx_grouped_pkey*>(ctxh.m_ctx);
+                update_context_from_state<t_ctx_grouped_pkey>(ctx, tbl);
+            } break;
+            default: { PSP_COMPLAIN_AND_ABORT("Unexpected context type"); } break;
+        }
+    }
+}
+
 std::vector<std::string>
 t_gnode::get_registered_contexts() const {
     std::vector<std::string> rval;
@@ -1253,6 +1493,60 @@ t_gnode::clear_output_ports() {
     for (t_uindex idx = 0, loop_end = m_oports.size(); idx < loop_end; ++idx) {
         m_oports[idx]->get_table()->clear();
     }
+
+    m_lstore_pool->reset();
+}
+
+t_uindex
+t_gnode::compact_rows(bool force) {
+    for (const auto& kv : m_contexts) {
+        if (kv.second.get_type() == UNIT_CONTEXT)
+            return 0;
+    }
+
+    return m_gstate->compact_rows(force);
+}
+
+void
+t_gnode::save_snapshot(t_snapshot_writer& writer) const {
+    m_gstate->save_snapshot(writer);
+}
+
+void
+t_gnode::load_snapshot(t_snapshot_reader& reader) {
+    if (!m_contexts.empty()) {
+        PSP_COMPLAIN_AND_ABORT("Cannot load a snapshot into a table with views");
+    }
+
+    m_gstate->load_snapshot(reader);
+}
+
+void
+t_gnode::set_backing_store(
+    t_backing_store backing_store, const std::string& dirname, t_access_hint access_hint) {
+    if (!m_contexts.empty()) {
+        PSP_COMPLAIN_AND_ABORT("Cannot move the storage of a table with views");
+    }
+
+    m_gstate->set_backing_store(backing_store, dirname, access_hint);
+}
+
+t_memory_report
+t_gnode::get_memory_usage() const {
+    t_memory_report rval = m_gstate->get_memory_usage();
+    t_lstore_pool_stats stats = m_lstore_pool->get_stats();
+    rval.emplace_back("lstore_pool", stats.m_bytes_retained, 0);
+    return rval;
+}
+
+t_lstore_pool_stats
+t_gnode::get_lstore_pool_stats() const {
+    return m_lstore_pool->get_stats();
+}
+
+t_uindex
+t_gnode::get_vocab_bytes_reclaimed() const {
+    return m_vocab_bytes_reclaimed;
 }
 
 t_data_table*
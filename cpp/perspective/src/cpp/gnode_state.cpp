@@ -14,17 +14,31 @@
 #include <perspective/context_two.h>
 #include <perspective/gnode_state.h>
 #include <perspective/mask.h>
-#include <perspective/sym_table.h>
+#include <algorithm>
+#include <numeric>
 #ifdef PSP_PARALLEL_FOR
 #include <tbb/tbb.h>
 #endif
 
 namespace perspective {
 
+t_ring_step::t_ring_step()
+    : m_fresh_begin(0)
+    , m_fresh_end(0) {}
+
+bool
+t_ring_step::is_evicted(t_uindex idx) const {
+    return idx < m_fresh_begin || idx >= m_fresh_end;
+}
+
 t_gstate::t_gstate(const t_schema& input_schema, const t_schema& output_schema)
     : m_input_schema(input_schema)
     , m_output_schema(output_schema)
-    , m_init(false) {
+    , m_init(false)
+    , m_backing_store(BACKING_STORE_MEMORY)
+    , m_access_hint(ACCESS_HINT_NORMAL)
+    , m_mapping(input_schema.has_column("psp_pkey") ? input_schema.get_dtype("psp_pkey")
+                                                    : DTYPE_NONE) {
     LOG_CONSTRUCTOR("t_gstate");
 }
 
@@ -32,25 +46,96 @@ t_gstate::~t_gstate() { LOG_DESTRUCTOR("t_gstate"); }
 
 void
 t_gstate::init() {
-    m_table = std::make_shared<t_data_table>(
-        "", "", m_input_schema, DEFAULT_EMPTY_CAPACITY, BACKING_STORE_MEMORY);
-    m_table->init();
+    m_table = make_master_table(m_input_schema, DEFAULT_EMPTY_CAPACITY);
     m_pkcol = m_table->get_column("psp_pkey");
     m_opcol = m_table->get_column("psp_op");
+    m_mapping.set_pkey_column(m_pkcol);
+    pack_status();
     m_init = true;
 }
 
+std::shared_ptr<t_data_table>
+t_gstate::make_master_table(const t_schema& schema, t_uindex capacity) const {
+    auto table = std::make_shared<t_data_table>("", m_dirname, schema, capacity, m_backing_store);
+    table->set_access_hint(m_access_hint);
+    table->init();
+    return table;
+}
+
+void
+t_gstate::set_backing_store(
+    t_backing_store backing_store, const std::string& dirname, t_access_hint access_hint) {
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    PSP_VERBOSE_ASSERT(backing_store == BACKING_STORE_MEMORY || !dirname.empty(),
+        "A directory is required for BACKING_STORE_DISK");
+
+    if (backing_store == m_backing_store && dirname == m_dirname) {
+        m_access_hint = access_hint;
+        m_table->set_access_hint(access_hint);
+        return;
+    }
+
+    m_backing_store = backing_store;
+    m_dirname = dirname;
+    m_access_hint = access_hint;
+
+    // Move every row, including free rows, so that row indices are
+    // unchanged. Appending into empty columns copies string vocabularies
+    // as they are, so the ids that `m_mapping` stores for string primary
+    // keys stay valid.
+    const t_schema& schema = m_table->get_schema();
+    t_uindex nrows = m_table->num_rows();
+    std::shared_ptr<t_data_table> table = make_master_table(
+        schema, std::max(nrows, static_cast<t_uindex>(DEFAULT_EMPTY_CAPACITY)));
+
+    for (auto column : table->get_columns()) {
+        column->set_status_packed(true);
+    }
+
+    for (t_uindex idx = 0, loop_end = schema.size(); idx < loop_end; ++idx) {
+        const std::string& column_name = schema.m_columns[idx];
+        table->get_column(column_name)->append(*m_table->get_const_column(column_name));
+    }
+
+    table->set_size(nrows);
+    m_table = table;
+    m_pkcol = m_table->get_column("psp_pkey");
+    m_opcol = m_table->get_column("psp_op");
+    m_mapping.set_pkey_column(m_pkcol);
+}
+
+t_memory_report
+t_gstate::get_memory_usage() const {
+    t_memory_report rval;
+    append_memory_usage(rval, "columns", m_table->get_memory_usage());
+    rval.push_back(m_mapping.get_memory_usage("pkey_map"));
+    rval.push_back(get_hash_memory_usage("free_rows", m_free));
+    return rval;
+}
+
 t_rlookup
 t_gstate::lookup(t_tscalar pkey) const {
-    t_rlookup rval(0, false);
+    return m_mapping.find(pkey);
+}
 
-    t_mapping::const_iterator iter = m_mapping.find(pkey);
+std::vector<t_rlookup>
+t_gstate::lookup(const t_column* pkey_col) const {
+    t_uindex num_rows = pkey_col->size();
+    std::vector<t_rlookup> rval(num_rows);
 
-    if (iter == m_mapping.end())
-        return rval;
+#ifdef PSP_PARALLEL_FOR
+    tbb::parallel_for(0, int(num_rows), 1,
+        [&rval, pkey_col, this](int idx)
+#else
+    for (t_uindex idx = 0; idx < num_rows; ++idx)
+#endif
+        {
+            rval[idx] = m_mapping.find(pkey_col->get_scalar(idx));
+        }
+#ifdef PSP_PARALLEL_FOR
+    );
+#endif
 
-    rval.m_idx = iter->second;
-    rval.m_exists = true;
     return rval;
 }
 
@@ -61,38 +146,40 @@ t_gstate::_mark_deleted(t_uindex idx) {
 
 void
 t_gstate::erase(const t_tscalar& pkey) {
-    t_mapping::const_iterator iter = m_mapping.find(pkey);
+    t_uindex idx;
 
-    if (iter == m_mapping.end()) {
+    if (!m_mapping.erase(pkey, idx)) {
         return;
     }
 
     auto columns = m_table->get_columns();
 
-    t_uindex idx = iter->second;
-
     for (auto c : columns) {
         c->clear(idx);
     }
 
-    m_mapping.erase(iter);
     _mark_deleted(idx);
 }
 
 t_uindex
 t_gstate::lookup_or_create(const t_tscalar& pkey) {
-    auto pkey_ = m_symtable.get_interned_tscalar(pkey);
-    t_mapping::const_iterator iter = m_mapping.find(pkey_);
+    t_rlookup lk = m_mapping.find(pkey);
 
-    if (iter != m_mapping.end()) {
-        return iter->second;
+    if (lk.m_exists) {
+        return lk.m_idx;
     }
 
+    t_uindex idx = create_row(pkey);
+    m_mapping.insert(pkey, idx);
+    return idx;
+}
+
+t_uindex
+t_gstate::create_row(const t_tscalar& pkey) {
     if (!m_free.empty()) {
         t_free_items::const_iterator iter = m_free.begin();
         t_uindex idx = *iter;
         m_free.erase(iter);
-        m_mapping[pkey_] = idx;
         return idx;
     }
 
@@ -105,7 +192,6 @@ t_gstate::lookup_or_create(const t_tscalar& pkey) {
     m_table->set_size(nrows + 1);
     m_opcol->set_nth<std::uint8_t>(nrows, OP_INSERT);
     m_pkcol->set_scalar(nrows, pkey);
-    m_mapping[pkey_] = nrows;
     return nrows;
 }
 
@@ -123,14 +209,21 @@ t_gstate::fill_master_table(const t_data_table* flattened) {
     t_uindex ncols = m_table->num_columns();
     auto master_table = m_table.get();
 
+    // Columns on disk are filled in place rather than replaced by the
+    // flattened columns, which live in memory.
+    bool fill_in_place = m_backing_store == BACKING_STORE_DISK;
+    if (fill_in_place) {
+        master_table->reserve(flattened->num_rows());
+    }
+
 #ifdef PSP_PARALLEL_FOR
     tbb::parallel_for(0, int(ncols), 1,
-        [&master_table, &master_table_schema, &flattened](int idx)
+        [&master_table, &master_table_schema, &flattened, fill_in_place](int idx)
 #else
     for (t_uindex idx = 0; idx < ncols; ++idx)
 #endif
         {
-            // Clone each column from flattened into `m_table`
+            // Take each column from flattened into `m_table`
             const std::string& column_name = master_table_schema.m_columns[idx];
             // No need for safe lookup as master_table schema == flattened schema
             auto flattened_column = flattened->get_const_column_safe(column_name);
@@ -141,26 +234,46 @@ t_gstate::fill_master_table(const t_data_table* flattened) {
                 continue;
 #endif
             }
-            master_table->set_column(idx, flattened_column->clone());
+            if (fill_in_place) {
+                master_table->get_column(column_name)->append(*flattened_column);
+            } else {
+                // `flattened` is only read until the output ports are
+                // cleared, and stops writing to the column once shared. The
+                // master table outlives the update, so the column leaves
+                // the gnode's `t_lstore_pool`.
+                std::shared_ptr<t_column> column = flattened->share_column(column_name);
+                column->detach_pool();
+                master_table->set_column(idx, column);
+            }
         }
 #ifdef PSP_PARALLEL_FOR
     );
 #endif
     m_pkcol = master_table->get_column("psp_pkey");
     m_opcol = master_table->get_column("psp_op");
+    m_mapping.set_pkey_column(m_pkcol);
+    pack_status();
 
-    master_table->set_capacity(flattened->get_capacity());
+    if (!fill_in_place) {
+        master_table->set_capacity(flattened->get_capacity());
+    }
     master_table->set_size(flattened->size());
 
-    for (t_uindex idx = 0, loop_end = flattened->num_rows(); idx < loop_end; ++idx) {
+    t_uindex num_rows = flattened->num_rows();
+    std::vector<t_tscalar> pkeys;
+    std::vector<t_uindex> indexes;
+    pkeys.reserve(num_rows);
+    indexes.reserve(num_rows);
+
+    for (t_uindex idx = 0; idx < num_rows; ++idx) {
         t_tscalar pkey = flattened_pkey_col->get_scalar(idx);
         const std::uint8_t* op_ptr = flattened_op_col->get_nth<std::uint8_t>(idx);
         t_op op = static_cast<t_op>(*op_ptr);
 
         switch (op) {
             case OP_INSERT: {
-                // Write new primary keys into `m_mapping`
-                m_mapping[m_symtable.get_interned_tscalar(pkey)] = idx;
+                pkeys.push_back(pkey);
+                indexes.push_back(idx);
                 m_opcol->set_nth<std::uint8_t>(idx, OP_INSERT);
                 m_pkcol->set_scalar(idx, pkey);
             } break;
@@ -171,6 +284,10 @@ t_gstate::fill_master_table(const t_data_table* flattened) {
         }
     }
 
+    // Write new primary keys into `m_mapping`, one task per shard
+    m_mapping.reserve(pkeys.size());
+    m_mapping.insert(pkeys, indexes);
+
 #ifdef PSP_TABLE_VERIFY
     master_table->verify();
 #endif
@@ -192,17 +309,54 @@ t_gstate::update_master_table(const t_data_table* flattened) {
         flattened->get_const_column("psp_op").get();
 
     t_data_table* master_table = m_table.get();
-    std::vector<t_uindex> master_table_indexes(flattened->num_rows());
+    t_uindex num_rows = flattened->num_rows();
+    std::vector<t_uindex> master_table_indexes(num_rows);
+    std::vector<t_tscalar> pkeys(num_rows);
+    std::vector<t_rlookup> lookups(num_rows);
 
-    for (t_uindex idx = 0, loop_end = flattened->num_rows(); idx < loop_end; ++idx) {
-        t_tscalar pkey = flattened_pkey_col->get_scalar(idx);
+    // Read primary keys and look up existing rows in parallel - nothing
+    // writes to `m_mapping` until every lookup is complete.
+#ifdef PSP_PARALLEL_FOR
+    tbb::parallel_for(0, int(num_rows), 1,
+        [&pkeys, &lookups, flattened_pkey_col, this](int idx)
+#else
+    for (t_uindex idx = 0; idx < num_rows; ++idx)
+#endif
+        {
+            pkeys[idx] = flattened_pkey_col->get_scalar(idx);
+            lookups[idx] = m_mapping.find(pkeys[idx]);
+        }
+#ifdef PSP_PARALLEL_FOR
+    );
+#endif
+
+    // Assign row indices in order, so that free rows are reused exactly as
+    // they would be by calling `lookup_or_create` row by row. New primary
+    // keys are collected and written to `m_mapping` afterwards.
+    std::vector<t_tscalar> new_pkeys;
+    std::vector<t_uindex> new_indexes;
+
+    for (t_uindex idx = 0; idx < num_rows; ++idx) {
+        const t_tscalar& pkey = pkeys[idx];
         const std::uint8_t* op_ptr = flattened_op_col->get_nth<std::uint8_t>(idx);
         t_op op = static_cast<t_op>(*op_ptr);
 
         switch (op) {
             case OP_INSERT: {
-                // Lookup/create the row index in `m_table` based on pkey
-                master_table_indexes[idx] = lookup_or_create(pkey);
+                // `flattened` is sorted by pkey, and a pkey that is removed
+                // and re-added has its DELETE row immediately before its
+                // INSERT row, which makes the parallel lookup stale.
+                bool erased = idx > 0
+                    && *(flattened_op_col->get_nth<std::uint8_t>(idx - 1)) == OP_DELETE
+                    && pkeys[idx - 1] == pkey;
+
+                if (lookups[idx].m_exists && !erased) {
+                    master_table_indexes[idx] = lookups[idx].m_idx;
+                } else {
+                    master_table_indexes[idx] = create_row(pkey);
+                    new_pkeys.push_back(pkey);
+                    new_indexes.push_back(master_table_indexes[idx]);
+                }
 
                 // Write the op and pkey to `m_table`
                 m_opcol->set_nth<std::uint8_t>(master_table_indexes[idx], OP_INSERT);
@@ -216,6 +370,8 @@ t_gstate::update_master_table(const t_data_table* flattened) {
         }
     }
 
+    m_mapping.insert(new_pkeys, new_indexes);
+
     const t_schema& master_schema = m_table->get_schema();
     t_uindex ncols = master_table->num_columns();
 #ifdef PSP_PARALLEL_FOR
@@ -247,6 +403,418 @@ t_gstate::update_master_table(const t_data_table* flattened) {
 #endif
 }
 
+void
+t_gstate::set_implicit_pkeys() {
+    m_mapping.set_implicit();
+}
+
+bool
+t_gstate::is_append(const t_data_table* tbl) const {
+    if (!m_mapping.is_implicit() || tbl->num_rows() == 0)
+        return false;
+
+    const t_column* pkey_col = tbl->get_const_column("psp_pkey").get();
+    const t_column* op_col = tbl->get_const_column("psp_op").get();
+
+    if (pkey_col->get_dtype() != DTYPE_INT32)
+        return false;
+
+    // An implicit mapping has no free rows, so its size is the next row.
+    t_uindex offset = m_mapping.size();
+    const std::int32_t* pkey_base = pkey_col->get_nth<std::int32_t>(0);
+    const std::uint8_t* op_base = op_col->get_nth<std::uint8_t>(0);
+
+    for (t_uindex idx = 0, loop_end = tbl->num_rows(); idx < loop_end; ++idx) {
+        if (op_base[idx] != OP_INSERT || !pkey_col->is_valid(idx)
+            || pkey_base[idx] != static_cast<std::int32_t>(offset + idx)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void
+t_gstate::append_master_table(const t_data_table* tbl) {
+    PSP_VERBOSE_ASSERT(m_mapping.is_implicit(), "Cannot append to a table with explicit pkeys");
+    PSP_VERBOSE_ASSERT(num_rows() == m_mapping.size(), "Master table has free rows");
+
+    if (num_rows() == 0 && m_backing_store != BACKING_STORE_DISK
+        && tbl->get_schema() == m_table->get_schema()) {
+        // An empty master table takes the columns of `tbl` rather than
+        // copying them, as in `fill_master_table`.
+        const t_schema& schema = m_table->get_schema();
+        for (t_uindex idx = 0, loop_end = schema.size(); idx < loop_end; ++idx) {
+            std::shared_ptr<t_column> column = tbl->share_column(schema.m_columns[idx]);
+            column->detach_pool();
+            m_table->set_column(idx, column);
+        }
+
+        m_pkcol = m_table->get_column("psp_pkey");
+        m_opcol = m_table->get_column("psp_op");
+        m_mapping.set_pkey_column(m_pkcol);
+        pack_status();
+
+        m_table->set_capacity(tbl->get_capacity());
+        m_table->set_size(tbl->num_rows());
+    } else {
+        m_table->append(*tbl);
+    }
+
+    m_mapping.extend_implicit(tbl->num_rows());
+
+#ifdef PSP_TABLE_VERIFY
+    m_table->verify();
+#endif
+}
+
+bool
+t_gstate::is_ring_write(const t_data_table* tbl, t_uindex limit) const {
+    t_uindex nrows = tbl->num_rows();
+    if (!m_mapping.is_implicit() || nrows == 0 || nrows > limit)
+        return false;
+
+    const t_column* pkey_col = tbl->get_const_column("psp_pkey").get();
+    const t_column* op_col = tbl->get_const_column("psp_op").get();
+
+    if (pkey_col->get_dtype() != DTYPE_INT32)
+        return false;
+
+    const std::int32_t* pkey_base = pkey_col->get_nth<std::int32_t>(0);
+    const std::uint8_t* op_base = op_col->get_nth<std::uint8_t>(0);
+
+    // An implicit mapping has no free rows, so its size is the next slot.
+    t_uindex size = m_mapping.size();
+    if (pkey_base[0] < 0 || static_cast<t_uindex>(pkey_base[0]) > size)
+        return false;
+
+    t_uindex first = pkey_base[0];
+
+    std::vector<const t_column*> columns;
+    for (const std::string& colname : tbl->get_schema().m_columns) {
+        if (colname != "psp_pkey" && colname != "psp_op") {
+            columns.push_back(tbl->get_const_column(colname).get());
+        }
+    }
+
+    for (t_uindex idx = 0; idx < nrows; ++idx) {
+        t_uindex slot = (first + idx) % limit;
+        if (op_base[idx] != OP_INSERT || !pkey_col->is_valid(idx)
+            || pkey_base[idx] != static_cast<std::int32_t>(slot)) {
+            return false;
+        }
+
+        if (slot >= size)
+            continue;
+
+        // A cell that is neither set nor cleared keeps the value of the
+        // row it overwrites.
+        for (const t_column* column : columns) {
+            if (!column->is_valid(idx) && !column->is_cleared(idx))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+t_ring_step
+t_gstate::write_ring(std::shared_ptr<t_data_table> tbl, bool copy_evicted) {
+    PSP_VERBOSE_ASSERT(m_mapping.is_implicit(), "Cannot write a ring to a table with explicit pkeys");
+
+    t_uindex nrows = tbl->num_rows();
+    t_uindex size = num_rows();
+
+    const t_column* pkey_col = tbl->get_const_column("psp_pkey").get();
+    const t_column* op_col = tbl->get_const_column("psp_op").get();
+    const std::int32_t* pkey_base = pkey_col->get_nth<std::int32_t>(0);
+
+    t_ring_step step;
+    step.m_appended = tbl;
+    step.m_fresh_begin = nrows;
+    step.m_fresh_end = nrows;
+
+    // Slots past the end of the table are always contiguous, as slots only
+    // wrap around to the start once the table is full.
+    std::vector<t_uindex> slots(nrows);
+    std::vector<t_tscalar> new_pkeys;
+    std::vector<t_uindex> new_indexes;
+
+    for (t_uindex idx = 0; idx < nrows; ++idx) {
+        slots[idx] = pkey_base[idx];
+        if (slots[idx] < size)
+            continue;
+
+        if (new_pkeys.empty())
+            step.m_fresh_begin = idx;
+
+        step.m_fresh_end = idx + 1;
+        t_tscalar pkey = pkey_col->get_scalar(idx);
+        new_pkeys.push_back(pkey);
+        new_indexes.push_back(create_row(pkey));
+    }
+
+    m_mapping.insert(new_pkeys, new_indexes);
+
+    const t_schema& master_schema = m_table->get_schema();
+    t_data_table* master_table = m_table.get();
+
+    if (copy_evicted) {
+        // Copied for every row so that `m_evicted` is aligned with `tbl` -
+        // rows in the fresh range are never read.
+        step.m_evicted = std::make_shared<t_data_table>(master_schema, nrows);
+        step.m_evicted->init();
+        step.m_evicted->set_size(nrows);
+
+        t_data_table* evicted = step.m_evicted.get();
+        t_uindex ncols = master_schema.size();
+#ifdef PSP_PARALLEL_FOR
+        tbb::parallel_for(0, int(ncols), 1,
+            [&master_schema, master_table, evicted, &slots](int idx)
+#else
+        for (t_uindex idx = 0; idx < ncols; ++idx)
+#endif
+            {
+                const std::string& column_name = master_schema.m_columns[idx];
+                evicted->get_column(column_name)->copy(
+                    master_table->get_const_column(column_name).get(), slots, 0);
+            }
+#ifdef PSP_PARALLEL_FOR
+        );
+#endif
+    }
+
+    t_uindex ncols = master_table->num_columns();
+#ifdef PSP_PARALLEL_FOR
+    tbb::parallel_for(0, int(ncols), 1,
+        [&tbl, op_col, &master_schema, master_table, &slots, nrows, this](int idx)
+#else
+    for (t_uindex idx = 0; idx < ncols; ++idx)
+#endif
+        {
+            const std::string& column_name = master_schema.m_columns[idx];
+            auto column = tbl->get_const_column_safe(column_name);
+            if (column) {
+                update_master_column(master_table->get_column(column_name).get(),
+                    column.get(), op_col, slots, nrows);
+            }
+        }
+#ifdef PSP_PARALLEL_FOR
+    );
+#endif
+
+#ifdef PSP_TABLE_VERIFY
+    m_table->verify();
+#endif
+
+    return step;
+}
+
+void
+t_gstate::pack_status() {
+    for (auto column : m_table->get_columns()) {
+        column->set_status_packed(true);
+    }
+}
+
+t_uindex
+t_gstate::compact_vocabularies(bool force) {
+    const t_schema& schema = m_table->get_schema();
+    t_uindex reclaimed = 0;
+
+    for (t_uindex idx = 0, loop_end = schema.size(); idx < loop_end; ++idx) {
+        if (schema.m_types[idx] != DTYPE_STR)
+            continue;
+
+        const std::string& column_name = schema.m_columns[idx];
+        t_column* column = m_table->get_column(column_name).get();
+        t_uindex vlen_size = column->_get_vocab()->get_vlendata()->size();
+        t_uindex& compacted_size = m_vocab_compacted_size[column_name];
+
+        if (!force
+            && vlen_size < compacted_size
+                    + std::max(compacted_size, PSP_VOCAB_COMPACT_MIN_BYTES)) {
+            continue;
+        }
+
+        // String primary keys are indexed by their id in the vocabulary of
+        // the pkey column, so `m_mapping` must be renumbered with it.
+        if (column == m_pkcol.get()) {
+            std::vector<t_uindex> remap;
+            reclaimed += column->compact_vocabulary(remap);
+            if (!remap.empty()) {
+                m_mapping.remap_vocabulary(remap);
+            }
+        } else {
+            reclaimed += column->compact_vocabulary();
+        }
+
+        compacted_size = column->_get_vocab()->get_vlendata()->size();
+    }
+
+    return reclaimed;
+}
+
+void
+t_gstate::save_snapshot(t_snapshot_writer& writer) const {
+    const std::vector<std::string>& column_names = m_input_schema.m_columns;
+    writer.write<std::uint64_t>(num_rows());
+    writer.write<std::uint64_t>(column_names.size());
+
+    for (const std::string& column_name : column_names) {
+        writer.write(column_name);
+        m_table->get_const_column(column_name)->save(writer);
+    }
+
+    writer.write<std::uint8_t>(m_mapping.is_implicit());
+
+    std::vector<std::uint64_t> free_rows(m_free.begin(), m_free.end());
+    writer.write(free_rows.data(), free_rows.size() * sizeof(std::uint64_t));
+}
+
+void
+t_gstate::load_snapshot(t_snapshot_reader& reader) {
+    if (num_rows() != 0 || m_mapping.size() != 0) {
+        PSP_COMPLAIN_AND_ABORT("Snapshots can only be loaded into an empty table");
+    }
+
+    const std::vector<std::string>& column_names = m_input_schema.m_columns;
+    t_uindex nrows = reader.read<std::uint64_t>();
+    t_uindex ncols = reader.read<std::uint64_t>();
+
+    if (ncols != column_names.size()) {
+        PSP_COMPLAIN_AND_ABORT("Snapshot does not match the schema of the table");
+    }
+
+    m_table->reserve(nrows);
+
+    for (const std::string& column_name : column_names) {
+        if (reader.read_string() != column_name) {
+            PSP_COMPLAIN_AND_ABORT("Snapshot does not match the schema of the table");
+        }
+
+        m_table->get_column(column_name)->load(reader);
+    }
+
+    m_table->set_size(nrows);
+
+    bool implicit = reader.read<std::uint8_t>() != 0;
+    t_uindex free_nbytes;
+    const std::uint64_t* free_rows
+        = static_cast<const std::uint64_t*>(reader.read(free_nbytes));
+    t_uindex num_free = free_nbytes / sizeof(std::uint64_t);
+
+    m_free.clear();
+    m_free.reserve(num_free);
+    for (t_uindex idx = 0; idx < num_free; ++idx) {
+        m_free.insert(free_rows[idx]);
+    }
+
+    if (implicit && m_mapping.is_implicit()) {
+        m_mapping.extend_implicit(nrows);
+    } else {
+        std::vector<t_tscalar> pkeys;
+        std::vector<t_uindex> indexes;
+        pkeys.reserve(nrows - num_free);
+        indexes.reserve(nrows - num_free);
+
+        for (t_uindex idx = 0; idx < nrows; ++idx) {
+            if (m_free.count(idx) != 0)
+                continue;
+
+            pkeys.push_back(m_pkcol->get_scalar(idx));
+            indexes.push_back(idx);
+        }
+
+        m_mapping.reserve(pkeys.size());
+        m_mapping.insert(pkeys, indexes);
+    }
+
+#ifdef PSP_TABLE_VERIFY
+    m_table->verify();
+#endif
+}
+
+t_uindex
+t_gstate::compact_rows(bool force) {
+    t_uindex num_free = m_free.size();
+    t_uindex nrows = m_table->num_rows();
+
+    // An implicit mapping has no free rows.
+    if (num_free == 0 || m_mapping.is_implicit())
+        return 0;
+
+    if (!force
+        && (num_free < PSP_ROW_COMPACT_MIN_FREE_ROWS
+            || double(num_free) < PSP_ROW_COMPACT_MIN_FREE_RATIO * double(nrows))) {
+        return 0;
+    }
+
+    t_uindex num_live = nrows - num_free;
+
+    // Fill the free rows below `num_live` in ascending order with the live
+    // rows above it, so the live rows below `num_live` are never moved.
+    std::vector<t_uindex> dst;
+    for (t_uindex idx : m_free) {
+        if (idx < num_live)
+            dst.push_back(idx);
+    }
+
+    std::sort(dst.begin(), dst.end());
+
+    std::vector<t_uindex> src;
+    src.reserve(dst.size());
+    for (t_uindex idx = num_live; idx < nrows; ++idx) {
+        if (m_free.count(idx) == 0)
+            src.push_back(idx);
+    }
+
+    PSP_VERBOSE_ASSERT(src.size() == dst.size(), "Free rows do not match live rows");
+
+    auto columns = m_table->get_columns();
+    t_uindex ncols = columns.size();
+
+#ifdef PSP_PARALLEL_FOR
+    tbb::parallel_for(0, int(ncols), 1,
+        [&columns, &src, &dst, num_live, nrows](int idx)
+#else
+    for (t_uindex idx = 0; idx < ncols; ++idx)
+#endif
+        {
+            t_column* column = columns[idx];
+            column->copy_rows(src, dst);
+
+            // Vacated rows are cleared like erased rows, as `create_row`
+            // appends into them again.
+            for (t_uindex ridx = num_live; ridx < nrows; ++ridx) {
+                column->clear(ridx);
+            }
+        }
+#ifdef PSP_PARALLEL_FOR
+    );
+#endif
+
+    if (!src.empty()) {
+        std::vector<t_uindex> remap(nrows);
+        std::iota(remap.begin(), remap.end(), 0);
+        for (t_uindex idx = 0, loop_end = src.size(); idx < loop_end; ++idx) {
+            remap[src[idx]] = dst[idx];
+        }
+
+        m_mapping.remap_rows(remap);
+    }
+
+    m_free.clear();
+    m_table->set_size(num_live);
+    m_table->shrink(std::max(num_live, static_cast<t_uindex>(DEFAULT_EMPTY_CAPACITY)));
+
+#ifdef PSP_TABLE_VERIFY
+    m_table->verify();
+#endif
+
+    return num_free;
+}
+
 void
 t_gstate::update_master_column(
     t_column* master_column,
@@ -344,10 +912,10 @@ void
 t_gstate::pprint() const {
     std::vector<t_uindex> indices(m_mapping.size());
     t_uindex idx = 0;
-    for (t_mapping::const_iterator iter = m_mapping.begin(); iter != m_mapping.end(); ++iter) {
-        indices[idx] = iter->second;
+    m_mapping.for_each([&indices, &idx](const t_tscalar&, t_uindex ridx) {
+        indices[idx] = ridx;
         ++idx;
-    }
+    });
     m_table->pprint(indices);
 }
 
@@ -355,9 +923,9 @@ t_mask
 t_gstate::get_cpp_mask() const {
     t_uindex sz = m_table->size();
     t_mask msk(sz);
-    for (t_mapping::const_iterator iter = m_mapping.begin(); iter != m_mapping.end(); ++iter) {
-        msk.set(iter->second, true);
-    }
+    m_mapping.for_each([&msk](const t_tscalar&, t_uindex ridx) {
+        msk.set(ridx, true);
+    });
     return msk;
 }
 
@@ -375,9 +943,9 @@ t_tscalar
 t_gstate::read_by_pkey(const std::string& colname, t_tscalar& pkey) const {
     std::shared_ptr<const t_column> col = m_table->get_const_column(colname);
     const t_column* col_ = col.get();
-    t_mapping::const_iterator iter = m_mapping.find(pkey);
-    if (iter != m_mapping.end()) {
-        return col_->get_scalar(iter->second);
+    t_rlookup lk = m_mapping.find(pkey);
+    if (lk.m_exists) {
+        return col_->get_scalar(lk.m_idx);
     } else {
         PSP_COMPLAIN_AND_ABORT("Called without pkey");
     }
@@ -392,9 +960,9 @@ t_gstate::read_column(const std::string& colname, const std::vector<t_tscalar>&
     std::vector<t_tscalar> rval(num_rows);
 
     for (t_index idx = 0; idx < num_rows; ++idx) {
-        t_mapping::const_iterator iter = m_mapping.find(pkeys[idx]);
-        if (iter != m_mapping.end()) {
-            rval[idx].set(col_->get_scalar(iter->second));
+        t_rlookup lk = m_mapping.find(pkeys[idx]);
+        if (lk.m_exists) {
+            rval[idx].set(col_->get_scalar(lk.m_idx));
         }
     }
 
@@ -417,9 +985,9 @@ t_gstate::read_column(const std::string& colname, const std::vector<t_tscalar>&
     std::vector<double> rval;
     rval.reserve(num_rows);
     for (t_index idx = 0; idx < num_rows; ++idx) {
-        t_mapping::const_iterator iter = m_mapping.find(pkeys[idx]);
-        if (iter != m_mapping.end()) {
-            auto tscalar = col_->get_scalar(iter->second);
+        t_rlookup lk = m_mapping.find(pkeys[idx]);
+        if (lk.m_exists) {
+            auto tscalar = col_->get_scalar(lk.m_idx);
             if (include_nones || tscalar.is_valid()) {
                 rval.push_back(tscalar.to_double());
             }
@@ -477,10 +1045,10 @@ t_gstate::read_column(
 
 t_tscalar
 t_gstate::get(t_tscalar pkey, const std::string& colname) const {
-    t_mapping::const_iterator iter = m_mapping.find(pkey);
-    if (iter != m_mapping.end()) {
+    t_rlookup lk = m_mapping.find(pkey);
+    if (lk.m_exists) {
         std::shared_ptr<const t_column> col = m_table->get_const_column(colname);
-        return col->get_scalar(iter->second);
+        return col->get_scalar(lk.m_idx);
     }
 
     return t_tscalar();
@@ -491,10 +1059,10 @@ t_gstate::get_row(t_tscalar pkey) const {
     auto columns = m_table->get_const_columns();
     std::vector<t_tscalar> rval(columns.size());
 
-    t_mapping::const_iterator iter = m_mapping.find(pkey);
-    PSP_VERBOSE_ASSERT(iter != m_mapping.end(), "Reached end");
+    t_rlookup lk = m_mapping.find(pkey);
+    PSP_VERBOSE_ASSERT(lk.m_exists, "Reached end");
 
-    t_uindex ridx = iter->second;
+    t_uindex ridx = lk.m_idx;
     t_uindex idx = 0;
 
     for (auto c : columns) {
@@ -512,9 +1080,9 @@ t_gstate::is_unique(
     value = mknone();
 
     for (const auto& pkey : pkeys) {
-        t_mapping::const_iterator iter = m_mapping.find(pkey);
-        if (iter != m_mapping.end()) {
-            auto tmp = col_->get_scalar(iter->second);
+        t_rlookup lk = m_mapping.find(pkey);
+        if (lk.m_exists) {
+            auto tmp = col_->get_scalar(lk.m_idx);
             if (!value.is_none() && value != tmp)
                 return false;
             value = tmp;
@@ -533,9 +1101,9 @@ t_gstate::apply(const std::vector<t_tscalar>& pkeys, const std::string& colname,
     value = mknone();
 
     for (const auto& pkey : pkeys) {
-        t_mapping::const_iterator iter = m_mapping.find(pkey);
-        if (iter != m_mapping.end()) {
-            auto tmp = col_->get_scalar(iter->second);
+        t_rlookup lk = m_mapping.find(pkey);
+        if (lk.m_exists) {
+            auto tmp = col_->get_scalar(lk.m_idx);
             bool done = fn(tmp, value);
             if (done) {
                 value = tmp;
@@ -554,15 +1122,15 @@ t_gstate::get_output_schema() const {
 
 t_dtype
 t_gstate::get_pkey_dtype() const {
-    if (m_mapping.empty())
-        return DTYPE_STR;
-    auto iter = m_mapping.begin();
-    return iter->first.get_dtype();
+    return m_mapping.get_pkey_dtype();
 }
 
 std::shared_ptr<t_data_table>
 t_gstate::get_sorted_pkeyed_table() const {
-    std::map<t_tscalar, t_uindex> ordered(m_mapping.begin(), m_mapping.end());
+    std::map<t_tscalar, t_uindex> ordered;
+    m_mapping.for_each([&ordered](const t_tscalar& pkey, t_uindex ridx) {
+        ordered[pkey] = ridx;
+    });
     auto sch = m_input_schema.drop({"psp_op"});
     auto rv = std::make_shared<t_data_table>(sch, 0);
     rv->init();
@@ -685,19 +1253,19 @@ t_gstate::_get_pkeyed_table(const t_schema& schema, const t_mask& mask) const {
         }
 
         t_uindex oidx = 0;
-        for (const auto& kv : m_mapping) {
-            if (mask.get(kv.second)) {
-                order[oidx] = std::make_pair(kv.first, mapping[kv.second]);
+        m_mapping.for_each([&order, &oidx, &mask, &mapping](const t_tscalar& pkey, t_uindex ridx) {
+            if (mask.get(ridx)) {
+                order[oidx] = std::make_pair(pkey, mapping[ridx]);
                 ++oidx;
             }
-        }
+        });
     } else // enable_pkeyed_table_mask_fix
     {
         t_uindex oidx = 0;
-        for (const auto& kv : m_mapping) {
-            order[oidx] = kv;
+        m_mapping.for_each([&order, &oidx](const t_tscalar& pkey, t_uindex ridx) {
+            order[oidx] = std::make_pair(pkey, ridx);
             ++oidx;
-        }
+        });
     }
 
     std::sort(order.begin(), order.end(),
@@ -767,12 +1335,12 @@ t_gstate::get_row_data_pkeys(const std::vector<t_tscalar>& pkeys) const {
     auto none = mknone();
 
     for (const auto& pkey : pkeys) {
-        t_mapping::const_iterator iter = m_mapping.find(pkey);
-        if (iter == m_mapping.end())
+        t_rlookup lk = m_mapping.find(pkey);
+        if (!lk.m_exists)
             continue;
 
         for (t_uindex cidx = 0; cidx < ncols; ++cidx) {
-            auto v = columns[cidx]->get_scalar(iter->second);
+            auto v = columns[cidx]->get_scalar(lk.m_idx);
             if (v.is_valid()) {
                 rval.push_back(v);
             } else {
@@ -785,7 +1353,7 @@ t_gstate::get_row_data_pkeys(const std::vector<t_tscalar>& pkeys) const {
 
 bool
 t_gstate::has_pkey(t_tscalar pkey) const {
-    return m_mapping.find(pkey) != m_mapping.end();
+    return m_mapping.contains(pkey);
 }
 
 std::vector<t_tscalar>
@@ -798,7 +1366,7 @@ t_gstate::has_pkeys(const std::vector<t_tscalar>& pkeys) const {
 
     for (const auto& p : pkeys) {
         t_tscalar tval;
-        tval.set(m_mapping.find(p) != m_mapping.end());
+        tval.set(m_mapping.contains(p));
         rval[idx].set(tval);
         ++idx;
     }
@@ -810,10 +1378,10 @@ std::vector<t_tscalar>
 t_gstate::get_pkeys() const {
     std::vector<t_tscalar> rval(m_mapping.size());
     t_uindex idx = 0;
-    for (const auto& kv : m_mapping) {
-        rval[idx].set(kv.first);
+    m_mapping.for_each([&rval, &idx](const t_tscalar& pkey, t_uindex) {
+        rval[idx].set(pkey);
         ++idx;
-    }
+    });
     return rval;
 }
 
@@ -849,6 +1417,11 @@ t_gstate::reset() {
     m_table->reset();
     m_mapping.clear();
     m_free.clear();
+    m_pkcol = m_table->get_column("psp_pkey");
+    m_opcol = m_table->get_column("psp_op");
+    m_mapping.set_pkey_column(m_pkcol);
+    m_vocab_compacted_size.clear();
+    pack_status();
 }
 
 t_tscalar
@@ -857,9 +1430,9 @@ t_gstate::get_value(const t_tscalar& pkey, const std::string& colname) const {
     const t_column* col_ = col.get();
     t_tscalar rval = mknone();
 
-    auto iter = m_mapping.find(pkey);
-    if (iter != m_mapping.end()) {
-        rval.set(col_->get_scalar(iter->second));
+    t_rlookup lk = m_mapping.find(pkey);
+    if (lk.m_exists) {
+        rval.set(col_->get_scalar(lk.m_idx));
     }
 
     return rval;
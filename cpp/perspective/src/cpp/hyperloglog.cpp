@@ -0,0 +1,198 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2017, the Perspective Authors.
+ *
+ * This file is part of the Perspective library, distributed under the terms of
+ * the Apache License 2.0.  The full license can be found in the LICENSE file.
+ *
+ */
+
+#include <perspective/first.h>
+#include <perspective/hyperloglog.h>
+#include <algorithm>
+#include <cmath>
+
+namespace perspective {
+
+namespace {
+
+// The splitmix64 finalizer, which spreads the bits of `hash_value` - only
+// 32 bits wide under WASM - over all 64 bits the sketch reads.
+std::uint64_t
+mix_hash(std::uint64_t hash) {
+    hash ^= hash >> 30;
+    hash *= 0xbf58476d1ce4e5b9ULL;
+    hash ^= hash >> 27;
+    hash *= 0x94d049bb133111ebULL;
+    hash ^= hash >> 31;
+    return hash;
+}
+
+std::uint32_t
+sparse_index(std::uint32_t entry) {
+    return entry >> 8;
+}
+
+std::uint8_t
+sparse_rank(std::uint32_t entry) {
+    return entry & 0xff;
+}
+
+} // namespace
+
+t_hyperloglog::t_hyperloglog()
+    : t_hyperloglog(PSP_HLL_DEFAULT_PRECISION) {}
+
+t_hyperloglog::t_hyperloglog(std::uint8_t precision)
+    : m_precision(precision) {
+    PSP_VERBOSE_ASSERT(precision >= PSP_HLL_MIN_PRECISION && precision <= PSP_HLL_MAX_PRECISION,
+        "HyperLogLog precision out of range");
+}
+
+void
+t_hyperloglog::add(const t_tscalar& value) {
+    add_hash(mix_hash(hash_value(value)));
+}
+
+void
+t_hyperloglog::add_hash(std::uint64_t hash) {
+    std::uint32_t idx = static_cast<std::uint32_t>(hash >> (64 - m_precision));
+
+    // The rank is the position of the first set bit after the index bits,
+    // capped at the number of bits left.
+    std::uint64_t rest = hash << m_precision;
+    std::uint8_t max_rank = 64 - m_precision + 1;
+    std::uint8_t rank = 1;
+    while (rank < max_rank && !(rest & (std::uint64_t(1) << 63))) {
+        rest <<= 1;
+        ++rank;
+    }
+
+    set_register(idx, rank);
+}
+
+void
+t_hyperloglog::merge(const t_hyperloglog& other) {
+    PSP_VERBOSE_ASSERT(
+        m_precision == other.m_precision, "Cannot merge HyperLogLog of different precision");
+
+    if (!other.m_registers.empty()) {
+        densify();
+        for (t_uindex idx = 0, loop_end = m_registers.size(); idx < loop_end; ++idx) {
+            m_registers[idx] = std::max(m_registers[idx], other.m_registers[idx]);
+        }
+        return;
+    }
+
+    for (auto entry : other.m_sparse) {
+        set_register(sparse_index(entry), sparse_rank(entry));
+    }
+}
+
+void
+t_hyperloglog::clear() {
+    std::vector<std::uint32_t>().swap(m_sparse);
+    std::vector<std::uint8_t>().swap(m_registers);
+}
+
+std::uint64_t
+t_hyperloglog::estimate() const {
+    double m = num_registers();
+    double sum = 0;
+    t_uindex zeros = 0;
+
+    if (m_registers.empty()) {
+        zeros = num_registers() - m_sparse.size();
+        sum = zeros;
+        for (auto entry : m_sparse) {
+            sum += std::ldexp(1.0, -sparse_rank(entry));
+        }
+    } else {
+        for (auto rank : m_registers) {
+            if (rank == 0) {
+                ++zeros;
+            }
+            sum += std::ldexp(1.0, -rank);
+        }
+    }
+
+    double alpha;
+    switch (m_precision) {
+        case 4: {
+            alpha = 0.673;
+        } break;
+        case 5: {
+            alpha = 0.697;
+        } break;
+        case 6: {
+            alpha = 0.709;
+        } break;
+        default: { alpha = 0.7213 / (1 + 1.079 / m); } break;
+    }
+
+    double rval = alpha * m * m / sum;
+
+    // Linear counting is more accurate while many registers are unset.
+    if (rval <= 2.5 * m && zeros > 0) {
+        rval = m * std::log(m / zeros);
+    }
+
+    return static_cast<std::uint64_t>(std::llround(rval));
+}
+
+std::uint8_t
+t_hyperloglog::precision() const {
+    return m_precision;
+}
+
+t_memory_usage
+t_hyperloglog::get_memory_usage(const std::string& name) const {
+    t_memory_usage rval = get_vector_memory_usage(name, m_sparse);
+    rval += get_vector_memory_usage(name, m_registers);
+    return rval;
+}
+
+t_uindex
+t_hyperloglog::num_registers() const {
+    return t_uindex(1) << m_precision;
+}
+
+void
+t_hyperloglog::set_register(std::uint32_t idx, std::uint8_t rank) {
+    if (!m_registers.empty()) {
+        m_registers[idx] = std::max(m_registers[idx], rank);
+        return;
+    }
+
+    std::uint32_t entry = (idx << 8) | rank;
+    auto iter = std::lower_bound(m_sparse.begin(), m_sparse.end(), idx << 8);
+
+    if (iter != m_sparse.end() && sparse_index(*iter) == idx) {
+        *iter = std::max(*iter, entry);
+        return;
+    }
+
+    m_sparse.insert(iter, entry);
+
+    // Past an eighth of the registers, the sparse list is as large as half
+    // of the dense registers and slower to update.
+    if (m_sparse.size() > num_registers() / 8) {
+        densify();
+    }
+}
+
+void
+t_hyperloglog::densify() {
+    if (!m_registers.empty()) {
+        return;
+    }
+
+    m_registers.resize(num_registers(), 0);
+    for (auto entry : m_sparse) {
+        m_registers[sparse_index(entry)] = sparse_rank(entry);
+    }
+
+    std::vector<std::uint32_t>().swap(m_sparse);
+}
+
+} // end namespace perspective
@@ -0,0 +1,140 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2017, the Perspective Authors.
+ *
+ * This file is part of the Perspective library, distributed under the terms of
+ * the Apache License 2.0.  The full license can be found in the LICENSE file.
+ *
+ */
+
+#include <perspective/first.h>
+#include <perspective/lstore_pool.h>
+#include <cstdlib>
+#include <cstring>
+
+namespace perspective {
+
+t_lstore_pool_stats::t_lstore_pool_stats()
+    : m_bytes_reused(0)
+    , m_bytes_allocated(0)
+    , m_bytes_retained(0)
+    , m_num_resets(0) {}
+
+t_lstore_pool::t_lstore_pool() {
+    LOG_CONSTRUCTOR("t_lstore_pool");
+    t_uindex num_classes = 1;
+    for (t_uindex bytes = PSP_LSTORE_POOL_MIN_BYTES; bytes < PSP_LSTORE_POOL_MAX_BYTES;
+         bytes <<= 1) {
+        ++num_classes;
+    }
+
+    m_free.resize(num_classes);
+    m_allocated_since_reset.resize(num_classes, 0);
+}
+
+t_lstore_pool::~t_lstore_pool() {
+    LOG_DESTRUCTOR("t_lstore_pool");
+    for (auto& blocks : m_free) {
+        for (void* base : blocks) {
+            free(base);
+        }
+    }
+}
+
+t_uindex
+t_lstore_pool::size_class(t_uindex capacity) const {
+    t_uindex cls = 0;
+    t_uindex bytes = PSP_LSTORE_POOL_MIN_BYTES;
+    while (bytes < capacity && cls < m_free.size()) {
+        bytes <<= 1;
+        ++cls;
+    }
+    return cls;
+}
+
+void*
+t_lstore_pool::allocate(t_uindex& capacity) {
+    t_uindex cls = size_class(capacity);
+
+    // Too large to pool - allocate exactly what was asked for.
+    if (cls >= m_free.size()) {
+        void* base = calloc(size_t(capacity), 1);
+        PSP_VERBOSE_ASSERT(base, "MALLOC_FAILED");
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.m_bytes_allocated += capacity;
+        return base;
+    }
+
+    capacity = PSP_LSTORE_POOL_MIN_BYTES << cls;
+    void* base = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_allocated_since_reset[cls];
+        std::vector<void*>& blocks = m_free[cls];
+        if (!blocks.empty()) {
+            base = blocks.back();
+            blocks.pop_back();
+            m_stats.m_bytes_reused += capacity;
+            m_stats.m_bytes_retained -= capacity;
+        } else {
+            m_stats.m_bytes_allocated += capacity;
+        }
+    }
+
+    // Fresh blocks come zeroed from `calloc`, reused blocks are zeroed
+    // outside of the lock.
+    if (base == nullptr) {
+        base = calloc(size_t(capacity), 1);
+        PSP_VERBOSE_ASSERT(base, "MALLOC_FAILED");
+    } else {
+        memset(base, 0, size_t(capacity));
+    }
+
+    return base;
+}
+
+void
+t_lstore_pool::release(void* base, t_uindex capacity) {
+    if (base == nullptr)
+        return;
+
+    t_uindex cls = size_class(capacity);
+    if (cls >= m_free.size()) {
+        free(base);
+        return;
+    }
+
+    PSP_VERBOSE_ASSERT(capacity == (PSP_LSTORE_POOL_MIN_BYTES << cls),
+        "Releasing a block that was not allocated from this pool");
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_free[cls].push_back(base);
+    m_stats.m_bytes_retained += capacity;
+}
+
+void
+t_lstore_pool::reset() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (t_uindex cls = 0, loop_end = m_free.size(); cls < loop_end; ++cls) {
+        std::vector<void*>& blocks = m_free[cls];
+        t_uindex capacity = PSP_LSTORE_POOL_MIN_BYTES << cls;
+        while (blocks.size() > m_allocated_since_reset[cls]) {
+            free(blocks.back());
+            blocks.pop_back();
+            m_stats.m_bytes_retained -= capacity;
+        }
+
+        m_allocated_since_reset[cls] = 0;
+    }
+
+    ++m_stats.m_num_resets;
+}
+
+t_lstore_pool_stats
+t_lstore_pool::get_stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+} // end namespace perspective
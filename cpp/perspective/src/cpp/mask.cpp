@@ -28,6 +28,12 @@ t_mask::t_mask(const t_simple_bitmask& m) {
     }
 }
 
+t_mask::t_mask(const std::vector<t_block>& blocks, t_uindex size) {
+    LOG_CONSTRUCTOR("t_mask");
+    m_bitmap.append(blocks.begin(), blocks.end());
+    m_bitmap.resize(t_msize(size));
+}
+
 t_mask::~t_mask() { LOG_DESTRUCTOR("t_mask"); }
 
 void
@@ -0,0 +1,57 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2017, the Perspective Authors.
+ *
+ * This file is part of the Perspective library, distributed under the terms of
+ * the Apache License 2.0.  The full license can be found in the LICENSE file.
+ *
+ */
+
+#include <perspective/first.h>
+#include <perspective/memory_usage.h>
+
+namespace perspective {
+
+t_memory_usage::t_memory_usage()
+    : m_reserved(0)
+    , m_used(0) {}
+
+t_memory_usage::t_memory_usage(const std::string& name, t_uindex reserved, t_uindex used)
+    : m_name(name)
+    , m_reserved(reserved)
+    , m_used(used) {}
+
+t_memory_usage&
+t_memory_usage::operator+=(const t_memory_usage& other) {
+    m_reserved += other.m_reserved;
+    m_used += other.m_used;
+    return *this;
+}
+
+void
+append_memory_usage(
+    t_memory_report& report, const std::string& prefix, const t_memory_report& entries) {
+    report.reserve(report.size() + entries.size());
+    for (const t_memory_usage& entry : entries) {
+        report.emplace_back(prefix + "." + entry.m_name, entry.m_reserved, entry.m_used);
+    }
+}
+
+t_memory_usage
+get_memory_usage(const std::string& name, const t_lstore& store) {
+    // Stores that were never inited hold no memory.
+    if (!store.get_init()) {
+        return t_memory_usage(name, 0, 0);
+    }
+
+    return t_memory_usage(name, store.capacity(), store.size());
+}
+
+t_memory_usage
+get_node_memory_usage(
+    const std::string& name, t_uindex size, t_uindex value_size, t_uindex num_links) {
+    t_uindex nbytes = size * (value_size + num_links * sizeof(void*));
+    return t_memory_usage(name, nbytes, nbytes);
+}
+
+} // end namespace perspective
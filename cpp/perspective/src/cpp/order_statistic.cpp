@@ -0,0 +1,116 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2017, the Perspective Authors.
+ *
+ * This file is part of the Perspective library, distributed under the terms of
+ * the Apache License 2.0.  The full license can be found in the LICENSE file.
+ *
+ */
+
+#include <perspective/first.h>
+#include <perspective/order_statistic.h>
+#include <algorithm>
+
+namespace perspective {
+
+bool
+t_order_statistic_cmp::operator()(const t_tscalar& a, const t_tscalar& b) const {
+    bool a_nan = a.is_nan();
+    bool b_nan = b.is_nan();
+
+    if ((a_nan || b_nan) && a.m_type == b.m_type && a.m_status == b.m_status) {
+        return !a_nan && b_nan;
+    }
+
+    return a < b;
+}
+
+t_order_statistic::t_order_statistic()
+    : t_order_statistic(0.5) {}
+
+t_order_statistic::t_order_statistic(double quantile)
+    : m_quantile(quantile)
+    , m_size(0)
+    , m_below(0) {
+    m_cursor.clear();
+}
+
+void
+t_order_statistic::update(const t_tscalar& value, t_index count) {
+    if (count == 0) {
+        return;
+    }
+
+    if (m_size == 0) {
+        m_cursor = value;
+        m_below = 0;
+    }
+
+    if (count > 0) {
+        m_counts[value] += count;
+    } else {
+        // Removing a value that was never added leaves the rest intact.
+        auto iter = m_counts.find(value);
+        if (iter == m_counts.end()) {
+            return;
+        }
+
+        count = -static_cast<t_index>(std::min<t_uindex>(iter->second, -count));
+        iter->second += count;
+
+        if (iter->second == 0) {
+            m_counts.erase(iter);
+        }
+    }
+
+    m_size += count;
+
+    if (t_order_statistic_cmp()(value, m_cursor)) {
+        m_below += count;
+    }
+}
+
+t_tscalar
+t_order_statistic::get() {
+    if (m_size == 0) {
+        return mknone();
+    }
+
+    t_uindex target = std::min<t_uindex>(m_size - 1, m_quantile * m_size);
+
+    // `m_cursor` may have been removed, but the values below its lower
+    // bound are still the `m_below` values below it.
+    auto iter = m_counts.lower_bound(m_cursor);
+    t_uindex below = m_below;
+
+    if (iter == m_counts.end()) {
+        --iter;
+        below -= iter->second;
+    }
+
+    while (target < below) {
+        --iter;
+        below -= iter->second;
+    }
+
+    while (target >= below + iter->second) {
+        below += iter->second;
+        ++iter;
+    }
+
+    m_cursor = iter->first;
+    m_below = below;
+    return iter->first;
+}
+
+t_uindex
+t_order_statistic::size() const {
+    return m_size;
+}
+
+t_uindex
+t_order_statistic::num_distinct() const {
+    return m_counts.size();
+}
+
+} // end namespace perspective
@@ -0,0 +1,485 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2017, the Perspective Authors.
+ *
+ * This file is part of the Perspective library, distributed under the terms of
+ * the Apache License 2.0.  The full license can be found in the LICENSE file.
+ *
+ */
+
+#include <perspective/first.h>
+#include <perspective/pkey_map.h>
+#ifdef PSP_PARALLEL_FOR
+#include <tbb/tbb.h>
+#endif
+
+namespace perspective {
+
+namespace {
+
+t_uindex
+shard_bits_for(t_uindex num_shards) {
+    t_uindex bits = 0;
+    while ((static_cast<t_uindex>(1) << bits) < num_shards) {
+        ++bits;
+    }
+    return bits;
+}
+
+} // namespace
+
+t_pkey_map::t_pkey_map()
+    : t_pkey_map(DTYPE_NONE) {}
+
+t_pkey_map::t_pkey_map(t_dtype pkey_dtype, t_uindex num_shards)
+    : m_shards(static_cast<t_uindex>(1) << shard_bits_for(std::max(num_shards, t_uindex(1))))
+    , m_shard_bits(shard_bits_for(std::max(num_shards, t_uindex(1))))
+    , m_dtype(pkey_dtype)
+    , m_allow_implicit(false)
+    , m_implicit(false)
+    , m_implicit_size(0) {
+    switch (pkey_dtype) {
+        case DTYPE_INT64:
+        case DTYPE_INT32:
+        case DTYPE_INT16:
+        case DTYPE_INT8:
+        case DTYPE_UINT64:
+        case DTYPE_UINT32:
+        case DTYPE_UINT16:
+        case DTYPE_UINT8:
+        case DTYPE_FLOAT64:
+        case DTYPE_FLOAT32:
+        case DTYPE_DATE:
+        case DTYPE_TIME: {
+            m_keytype = KEYTYPE_RAW;
+        } break;
+        case DTYPE_STR: {
+            m_keytype = KEYTYPE_STR;
+        } break;
+        default: { m_keytype = KEYTYPE_SCALAR; } break;
+    }
+}
+
+t_pkey_map::t_keytype
+t_pkey_map::get_keytype(const t_tscalar& pkey) const {
+    if (m_keytype == KEYTYPE_SCALAR || pkey.get_dtype() != m_dtype || !pkey.is_valid()
+        || (m_keytype == KEYTYPE_STR && !m_pkey_column)) {
+        return KEYTYPE_SCALAR;
+    }
+
+    return m_keytype;
+}
+
+bool
+t_pkey_map::find_str_id(const t_tscalar& pkey, t_uindex& id) const {
+    return m_pkey_column->_get_vocab()->string_exists(pkey.get_char_ptr(), id);
+}
+
+void
+t_pkey_map::set_pkey_column(std::shared_ptr<t_column> column) {
+    PSP_VERBOSE_ASSERT(empty() || !m_pkey_column
+            || column->_get_vocab()->get_vlenidx()
+                == m_pkey_column->_get_vocab()->get_vlenidx(),
+        "Cannot set the pkey column of a non-empty map to a different vocabulary");
+
+    if (m_keytype == KEYTYPE_STR) {
+        PSP_VERBOSE_ASSERT(column->get_dtype() == DTYPE_STR, "Expected a string pkey column");
+        m_pkey_column = column;
+    }
+}
+
+void
+t_pkey_map::remap_vocabulary(const std::vector<t_uindex>& remap) {
+    t_uindex num_shards = m_shards.size();
+
+#ifdef PSP_PARALLEL_FOR
+    tbb::parallel_for(0, int(num_shards), 1,
+        [&remap, this](int shard_idx)
+#else
+    for (t_uindex shard_idx = 0; shard_idx < num_shards; ++shard_idx)
+#endif
+        {
+            t_str_mapping& str_mapping = m_shards[shard_idx].m_str_mapping;
+            t_str_mapping remapped;
+            remapped.reserve(str_mapping.size());
+
+            for (const auto& kv : str_mapping) {
+                remapped[remap[kv.first]] = kv.second;
+            }
+
+            str_mapping.swap(remapped);
+        }
+#ifdef PSP_PARALLEL_FOR
+    );
+#endif
+}
+
+void
+t_pkey_map::remap_rows(const std::vector<t_uindex>& remap) {
+    PSP_VERBOSE_ASSERT(!m_implicit, "Cannot remap the rows of an implicit map");
+    t_uindex num_shards = m_shards.size();
+
+#ifdef PSP_PARALLEL_FOR
+    tbb::parallel_for(0, int(num_shards), 1,
+        [&remap, this](int shard_idx)
+#else
+    for (t_uindex shard_idx = 0; shard_idx < num_shards; ++shard_idx)
+#endif
+        {
+            t_shard& shard = m_shards[shard_idx];
+
+            for (auto iter = shard.m_raw_mapping.begin(); iter != shard.m_raw_mapping.end();
+                 ++iter) {
+                iter.value() = remap[iter->second];
+            }
+
+            for (auto iter = shard.m_str_mapping.begin(); iter != shard.m_str_mapping.end();
+                 ++iter) {
+                iter.value() = remap[iter->second];
+            }
+
+            for (auto iter = shard.m_mapping.begin(); iter != shard.m_mapping.end(); ++iter) {
+                iter.value() = remap[iter->second];
+            }
+        }
+#ifdef PSP_PARALLEL_FOR
+    );
+#endif
+}
+
+bool
+t_pkey_map::is_implicit_key(const t_tscalar& pkey) const {
+    if (get_keytype(pkey) != KEYTYPE_RAW)
+        return false;
+
+    std::int32_t key = pkey.get<std::int32_t>();
+    return key >= 0 && static_cast<t_uindex>(key) < m_implicit_size;
+}
+
+t_tscalar
+t_pkey_map::mk_raw_pkey(std::uint64_t key) const {
+    t_tscalar rval;
+    rval.m_type = m_dtype;
+    rval.m_status = STATUS_VALID;
+    rval.m_inplace = false;
+    rval.m_data.m_uint64 = key;
+    return rval;
+}
+
+t_uindex
+t_pkey_map::get_shard_idx(const t_tscalar& pkey) const {
+    if (m_shard_bits == 0) {
+        return 0;
+    }
+
+    std::uint64_t hash;
+    switch (get_keytype(pkey)) {
+        case KEYTYPE_RAW: {
+            hash = pkey.m_data.m_uint64;
+        } break;
+        case KEYTYPE_STR: {
+            hash = t_cchar_umap_hash()(pkey.get_char_ptr());
+        } break;
+        default: { hash = std::hash<t_tscalar>()(pkey); } break;
+    }
+
+    // Fibonacci hashing spreads the bits of the hash before taking the
+    // top `m_shard_bits` bits.
+    hash *= 0x9E3779B97F4A7C15ULL;
+    return static_cast<t_uindex>(hash >> (64 - m_shard_bits));
+}
+
+t_uindex
+t_pkey_map::num_shards() const {
+    return m_shards.size();
+}
+
+t_dtype
+t_pkey_map::get_pkey_dtype() const {
+    if (m_implicit)
+        return m_implicit_size > 0 ? m_dtype : DTYPE_STR;
+
+    for (const auto& shard : m_shards) {
+        if (!shard.m_raw_mapping.empty() || !shard.m_str_mapping.empty())
+            return m_dtype;
+    }
+
+    for (const auto& shard : m_shards) {
+        if (!shard.m_mapping.empty())
+            return shard.m_mapping.begin()->first.get_dtype();
+    }
+
+    return DTYPE_STR;
+}
+
+t_rlookup
+t_pkey_map::find(const t_tscalar& pkey) const {
+    t_rlookup rval(0, false);
+
+    if (m_implicit) {
+        if (is_implicit_key(pkey)) {
+            rval.m_idx = pkey.get<std::int32_t>();
+            rval.m_exists = true;
+        }
+        return rval;
+    }
+
+    const t_shard& shard = m_shards[get_shard_idx(pkey)];
+
+    switch (get_keytype(pkey)) {
+        case KEYTYPE_RAW: {
+            auto iter = shard.m_raw_mapping.find(pkey.m_data.m_uint64);
+            if (iter == shard.m_raw_mapping.end())
+                return rval;
+            rval.m_idx = iter->second;
+        } break;
+        case KEYTYPE_STR: {
+            t_uindex id;
+            if (!find_str_id(pkey, id))
+                return rval;
+            auto iter = shard.m_str_mapping.find(id);
+            if (iter == shard.m_str_mapping.end())
+                return rval;
+            rval.m_idx = iter->second;
+        } break;
+        default: {
+            auto iter = shard.m_mapping.find(pkey);
+            if (iter == shard.m_mapping.end())
+                return rval;
+            rval.m_idx = iter->second;
+        } break;
+    }
+
+    rval.m_exists = true;
+    return rval;
+}
+
+bool
+t_pkey_map::contains(const t_tscalar& pkey) const {
+    return find(pkey).m_exists;
+}
+
+void
+t_pkey_map::insert(const t_tscalar& pkey, t_uindex idx) {
+    if (m_implicit) {
+        if (get_keytype(pkey) == KEYTYPE_RAW && idx == m_implicit_size
+            && pkey.get<std::int32_t>() == static_cast<std::int32_t>(idx)) {
+            ++m_implicit_size;
+            return;
+        }
+        materialize();
+    }
+
+    t_uindex id = 0;
+    if (get_keytype(pkey) == KEYTYPE_STR) {
+        id = m_pkey_column->get_interned(pkey.get_char_ptr());
+    }
+
+    insert(get_shard_idx(pkey), pkey, id, idx);
+}
+
+void
+t_pkey_map::insert(const std::vector<t_tscalar>& pkeys, const std::vector<t_uindex>& idxs) {
+    PSP_VERBOSE_ASSERT(pkeys.size() == idxs.size(), "Mismatched pkeys and indices");
+    t_uindex num_keys = pkeys.size();
+
+    if (m_implicit) {
+        bool extends = true;
+        for (t_uindex idx = 0; idx < num_keys && extends; ++idx) {
+            t_uindex expected = m_implicit_size + idx;
+            extends = idxs[idx] == expected && get_keytype(pkeys[idx]) == KEYTYPE_RAW
+                && pkeys[idx].get<std::int32_t>() == static_cast<std::int32_t>(expected);
+        }
+
+        if (extends) {
+            m_implicit_size += num_keys;
+            return;
+        }
+
+        materialize();
+    }
+
+    // Interning writes to the vocabulary of the pkey column, which is
+    // shared by every shard, so string keys are interned up front.
+    std::vector<std::vector<t_uindex>> shard_keys(m_shards.size());
+    std::vector<t_uindex> ids(m_keytype == KEYTYPE_STR ? num_keys : 0);
+    for (t_uindex idx = 0; idx < num_keys; ++idx) {
+        if (get_keytype(pkeys[idx]) == KEYTYPE_STR) {
+            ids[idx] = m_pkey_column->get_interned(pkeys[idx].get_char_ptr());
+        }
+        shard_keys[get_shard_idx(pkeys[idx])].push_back(idx);
+    }
+
+    t_uindex num_shards = m_shards.size();
+
+#ifdef PSP_PARALLEL_FOR
+    tbb::parallel_for(0, int(num_shards), 1,
+        [&pkeys, &idxs, &ids, &shard_keys, this](int shard_idx)
+#else
+    for (t_uindex shard_idx = 0; shard_idx < num_shards; ++shard_idx)
+#endif
+        {
+            for (t_uindex idx : shard_keys[shard_idx]) {
+                t_uindex id = ids.empty() ? 0 : ids[idx];
+                insert(shard_idx, pkeys[idx], id, idxs[idx]);
+            }
+        }
+#ifdef PSP_PARALLEL_FOR
+    );
+#endif
+}
+
+void
+t_pkey_map::insert(t_uindex shard_idx, const t_tscalar& pkey, t_uindex id, t_uindex idx) {
+    PSP_VERBOSE_ASSERT(shard_idx == get_shard_idx(pkey), "pkey inserted into wrong shard");
+    t_shard& shard = m_shards[shard_idx];
+
+    switch (get_keytype(pkey)) {
+        case KEYTYPE_RAW: {
+            shard.m_raw_mapping[pkey.m_data.m_uint64] = idx;
+        } break;
+        case KEYTYPE_STR: {
+            shard.m_str_mapping[id] = idx;
+        } break;
+        default: {
+            shard.m_mapping[shard.m_symtable.get_interned_tscalar(pkey)] = idx;
+        } break;
+    }
+}
+
+bool
+t_pkey_map::erase(const t_tscalar& pkey, t_uindex& idx) {
+    if (m_implicit) {
+        if (!is_implicit_key(pkey))
+            return false;
+        materialize();
+    }
+
+    t_shard& shard = m_shards[get_shard_idx(pkey)];
+
+    switch (get_keytype(pkey)) {
+        case KEYTYPE_RAW: {
+            auto iter = shard.m_raw_mapping.find(pkey.m_data.m_uint64);
+            if (iter == shard.m_raw_mapping.end())
+                return false;
+            idx = iter->second;
+            shard.m_raw_mapping.erase(iter);
+        } break;
+        case KEYTYPE_STR: {
+            t_uindex id;
+            if (!find_str_id(pkey, id))
+                return false;
+            auto iter = shard.m_str_mapping.find(id);
+            if (iter == shard.m_str_mapping.end())
+                return false;
+            idx = iter->second;
+            shard.m_str_mapping.erase(iter);
+        } break;
+        default: {
+            auto iter = shard.m_mapping.find(pkey);
+            if (iter == shard.m_mapping.end())
+                return false;
+            idx = iter->second;
+            shard.m_mapping.erase(iter);
+        } break;
+    }
+
+    return true;
+}
+
+void
+t_pkey_map::reserve(t_uindex size) {
+    if (m_implicit)
+        return;
+
+    t_uindex per_shard = size / m_shards.size() + 1;
+    for (auto& shard : m_shards) {
+        switch (m_keytype) {
+            case KEYTYPE_RAW: {
+                shard.m_raw_mapping.reserve(per_shard);
+            } break;
+            case KEYTYPE_STR: {
+                shard.m_str_mapping.reserve(per_shard);
+            } break;
+            default: { shard.m_mapping.reserve(per_shard); } break;
+        }
+    }
+}
+
+t_uindex
+t_pkey_map::size() const {
+    t_uindex rval = m_implicit_size;
+    for (const auto& shard : m_shards) {
+        rval += shard.m_raw_mapping.size() + shard.m_str_mapping.size()
+            + shard.m_mapping.size();
+    }
+    return rval;
+}
+
+t_memory_usage
+t_pkey_map::get_memory_usage(const std::string& name) const {
+    t_memory_usage rval(name, 0, 0);
+    for (const auto& shard : m_shards) {
+        rval += get_hash_memory_usage(name, shard.m_raw_mapping);
+        rval += get_hash_memory_usage(name, shard.m_str_mapping);
+        rval += get_hash_memory_usage(name, shard.m_mapping);
+    }
+    return rval;
+}
+
+bool
+t_pkey_map::empty() const {
+    return size() == 0;
+}
+
+void
+t_pkey_map::clear() {
+    for (auto& shard : m_shards) {
+        shard.m_raw_mapping.clear();
+        shard.m_str_mapping.clear();
+        shard.m_mapping.clear();
+    }
+
+    m_implicit = m_allow_implicit;
+    m_implicit_size = 0;
+}
+
+void
+t_pkey_map::set_implicit() {
+    PSP_VERBOSE_ASSERT(empty(), "Cannot set a non-empty map to implicit mode");
+
+    if (m_dtype == DTYPE_INT32) {
+        m_allow_implicit = true;
+        m_implicit = true;
+    }
+}
+
+bool
+t_pkey_map::is_implicit() const {
+    return m_implicit;
+}
+
+void
+t_pkey_map::extend_implicit(t_uindex count) {
+    PSP_VERBOSE_ASSERT(m_implicit, "Cannot extend a map that is not implicit");
+    m_implicit_size += count;
+}
+
+void
+t_pkey_map::materialize() {
+    t_uindex num_keys = m_implicit_size;
+    std::vector<t_tscalar> pkeys(num_keys);
+    std::vector<t_uindex> idxs(num_keys);
+
+    for (t_uindex idx = 0; idx < num_keys; ++idx) {
+        pkeys[idx] = mk_raw_pkey(idx);
+        idxs[idx] = idx;
+    }
+
+    m_implicit = false;
+    m_implicit_size = 0;
+    reserve(num_keys);
+    insert(pkeys, idxs);
+}
+
+} // end namespace perspective
@@ -26,6 +26,19 @@ t_updctx::t_updctx(t_uindex gnode_id, const std::string& ctx)
     : m_gnode_id(gnode_id)
     , m_ctx(ctx) {}
 
+t_batch_state::t_batch_state()
+    : m_max_rows(0)
+    , m_max_latency_ms(0)
+    , m_pending_rows(0)
+    , m_pending_updates(0)
+    , m_num_batches(0)
+    , m_num_rows_coalesced(0) {}
+
+bool
+t_batch_state::is_batching() const {
+    return m_max_rows > 0 || m_max_latency_ms > 0;
+}
+
 #if defined PSP_ENABLE_WASM
 
 t_val
@@ -108,6 +121,10 @@ t_pool::unregister_gnode(t_uindex idx) {
     }
 
     m_gnodes[idx] = 0;
+    m_batches.erase(idx);
+#if defined PSP_ENABLE_WASM || defined PSP_ENABLE_PYTHON
+    m_gnode_update_delegates.erase(idx);
+#endif
 }
 
 void
@@ -120,6 +137,14 @@ t_pool::send(t_uindex gnode_id, t_uindex port_id, const t_data_table& table) {
             m_gnodes[gnode_id]->send(port_id, table);
         }
 
+        t_batch_state& batch = m_batches[gnode_id];
+        if (batch.m_pending_updates == 0) {
+            batch.m_pending_since = std::chrono::steady_clock::now();
+        }
+
+        batch.m_pending_rows += table.size();
+        ++batch.m_pending_updates;
+
         if (t_env::log_progress()) {
             std::cout << "t_pool.send gnode_id => " << gnode_id << " port_id => " << port_id
                       << " tbl_size => " << table.size() << std::endl;
@@ -171,6 +196,103 @@ t_pool::set_sleep(t_uindex ms) {
     }
 }
 
+void
+t_pool::set_batching(t_uindex gnode_id, t_uindex max_rows, t_uindex max_latency_ms) {
+    std::lock_guard<std::mutex> lg(m_mtx);
+    t_batch_state& batch = m_batches[gnode_id];
+    batch.m_max_rows = max_rows;
+    batch.m_max_latency_ms = max_latency_ms;
+    if (t_env::log_progress()) {
+        std::cout << "t_pool.set_batching gnode_id => " << gnode_id
+                  << " max_rows => " << max_rows
+                  << " max_latency_ms => " << max_latency_ms << std::endl;
+    }
+}
+
+bool
+t_pool::is_batching(t_uindex gnode_id) {
+    std::lock_guard<std::mutex> lg(m_mtx);
+    return m_batches[gnode_id].is_batching();
+}
+
+bool
+t_pool::is_batch_ready(t_uindex gnode_id) {
+    std::lock_guard<std::mutex> lg(m_mtx);
+    const t_batch_state& batch = m_batches[gnode_id];
+
+    if (!batch.is_batching() || batch.m_pending_updates == 0)
+        return false;
+
+    if (batch.m_max_rows > 0 && batch.m_pending_rows >= batch.m_max_rows)
+        return true;
+
+    if (batch.m_max_latency_ms == 0)
+        return false;
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - batch.m_pending_since);
+    return static_cast<t_uindex>(elapsed.count()) >= batch.m_max_latency_ms;
+}
+
+t_uindex
+t_pool::get_batch_wait_ms(t_uindex gnode_id) {
+    std::lock_guard<std::mutex> lg(m_mtx);
+    const t_batch_state& batch = m_batches[gnode_id];
+
+    if (batch.m_max_latency_ms == 0 || batch.m_pending_updates == 0)
+        return 0;
+
+    if (batch.m_max_rows > 0 && batch.m_pending_rows >= batch.m_max_rows)
+        return 0;
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - batch.m_pending_since);
+    t_uindex elapsed_ms = static_cast<t_uindex>(elapsed.count());
+
+    if (elapsed_ms >= batch.m_max_latency_ms)
+        return 0;
+
+    return batch.m_max_latency_ms - elapsed_ms;
+}
+
+t_uindex
+t_pool::get_num_batches(t_uindex gnode_id) {
+    std::lock_guard<std::mutex> lg(m_mtx);
+    return m_batches[gnode_id].m_num_batches;
+}
+
+t_uindex
+t_pool::get_num_rows_coalesced(t_uindex gnode_id) {
+    std::lock_guard<std::mutex> lg(m_mtx);
+    return m_batches[gnode_id].m_num_rows_coalesced;
+}
+
+void
+t_pool::_begin_batch() {
+    std::lock_guard<std::mutex> lg(m_mtx);
+
+    for (auto& iter : m_batches) {
+        t_batch_state& batch = iter.second;
+        if (batch.m_pending_updates == 0)
+            continue;
+
+        ++batch.m_num_batches;
+
+        if (batch.m_pending_updates > 1) {
+            batch.m_num_rows_coalesced += batch.m_pending_rows;
+        }
+
+        if (t_env::log_progress()) {
+            std::cout << "t_pool.batch gnode_id => " << iter.first
+                      << " updates => " << batch.m_pending_updates
+                      << " rows => " << batch.m_pending_rows << std::endl;
+        }
+
+        batch.m_pending_rows = 0;
+        batch.m_pending_updates = 0;
+    }
+}
+
 std::vector<t_stree*>
 t_pool::get_trees() {
     std::vector<t_stree*> rval;
@@ -215,15 +337,30 @@ void
 t_pool::set_update_delegate(t_val ud) {
     m_update_delegate = ud;
 }
+
+void
+t_pool::set_gnode_update_delegate(t_uindex gnode_id, t_val ud) {
+    std::lock_guard<std::mutex> lg(m_mtx);
+    m_gnode_update_delegates[gnode_id] = ud;
+}
 #endif
 
 void
-t_pool::notify_userspace(t_uindex port_id) {
+t_pool::notify_userspace(t_uindex gnode_id, t_uindex port_id) {
+    #if defined PSP_ENABLE_WASM || defined PSP_ENABLE_PYTHON
+        auto iter = m_gnode_update_delegates.find(gnode_id);
+        t_val& delegate = iter != m_gnode_update_delegates.end() ? iter->second
+                                                                 : m_update_delegate;
+    #else
+        (void)gnode_id;
+        (void)port_id;
+    #endif
+
     #if defined PSP_ENABLE_WASM
-        m_update_delegate.call<void>("_update_callback", port_id);
+        delegate.call<void>("_update_callback", port_id);
     #elif PSP_ENABLE_PYTHON
-        if (!m_update_delegate.is_none()) {
-            m_update_delegate.attr("_update_callback")(port_id);
+        if (!delegate.is_none()) {
+            delegate.attr("_update_callback")(port_id);
         }
     #endif
 }
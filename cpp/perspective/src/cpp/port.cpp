@@ -27,6 +27,7 @@ t_port::init() {
     m_table = nullptr;
     m_table = std::make_shared<t_data_table>(
         "", "", m_schema, DEFAULT_EMPTY_CAPACITY, BACKING_STORE_MEMORY);
+    m_table->set_lstore_pool(m_lstore_pool);
     m_table->init();
     m_init = true;
 }
@@ -44,12 +45,16 @@ t_port::set_table(std::shared_ptr<t_data_table> table) {
 
 void
 t_port::send(std::shared_ptr<const t_data_table> table) {
-    m_table->append(*table.get());
+    send(*table.get());
 }
 
 void
 t_port::send(const t_data_table& table) {
-    m_table->append(table);
+    // The first fragment sent after the port is cleared is shared rather
+    // than copied - senders do not write to a table once it is sent.
+    if (!m_table->share_columns(table)) {
+        m_table->append(table);
+    }
 }
 
 t_schema
@@ -69,6 +74,7 @@ t_port::release()
     m_table = nullptr;
     m_table = std::make_shared<t_data_table>(
         "", "", m_schema, DEFAULT_EMPTY_CAPACITY, BACKING_STORE_MEMORY);
+    m_table->set_lstore_pool(m_lstore_pool);
     m_table->init();
 
     m_prevsize = size;
@@ -100,4 +106,9 @@ t_port::clear() {
     m_table->clear();
 }
 
+void
+t_port::set_lstore_pool(std::shared_ptr<t_lstore_pool> pool) {
+    m_lstore_pool = pool;
+}
+
 } // end namespace perspective
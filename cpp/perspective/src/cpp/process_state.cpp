@@ -11,7 +11,9 @@
 
 namespace perspective {
 
-t_process_state::t_process_state() {};
+t_process_state::t_process_state()
+    : m_op_base(nullptr)
+    , m_materialize_transitions(true) {};
 
 void
 t_process_state::clear_transitional_data_tables() {
@@ -24,20 +26,28 @@ t_process_state::clear_transitional_data_tables() {
 
 void
 t_process_state::reserve_transitional_data_tables(t_uindex size) {
+    m_existed_data_table->reserve(size);
+
+    if (!m_materialize_transitions)
+        return;
+
     m_delta_data_table->reserve(size);
     m_prev_data_table->reserve(size);
     m_current_data_table->reserve(size);
     m_transitions_data_table->reserve(size);
-    m_existed_data_table->reserve(size);
 };
 
 void
 t_process_state::set_size_transitional_data_tables(t_uindex size) {
+    m_existed_data_table->set_size(size);
+
+    if (!m_materialize_transitions)
+        return;
+
     m_delta_data_table->set_size(size);
     m_prev_data_table->set_size(size);
     m_current_data_table->set_size(size);
     m_transitions_data_table->set_size(size);
-    m_existed_data_table->set_size(size);
 };
 
 } // end namespace persective
\ No newline at end of file
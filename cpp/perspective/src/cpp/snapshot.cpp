@@ -0,0 +1,138 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2017, the Perspective Authors.
+ *
+ * This file is part of the Perspective library, distributed under the terms of
+ * the Apache License 2.0.  The full license can be found in the LICENSE file.
+ *
+ */
+
+#include <perspective/first.h>
+#include <perspective/snapshot.h>
+#include <cstring>
+#include <sstream>
+
+namespace perspective {
+
+namespace {
+    const t_uindex SNAPSHOT_ALIGNMENT = 8;
+    const char SNAPSHOT_PADDING[SNAPSHOT_ALIGNMENT] = {0};
+} // namespace
+
+t_snapshot_writer::t_snapshot_writer(const std::string& fname)
+    : m_fname(fname)
+    , m_buffer(PSP_SNAPSHOT_BUFFER_SIZE)
+    , m_offset(0) {
+    m_out.rdbuf()->pubsetbuf(m_buffer.data(), m_buffer.size());
+    m_out.open(fname, std::ios::out | std::ios::binary | std::ios::trunc);
+
+    if (!m_out) {
+        std::stringstream ss;
+        ss << "Could not open snapshot `" << fname << "` for writing";
+        PSP_COMPLAIN_AND_ABORT(ss.str());
+    }
+}
+
+t_snapshot_writer::~t_snapshot_writer() {
+    if (m_out.is_open()) {
+        m_out.close();
+    }
+}
+
+void
+t_snapshot_writer::write_raw(const void* ptr, t_uindex len) {
+    m_out.write(static_cast<const char*>(ptr), std::streamsize(len));
+    m_offset += len;
+}
+
+void
+t_snapshot_writer::pad() {
+    t_uindex rem = m_offset % SNAPSHOT_ALIGNMENT;
+    if (rem != 0) {
+        write_raw(SNAPSHOT_PADDING, SNAPSHOT_ALIGNMENT - rem);
+    }
+}
+
+void
+t_snapshot_writer::write(const std::string& value) {
+    write(value.data(), value.size());
+}
+
+void
+t_snapshot_writer::write(const void* ptr, t_uindex len) {
+    write<std::uint64_t>(len);
+    pad();
+    if (len > 0) {
+        write_raw(ptr, len);
+    }
+}
+
+void
+t_snapshot_writer::write(const t_lstore& store) {
+    write(store.get_ptr(0), store.size());
+}
+
+void
+t_snapshot_writer::close() {
+    m_out.flush();
+    bool failed = !m_out;
+    m_out.close();
+
+    if (failed) {
+        std::stringstream ss;
+        ss << "Failed writing snapshot `" << m_fname << "`";
+        PSP_COMPLAIN_AND_ABORT(ss.str());
+    }
+}
+
+t_snapshot_reader::t_snapshot_reader(const std::string& fname)
+    : m_offset(0) {
+    map_file_read(fname, m_mapping);
+}
+
+const char*
+t_snapshot_reader::read_raw(t_uindex len) {
+    if (len > m_mapping.m_size || m_offset > m_mapping.m_size - len) {
+        PSP_COMPLAIN_AND_ABORT("Snapshot is truncated or corrupt");
+    }
+
+    const char* ptr = static_cast<const char*>(m_mapping.m_base) + m_offset;
+    m_offset += len;
+    return ptr;
+}
+
+void
+t_snapshot_reader::skip_pad() {
+    t_uindex rem = m_offset % SNAPSHOT_ALIGNMENT;
+    if (rem != 0) {
+        read_raw(SNAPSHOT_ALIGNMENT - rem);
+    }
+}
+
+std::string
+t_snapshot_reader::read_string() {
+    t_uindex len;
+    const char* ptr = static_cast<const char*>(read(len));
+    return std::string(ptr, len);
+}
+
+const void*
+t_snapshot_reader::read(t_uindex& len) {
+    len = read<std::uint64_t>();
+    skip_pad();
+    return read_raw(len);
+}
+
+void
+t_snapshot_reader::read(t_lstore& store) {
+    t_uindex len;
+    const void* ptr = read(len);
+    store.set_size(0);
+    store.reserve(len);
+    if (len > 0) {
+        memcpy(store.get_ptr(0), ptr, size_t(len));
+    }
+    store.set_size(len);
+}
+
+} // end namespace perspective
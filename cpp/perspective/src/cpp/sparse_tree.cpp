@@ -143,31 +143,32 @@ t_stree::init() {
 
 t_tscalar
 t_stree::get_value(t_index idx) const {
-    iter_by_idx iter = m_nodes->get<by_idx>().find(idx);
-    PSP_VERBOSE_ASSERT(iter != m_nodes->get<by_idx>().end(), "Reached end iterator");
-    return iter->m_value;
+    const t_tnode* node = m_nodes->find(idx);
+    PSP_VERBOSE_ASSERT(node != nullptr, "Reached end iterator");
+    return node->m_value;
 }
 
 t_tscalar
 t_stree::get_sortby_value(t_index idx) const {
-    iter_by_idx iter = m_nodes->get<by_idx>().find(idx);
-    PSP_VERBOSE_ASSERT(iter != m_nodes->get<by_idx>().end(), "Reached end iterator");
-    return iter->m_sort_value;
+    const t_tnode* node = m_nodes->find(idx);
+    PSP_VERBOSE_ASSERT(node != nullptr, "Reached end iterator");
+    return node->m_sort_value;
 }
 
 void
 t_stree::build_strand_table_phase_1(t_tscalar pkey, t_op op, t_uindex idx, t_uindex npivots,
-    t_uindex strand_count_idx, t_uindex aggcolsize, bool force_current_row,
+    t_uindex nvalues, t_uindex strand_count_idx, t_uindex aggcolsize, bool force_current_row,
     const std::vector<const t_column*>& piv_ccols,
     const std::vector<const t_column*>& piv_tcols,
     const std::vector<const t_column*>& agg_ccols,
     const std::vector<const t_column*>& agg_dcols, std::vector<t_column*>& piv_scols,
     std::vector<t_column*>& agg_acols, t_column* agg_scount, t_column* spkey,
-    t_uindex& insert_count, bool& pivots_neq,
+    t_column* svalues, t_uindex& insert_count, bool& pivots_neq,
     const std::vector<std::string>& pivot_like) const {
     pivots_neq = false;
     std::set<std::string> pivmap;
     bool all_eq_tt = true;
+    bool values_eq_tt = true;
 
     for (t_uindex pidx = 0, ploop_end = pivot_like.size(); pidx < ploop_end; ++pidx) {
         const std::string& colname = pivot_like.at(pidx);
@@ -181,9 +182,15 @@ t_stree::build_strand_table_phase_1(t_tscalar pkey, t_op op, t_uindex idx, t_uin
         if (trans != VALUE_TRANSITION_EQ_TT)
             all_eq_tt = false;
 
-        if (pidx < npivots) {
+        // A changed tracked value is backed out of its node like a changed
+        // pivot, so the tree can remove the previous value.
+        if (pidx < npivots + nvalues) {
             pivots_neq = pivots_neq || pivots_changed(trans);
         }
+
+        if (pidx >= npivots && pidx < npivots + nvalues && trans != VALUE_TRANSITION_EQ_TT) {
+            values_eq_tt = false;
+        }
     }
 
     for (t_uindex aggidx = 0; aggidx < aggcolsize; ++aggidx) {
@@ -211,6 +218,18 @@ t_stree::build_strand_table_phase_1(t_tscalar pkey, t_op op, t_uindex idx, t_uin
     agg_scount->push_back<std::int8_t>(cval);
     spkey->push_back(pkey);
 
+    if (svalues) {
+        // Rows that already existed and kept their path and values are
+        // already counted by their node's tracked values.
+        std::int8_t vval;
+        if (op == OP_DELETE) {
+            vval = -1;
+        } else {
+            vval = pivots_neq || force_current_row || !values_eq_tt ? 1 : 0;
+        }
+        svalues->push_back<std::int8_t>(vval);
+    }
+
     ++insert_count;
 }
 
@@ -220,7 +239,8 @@ t_stree::build_strand_table_phase_2(t_tscalar pkey, t_uindex idx, t_uindex npivo
     const std::vector<const t_column*>& piv_pcols,
     const std::vector<const t_column*>& agg_pcols, std::vector<t_column*>& piv_scols,
     std::vector<t_column*>& agg_acols, t_column* agg_scount, t_column* spkey,
-    t_uindex& insert_count, const std::vector<std::string>& pivot_like) const {
+    t_column* svalues, t_uindex& insert_count,
+    const std::vector<std::string>& pivot_like) const {
     std::set<std::string> pivmap;
     for (t_uindex pidx = 0, ploop_end = pivot_like.size(); pidx < ploop_end; ++pidx) {
         const std::string& colname = pivot_like.at(pidx);
@@ -239,6 +259,11 @@ t_stree::build_strand_table_phase_2(t_tscalar pkey, t_uindex idx, t_uindex npivo
 
     agg_scount->push_back<std::int8_t>(std::int8_t(-1));
     spkey->push_back(pkey);
+
+    if (svalues) {
+        svalues->push_back<std::int8_t>(std::int8_t(-1));
+    }
+
     ++insert_count;
 }
 
@@ -270,6 +295,21 @@ t_stree::build_strand_table_common(const t_data_table& flattened,
 
     rv.m_pivsize = sschema_colset.size();
 
+    for (const auto& aggspec : aggspecs) {
+        if (!aggspec.tracks_values()) {
+            continue;
+        }
+
+        const std::string& depname = aggspec.get_first_depname();
+        if (sschema_colset.find(depname) == sschema_colset.end()) {
+            rv.m_pivot_like_columns.push_back(depname);
+            rv.m_strand_schema.add_column(depname, rv.m_flattened_schema.get_dtype(depname));
+            sschema_colset.insert(depname);
+        }
+    }
+
+    rv.m_nvalues = sschema_colset.size() - rv.m_pivsize;
+
     std::set<std::string> aggcolset;
     for (const auto& aggspec : aggspecs) {
         for (const auto& dep : aggspec.get_dependencies()) {
@@ -292,6 +332,10 @@ t_stree::build_strand_table_common(const t_data_table& flattened,
     rv.m_strand_schema.add_column(
         "psp_pkey", flattened.get_const_column("psp_pkey")->get_dtype());
 
+    if (rv.m_nvalues > 0) {
+        rv.m_strand_schema.add_column("psp_value_count", DTYPE_INT8);
+    }
+
     for (const auto& aggcol : aggcolset) {
         rv.m_aggschema.add_column(aggcol, rv.m_flattened_schema.get_dtype(aggcol));
     }
@@ -367,6 +411,9 @@ t_stree::build_strand_table(const t_data_table& flattened, const t_data_table& d
 
     t_column* spkey = strands->get_column("psp_pkey").get();
 
+    t_column* svalues
+        = rv.m_nvalues > 0 ? strands->get_column("psp_value_count").get() : nullptr;
+
     t_mask msk_prev, msk_curr;
 
     if (config.has_filters()) {
@@ -391,21 +438,21 @@ t_stree::build_strand_table(const t_data_table& flattened, const t_data_table& d
                 continue;
             } else if (!filter_prev && filter_curr) {
                 // apply current row
-                build_strand_table_phase_1(pkey, op, idx, rv.m_pivsize, strand_count_idx,
-                    aggcolsize, true, piv_ccols, piv_tcols, agg_ccols, agg_dcols, piv_scols,
-                    agg_acols, agg_scount, spkey, insert_count, pivots_neq,
-                    rv.m_pivot_like_columns);
+                build_strand_table_phase_1(pkey, op, idx, rv.m_pivsize, rv.m_nvalues,
+                    strand_count_idx, aggcolsize, true, piv_ccols, piv_tcols, agg_ccols,
+                    agg_dcols, piv_scols, agg_acols, agg_scount, spkey, svalues, insert_count,
+                    pivots_neq, rv.m_pivot_like_columns);
             } else if (filter_prev && !filter_curr) {
                 // reverse prev row
                 build_strand_table_phase_2(pkey, idx, rv.m_pivsize, strand_count_idx,
                     aggcolsize, piv_pcols, agg_pcols, piv_scols, agg_acols, agg_scount, spkey,
-                    insert_count, rv.m_pivot_like_columns);
+                    svalues, insert_count, rv.m_pivot_like_columns);
             } else if (filter_prev && filter_curr) {
                 // should be handled as normal
-                build_strand_table_phase_1(pkey, op, idx, rv.m_pivsize, strand_count_idx,
-                    aggcolsize, false, piv_ccols, piv_tcols, agg_ccols, agg_dcols, piv_scols,
-                    agg_acols, agg_scount, spkey, insert_count, pivots_neq,
-                    rv.m_pivot_like_columns);
+                build_strand_table_phase_1(pkey, op, idx, rv.m_pivsize, rv.m_nvalues,
+                    strand_count_idx, aggcolsize, false, piv_ccols, piv_tcols, agg_ccols,
+                    agg_dcols, piv_scols, agg_acols, agg_scount, spkey, svalues, insert_count,
+                    pivots_neq, rv.m_pivot_like_columns);
 
                 if (op == OP_DELETE || !pivots_neq) {
                     continue;
@@ -413,7 +460,7 @@ t_stree::build_strand_table(const t_data_table& flattened, const t_data_table& d
 
                 build_strand_table_phase_2(pkey, idx, rv.m_pivsize, strand_count_idx,
                     aggcolsize, piv_pcols, agg_pcols, piv_scols, agg_acols, agg_scount, spkey,
-                    insert_count, rv.m_pivot_like_columns);
+                    svalues, insert_count, rv.m_pivot_like_columns);
             }
         }
     } else {
@@ -424,18 +471,18 @@ t_stree::build_strand_table(const t_data_table& flattened, const t_data_table& d
             t_op op = static_cast<t_op>(op_);
             bool pivots_neq;
 
-            build_strand_table_phase_1(pkey, op, idx, rv.m_pivsize, strand_count_idx,
-                aggcolsize, false, piv_ccols, piv_tcols, agg_ccols, agg_dcols, piv_scols,
-                agg_acols, agg_scount, spkey, insert_count, pivots_neq,
-                rv.m_pivot_like_columns);
+            build_strand_table_phase_1(pkey, op, idx, rv.m_pivsize, rv.m_nvalues,
+                strand_count_idx, aggcolsize, false, piv_ccols, piv_tcols, agg_ccols,
+                agg_dcols, piv_scols, agg_acols, agg_scount, spkey, svalues, insert_count,
+                pivots_neq, rv.m_pivot_like_columns);
 
             if (op == OP_DELETE || !pivots_neq) {
                 continue;
             }
 
             build_strand_table_phase_2(pkey, idx, rv.m_pivsize, strand_count_idx, aggcolsize,
-                piv_pcols, agg_pcols, piv_scols, agg_acols, agg_scount, spkey, insert_count,
-                rv.m_pivot_like_columns);
+                piv_pcols, agg_pcols, piv_scols, agg_acols, agg_scount, spkey, svalues,
+                insert_count, rv.m_pivot_like_columns);
         }
     }
 
@@ -444,6 +491,11 @@ t_stree::build_strand_table(const t_data_table& flattened, const t_data_table& d
     aggs->reserve(insert_count);
     aggs->set_size(insert_count);
     agg_scount->valid_raw_fill();
+
+    if (svalues) {
+        svalues->valid_raw_fill();
+    }
+
     return std::pair<std::shared_ptr<t_data_table>, std::shared_ptr<t_data_table>>(
         strands, aggs);
 }
@@ -504,6 +556,9 @@ t_stree::build_strand_table(const t_data_table& flattened,
 
     t_column* spkey = strands->get_column("psp_pkey").get();
 
+    t_column* svalues
+        = rv.m_nvalues > 0 ? strands->get_column("psp_value_count").get() : nullptr;
+
     t_mask msk;
 
     if (config.has_filters()) {
@@ -536,6 +591,11 @@ t_stree::build_strand_table(const t_data_table& flattened,
 
         agg_scount->push_back<std::int8_t>(1);
         spkey->push_back(pkey);
+
+        if (svalues) {
+            svalues->push_back<std::int8_t>(1);
+        }
+
         ++insert_count;
     }
 
@@ -544,6 +604,132 @@ t_stree::build_strand_table(const t_data_table& flattened,
     aggs->reserve(insert_count);
     aggs->set_size(insert_count);
     agg_scount->valid_raw_fill();
+
+    if (svalues) {
+        svalues->valid_raw_fill();
+    }
+
+    return std::pair<std::shared_ptr<t_data_table>, std::shared_ptr<t_data_table>>(
+        strands, aggs);
+}
+
+std::pair<std::shared_ptr<t_data_table>, std::shared_ptr<t_data_table>>
+t_stree::build_strand_table(const t_ring_step& step, const std::vector<t_aggspec>& aggspecs,
+    const t_config& config) const {
+    PSP_TRACE_SENTINEL();
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+
+    const t_data_table& appended = *(step.m_appended);
+    const t_data_table& evicted = *(step.m_evicted);
+
+    auto rv = build_strand_table_common(appended, aggspecs, config);
+
+    // strand table
+    std::shared_ptr<t_data_table> strands = std::make_shared<t_data_table>(rv.m_strand_schema);
+    strands->init();
+
+    // strand table
+    std::shared_ptr<t_data_table> aggs = std::make_shared<t_data_table>(rv.m_aggschema);
+    aggs->init();
+
+    std::shared_ptr<const t_column> pkey_col = appended.get_const_column("psp_pkey");
+
+    t_uindex npivotlike = rv.m_npivotlike;
+    std::vector<const t_column*> piv_pcols(npivotlike);
+    std::vector<const t_column*> piv_ccols(npivotlike);
+    std::vector<t_column*> piv_scols(npivotlike);
+
+    t_uindex insert_count = 0;
+
+    for (t_uindex pidx = 0; pidx < npivotlike; ++pidx) {
+        const std::string& piv = rv.m_strand_schema.m_columns[pidx];
+        piv_pcols[pidx] = evicted.get_const_column(piv).get();
+        piv_ccols[pidx] = appended.get_const_column(piv).get();
+        piv_scols[pidx] = strands->get_column(piv).get();
+    }
+
+    t_uindex aggcolsize = rv.m_aggschema.m_columns.size();
+    std::vector<const t_column*> agg_pcols(aggcolsize);
+    std::vector<const t_column*> agg_ccols(aggcolsize);
+    std::vector<t_column*> agg_acols(aggcolsize);
+
+    t_uindex strand_count_idx = 0;
+
+    for (t_uindex aggidx = 0; aggidx < aggcolsize; ++aggidx) {
+        const std::string& aggcol = rv.m_aggschema.m_columns[aggidx];
+        if (aggcol == "psp_strand_count") {
+            agg_pcols[aggidx] = 0;
+            agg_ccols[aggidx] = 0;
+            strand_count_idx = aggidx;
+        } else {
+            agg_pcols[aggidx] = evicted.get_const_column(aggcol).get();
+            agg_ccols[aggidx] = appended.get_const_column(aggcol).get();
+        }
+
+        agg_acols[aggidx] = aggs->get_column(aggcol).get();
+    }
+
+    t_column* agg_scount = aggs->get_column("psp_strand_count").get();
+
+    t_column* spkey = strands->get_column("psp_pkey").get();
+
+    t_column* svalues
+        = rv.m_nvalues > 0 ? strands->get_column("psp_value_count").get() : nullptr;
+
+    t_mask msk_prev, msk_curr;
+
+    bool has_filters = config.has_filters();
+
+    if (has_filters) {
+        msk_prev = filter_table_for_config(evicted, config);
+        msk_curr = filter_table_for_config(appended, config);
+    }
+
+    for (t_uindex idx = 0, loop_end = appended.size(); idx < loop_end; ++idx) {
+        t_tscalar pkey = pkey_col->get_scalar(idx);
+
+        // Even if the row in this slot did not change path, backing it out
+        // and adding it again leaves its leaf with the same strand count,
+        // and the sum of both strands is the delta of each aggregate.
+        if (step.is_evicted(idx) && (!has_filters || msk_prev.get(idx))) {
+            build_strand_table_phase_2(pkey, idx, rv.m_pivsize, strand_count_idx,
+                aggcolsize, piv_pcols, agg_pcols, piv_scols, agg_acols, agg_scount, spkey,
+                svalues, insert_count, rv.m_pivot_like_columns);
+        }
+
+        if (!has_filters || msk_curr.get(idx)) {
+            for (t_uindex pidx = 0, ploop_end = rv.m_pivot_like_columns.size();
+                 pidx < ploop_end; ++pidx) {
+                piv_scols[pidx]->push_back(piv_ccols[pidx]->get_scalar(idx));
+            }
+
+            for (t_uindex aggidx = 0; aggidx < aggcolsize; ++aggidx) {
+                if (aggidx != strand_count_idx) {
+                    agg_acols[aggidx]->push_back(agg_ccols[aggidx]->get_scalar(idx));
+                }
+            }
+
+            agg_scount->push_back<std::int8_t>(1);
+            spkey->push_back(pkey);
+
+            if (svalues) {
+                svalues->push_back<std::int8_t>(1);
+            }
+
+            ++insert_count;
+        }
+    }
+
+    strands->reserve(insert_count);
+    strands->set_size(insert_count);
+    aggs->reserve(insert_count);
+    aggs->set_size(insert_count);
+    agg_scount->valid_raw_fill();
+
+    if (svalues) {
+        svalues->valid_raw_fill();
+    }
+
     return std::pair<std::shared_ptr<t_data_table>, std::shared_ptr<t_data_table>>(
         strands, aggs);
 }
@@ -600,11 +786,8 @@ t_stree::update_shape_from_static(const t_dtree_ctx& ctx) {
     t_filter filter;
 
     // update root
-    auto root_iter = m_nodes->get<by_idx>().find(0);
-    auto root_node = *root_iter;
-    t_index root_nstrands = *(scount->get_nth<t_index>(0)) + root_node.m_nstrands;
-    root_node.set_nstrands(std::max(root_nstrands, (t_index)1));
-    m_nodes->get<by_idx>().replace(root_iter, root_node);
+    t_index root_nstrands = *(scount->get_nth<t_index>(0)) + m_nodes->find(0)->m_nstrands;
+    m_nodes->set_nstrands(0, std::max(root_nstrands, (t_index)1));
 
     t_tree_unify_rec unif_rec(0, 0, 0, root_nstrands);
     m_tree_unification_records.push_back(unif_rec);
@@ -630,15 +813,15 @@ t_stree::update_shape_from_static(const t_dtree_ctx& ctx) {
 
         t_uindex src_ridx = dptidx;
 
-        auto iter = m_nodes->get<by_pidx_hash>().find(std::make_tuple(p_sptidx, value));
+        t_uindex existing = m_nodes->find_child(p_sptidx, value);
 
         auto nstrands = *(scount->get_nth<std::int64_t>(dptidx));
 
-        if (iter == m_nodes->get<by_pidx_hash>().end() && nstrands < 0) {
+        if (existing == t_treenodes::NO_CHILD && nstrands < 0) {
             continue;
         }
 
-        if (iter == m_nodes->get<by_pidx_hash>().end()) {
+        if (existing == t_treenodes::NO_CHILD) {
             // create node and enqueue
             sptidx = genidx();
             t_uindex aggsize = m_aggregates->size();
@@ -658,32 +841,28 @@ t_stree::update_shape_from_static(const t_dtree_ctx& ctx) {
                 m_newleaves.insert(sptidx);
             }
 
-            auto insert_pair = m_nodes->insert(node);
-            if (!insert_pair.second) {
-                auto failed_because = *(insert_pair.first);
-                std::cout << "failed because of " << failed_because << std::endl;
+            bool inserted = m_nodes->insert(node);
+            if (!inserted) {
+                std::cout << "failed because of " << node << std::endl;
             }
-            PSP_VERBOSE_ASSERT(insert_pair.second, "Failed to insert node");
+            PSP_VERBOSE_ASSERT(inserted, "Failed to insert node");
             t_tree_unify_rec unif_rec(sptidx, src_ridx, dst_ridx, nstrands);
             m_tree_unification_records.push_back(unif_rec);
         } else {
-            sptidx = iter->m_idx;
+            sptidx = existing;
 
             // update node
-            t_tnode node = *iter;
-            node.set_sort_value(sortby_value);
+            const t_tnode* node = m_nodes->find(sptidx);
 
-            t_uindex dst_ridx = node.m_aggidx;
+            t_uindex dst_ridx = node->m_aggidx;
 
-            nstrands = node.m_nstrands + nstrands;
+            nstrands = node->m_nstrands + nstrands;
 
             t_tree_unify_rec unif_rec(sptidx, src_ridx, dst_ridx, nstrands);
             m_tree_unification_records.push_back(unif_rec);
 
-            sptidx = iter->m_idx;
-            node.set_nstrands(nstrands);
-            PSP_VERBOSE_ASSERT(m_nodes->get<by_pidx_hash>().replace(iter, node), ,
-                "Failed to replace"); // middle argument ignored
+            m_nodes->set_sort_value(sptidx, sortby_value);
+            m_nodes->set_nstrands(sptidx, nstrands);
         }
 
         populate_pkey_idx(ctx, dtree, dptidx, sptidx, ndepth, new_idx_pkey);
@@ -712,10 +891,7 @@ t_stree::mark_zero_desc() {
     }
 
     for (auto n : z_desc) {
-        auto iter = m_nodes->get<by_idx>().find(n);
-        auto node = *iter;
-        node.set_nstrands(0);
-        m_nodes->get<by_idx>().replace(iter, node);
+        m_nodes->set_nstrands(n, 0);
     }
 }
 
@@ -724,6 +900,7 @@ t_stree::update_aggs_from_static(const t_dtree_ctx& ctx, const t_gstate& gstate)
     const t_data_table& src_aggtable = ctx.get_aggtable();
 
     t_agg_update_info agg_update_info;
+    agg_update_info.m_ctx = &ctx;
     t_schema aggschema = m_aggregates->get_schema();
 
     for (auto colname : aggschema.m_columns) {
@@ -788,6 +965,10 @@ t_stree::update_aggs_from_static(const t_dtree_ctx& ctx, const t_gstate& gstate)
         update_agg_table(
             r.m_sptidx, agg_update_info, r.m_daggidx, r.m_saggidx, r.m_nstrands, gstate);
     }
+
+    if (!m_stale_sketches.empty()) {
+        rebuild_stale_sketches(agg_update_info, gstate);
+    }
 }
 
 t_uindex
@@ -797,15 +978,13 @@ t_stree::genidx() {
 
 std::vector<t_uindex>
 t_stree::get_children(t_uindex idx) const {
-    t_by_pidx_ipair iterators = m_nodes->get<by_pidx>().equal_range(idx);
+    const std::vector<t_uindex>& slots = m_nodes->get_child_slots(idx);
 
-    t_uindex nchild = std::distance(iterators.first, iterators.second);
-
-    std::vector<t_uindex> temp(nchild);
+    std::vector<t_uindex> temp(slots.size());
 
     t_index count = 0;
-    for (iter_by_pidx iter = iterators.first; iter != iterators.second; ++iter) {
-        temp[count] = iter->m_idx;
+    for (auto slot : slots) {
+        temp[count] = m_nodes->get_slot(slot).m_idx;
         ++count;
     }
     return temp;
@@ -816,19 +995,64 @@ t_stree::size() const {
     return m_nodes->size();
 }
 
+t_memory_report
+t_stree::get_memory_usage() const {
+    t_memory_report rval;
+    rval.push_back(m_nodes->get_memory_usage("nodes"));
+    rval.push_back(get_node_memory_usage(
+        "pkey_index", m_idxpkey->size(), sizeof(t_stpkey), PSP_ORDERED_INDEX_LINKS));
+    rval.push_back(get_node_memory_usage(
+        "leaf_index", m_idxleaf->size(), sizeof(t_stleaves), PSP_ORDERED_INDEX_LINKS));
+    append_memory_usage(rval, "aggregates", m_aggregates->get_memory_usage());
+    rval.push_back(get_vector_memory_usage("agg_freelist", m_agg_freelist));
+
+    t_uindex order_stat_values = 0;
+    for (const auto& stat : m_order_stats) {
+        order_stat_values += stat.second.num_distinct();
+    }
+
+    t_memory_usage order_stats = get_hash_memory_usage("order_statistics", m_order_stats);
+    order_stats += get_node_memory_usage("order_statistics", order_stat_values,
+        sizeof(std::pair<const t_tscalar, t_uindex>), PSP_ORDERED_INDEX_LINKS);
+    rval.push_back(order_stats);
+
+    t_memory_usage value_counts = get_hash_memory_usage("value_counts", m_value_counts);
+    for (const auto& counts : m_value_counts) {
+        value_counts += counts.second.get_memory_usage("value_counts");
+    }
+
+    rval.push_back(value_counts);
+
+    t_memory_usage sketches = get_hash_memory_usage("sketches", m_sketches);
+    for (const auto& sketch : m_sketches) {
+        sketches += sketch.second.get_memory_usage("sketches");
+    }
+
+    rval.push_back(sketches);
+
+    t_memory_usage digests = get_hash_memory_usage("digests", m_digests);
+    for (const auto& digest : m_digests) {
+        digests += digest.second.get_memory_usage("digests");
+    }
+
+    rval.push_back(digests);
+    return rval;
+}
+
 void
 t_stree::get_child_nodes(t_uindex idx, t_tnodevec& nodes) const {
-    t_index num_children = get_num_children(idx);
-    t_tnodevec temp(num_children);
-    auto iterators = m_nodes->get<by_pidx>().equal_range(idx);
-    std::copy(iterators.first, iterators.second, temp.begin());
+    const std::vector<t_uindex>& slots = m_nodes->get_child_slots(idx);
+    t_tnodevec temp;
+    temp.reserve(slots.size());
+    for (auto slot : slots) {
+        temp.push_back(m_nodes->get_slot(slot));
+    }
     std::swap(nodes, temp);
 }
 
 t_uindex
 t_stree::get_num_children(t_uindex ptidx) const {
-    auto iterators = m_nodes->get<by_pidx>().equal_range(ptidx);
-    return std::distance(iterators.first, iterators.second);
+    return m_nodes->get_num_children(ptidx);
 }
 
 t_uindex
@@ -850,6 +1074,66 @@ t_stree::gen_aggidx() {
     return rval;
 }
 
+namespace {
+
+// The value of `digest` at `quantile`, or none if it has no values.
+t_tscalar
+get_digest_quantile(t_tdigest& digest, double quantile) {
+    double value = digest.quantile(quantile);
+    if (std::isnan(value)) {
+        return mknone();
+    }
+
+    return mktscalar(value);
+}
+
+// Clear `sketch` and add `values` to it, or merge in the sketches of the
+// aggregate rows `child_aggidxs` of aggregate column `idx` of `sketches`.
+template <typename SKETCH_T>
+void
+rebuild_sketch(SKETCH_T& sketch,
+    const tsl::hopscotch_map<std::pair<t_uindex, t_uindex>, SKETCH_T>& sketches,
+    t_uindex idx, const std::vector<t_tscalar>& values,
+    const std::vector<t_uindex>& child_aggidxs) {
+    sketch.clear();
+
+    for (const auto& value : values) {
+        sketch.add(value);
+    }
+
+    for (auto child_aggidx : child_aggidxs) {
+        auto iter = sketches.find(std::make_pair(idx, child_aggidx));
+        if (iter != sketches.end()) {
+            sketch.merge(iter->second);
+        }
+    }
+}
+
+} // namespace
+
+template <typename FUNCTION_T>
+void
+t_stree::for_each_strand_value(const t_agg_update_info& info, t_uindex src_ridx,
+    const std::string& depname, FUNCTION_T fn) {
+    // Only the strands under this node are applied, so the work done is
+    // proportional to the update rather than to the node.
+    auto strands = info.m_ctx->get_strands();
+    auto vcol = strands->get_const_column(depname);
+    auto ccol = strands->get_const_column("psp_value_count");
+    auto liters = info.m_ctx->get_leaf_iterators(src_ridx);
+
+    for (auto lfiter = liters.first; lfiter != liters.second; ++lfiter) {
+        auto lfidx = *lfiter;
+        std::int8_t count = *(ccol->get_nth<std::int8_t>(lfidx));
+
+        if (count == 0) {
+            continue;
+        }
+
+        fn(m_symtable.get_interned_tscalar(vcol->get_scalar(lfidx)), count);
+    }
+}
+
 void
 t_stree::update_agg_table(t_uindex nidx, t_agg_update_info& info, t_uindex src_ridx,
     t_uindex dst_ridx, t_index nstrands, const t_gstate& gstate) {
@@ -944,11 +1228,16 @@ t_stree::update_agg_table(t_uindex nidx, t_agg_update_info& info, t_uindex src_r
                 new_value.set(nr / dr);
             } break;
             case AGGTYPE_UNIQUE: {
-                auto pkeys = get_pkeys(nidx);
                 old_value.set(dst->get_scalar(dst_ridx));
 
-                bool is_unique
-                    = gstate.is_unique(pkeys, spec.get_dependencies()[0].name(), new_value);
+                t_value_counts& counts = m_value_counts[std::make_pair(idx, dst_ridx)];
+
+                for_each_strand_value(info, src_ridx, spec.get_first_depname(),
+                    [&counts](const t_tscalar& value, t_index count) {
+                        counts.update(value, count);
+                    });
+
+                bool is_unique = counts.is_unique(new_value);
 
                 if (new_value.m_type == DTYPE_STR) {
                     if (is_unique) {
@@ -981,49 +1270,50 @@ t_stree::update_agg_table(t_uindex nidx, t_agg_update_info& info, t_uindex src_r
 
                 dst->set_scalar(dst_ridx, new_value);
             } break;
-            case AGGTYPE_MEDIAN: {
+            case AGGTYPE_MEDIAN:
+            case AGGTYPE_PERCENTILE: {
                 old_value.set(dst->get_scalar(dst_ridx));
-                auto pkeys = get_pkeys(nidx);
 
-                new_value.set(
-                    gstate.reduce<std::function<t_tscalar(std::vector<t_tscalar>&)>>(pkeys,
-                        spec.get_dependencies()[0].name(), [](std::vector<t_tscalar>& values) {
-                            if (values.size() == 0) {
-                                return t_tscalar();
-                            } else if (values.size() == 1) {
-                                return values[0];
-                            } else {
-                                std::vector<t_tscalar>::iterator middle
-                                    = values.begin() + (values.size() / 2);
+                auto key = std::make_pair(idx, dst_ridx);
+                if (m_order_stats.find(key) == m_order_stats.end()) {
+                    m_order_stats.insert(
+                        std::make_pair(key, t_order_statistic(spec.get_quantile())));
+                }
 
-                                std::nth_element(values.begin(), middle, values.end());
+                t_order_statistic& stat = m_order_stats[key];
 
-                                return *middle;
-                            }
-                        }));
+                for_each_strand_value(info, src_ridx, spec.get_first_depname(),
+                    [&stat](const t_tscalar& value, t_index count) {
+                        stat.update(value, count);
+                    });
 
+                new_value.set(stat.get());
                 dst->set_scalar(dst_ridx, new_value);
             } break;
             case AGGTYPE_JOIN: {
                 old_value.set(dst->get_scalar(dst_ridx));
-                auto pkeys = get_pkeys(nidx);
 
-                new_value.set(gstate.reduce<std::function<t_tscalar(std::vector<t_tscalar>&)>>(
-                    pkeys, spec.get_dependencies()[0].name(),
-                    [this](std::vector<t_tscalar>& values) {
-                        std::set<t_tscalar> vset;
-                        for (const auto& v : values) {
-                            vset.insert(v);
-                        }
+                t_value_counts& counts = m_value_counts[std::make_pair(idx, dst_ridx)];
+                bool changed = false;
 
-                        std::stringstream ss;
-                        for (std::set<t_tscalar>::const_iterator iter = vset.begin();
-                             iter != vset.end(); ++iter) {
-                            ss << *iter << ", ";
-                        }
-                        return m_symtable.get_interned_tscalar(ss.str().c_str());
-                    }));
+                for_each_strand_value(info, src_ridx, spec.get_first_depname(),
+                    [&counts, &changed](const t_tscalar& value, t_index count) {
+                        changed = counts.update(value, count) || changed;
+                    });
+
+                // The joined string only needs rebuilding when a distinct
+                // value was added or removed.
+                if (!changed && old_value.is_valid()) {
+                    new_value.set(old_value);
+                    break;
+                }
 
+                std::stringstream ss;
+                for (const auto& value : counts.get_sorted_values()) {
+                    ss << value << ", ";
+                }
+
+                new_value.set(m_symtable.get_interned_tscalar(ss.str().c_str()));
                 dst->set_scalar(dst_ridx, new_value);
             } break;
             case AGGTYPE_SCALED_DIV: {
@@ -1250,27 +1540,82 @@ t_stree::update_agg_table(t_uindex nidx, t_agg_update_info& info, t_uindex src_r
             } break;
             case AGGTYPE_DISTINCT_COUNT: {
                 old_value.set(dst->get_scalar(dst_ridx));
-                auto pkeys = get_pkeys(nidx);
 
-                new_value.set(
-                    gstate.reduce<std::function<std::uint32_t(std::vector<t_tscalar>&)>>(pkeys,
-                        spec.get_dependencies()[0].name(), [](std::vector<t_tscalar>& values) {
-                            tsl::hopscotch_set<t_tscalar> vset;
-                            for (const auto& v : values) {
-                                vset.insert(v);
-                            }
-                            std::uint32_t rv = vset.size();
-                            return rv;
-                        }));
+                t_value_counts& counts = m_value_counts[std::make_pair(idx, dst_ridx)];
+
+                for_each_strand_value(info, src_ridx, spec.get_first_depname(),
+                    [&counts](const t_tscalar& value, t_index count) {
+                        counts.update(value, count);
+                    });
+
+                new_value.set(static_cast<std::uint32_t>(counts.num_distinct()));
+                dst->set_scalar(dst_ridx, new_value);
+            } break;
+            case AGGTYPE_APPROX_DISTINCT_COUNT: {
+                old_value.set(dst->get_scalar(dst_ridx));
+
+                auto key = std::make_pair(idx, dst_ridx);
+                if (m_sketches.find(key) == m_sketches.end()) {
+                    m_sketches.insert(std::make_pair(key, t_hyperloglog(spec.get_precision())));
+                }
+
+                t_hyperloglog& sketch = m_sketches[key];
+                bool removed = false;
+
+                for_each_strand_value(info, src_ridx, spec.get_first_depname(),
+                    [&sketch, &removed](const t_tscalar& value, t_index count) {
+                        if (count > 0) {
+                            sketch.add(value);
+                        } else {
+                            removed = true;
+                        }
+                    });
 
+                if (removed) {
+                    m_stale_sketches.push_back(std::make_pair(nidx, idx));
+                    new_value.set(old_value);
+                    break;
+                }
+
+                new_value.set(static_cast<std::uint32_t>(sketch.estimate()));
+                dst->set_scalar(dst_ridx, new_value);
+            } break;
+            case AGGTYPE_APPROX_PERCENTILE: {
+                old_value.set(dst->get_scalar(dst_ridx));
+
+                t_tdigest& digest = m_digests[std::make_pair(idx, dst_ridx)];
+                bool removed = false;
+
+                for_each_strand_value(info, src_ridx, spec.get_first_depname(),
+                    [&digest, &removed](const t_tscalar& value, t_index count) {
+                        if (count > 0) {
+                            digest.add(value, count);
+                        } else {
+                            removed = true;
+                        }
+                    });
+
+                if (removed) {
+                    m_stale_sketches.push_back(std::make_pair(nidx, idx));
+                    new_value.set(old_value);
+                    break;
+                }
+
+                new_value.set(get_digest_quantile(digest, spec.get_quantile()));
                 dst->set_scalar(dst_ridx, new_value);
             } break;
             case AGGTYPE_DISTINCT_LEAF: {
-                auto pkeys = get_pkeys(nidx);
                 old_value.set(dst->get_scalar(dst_ridx));
+
+                t_value_counts& counts = m_value_counts[std::make_pair(idx, dst_ridx)];
+
+                for_each_strand_value(info, src_ridx, spec.get_first_depname(),
+                    [&counts](const t_tscalar& value, t_index count) {
+                        counts.update(value, count);
+                    });
+
                 bool skip = false;
-                bool is_unique
-                    = gstate.is_unique(pkeys, spec.get_dependencies()[0].name(), new_value);
+                bool is_unique = counts.is_unique(new_value);
 
                 if (is_leaf(nidx) && is_unique) {
                     if (new_value.m_type == DTYPE_STR) {
@@ -1291,26 +1636,86 @@ t_stree::update_agg_table(t_uindex nidx, t_agg_update_info& info, t_uindex src_r
             default: { PSP_COMPLAIN_AND_ABORT("Not implemented"); }
         } // end switch
 
-        bool val_neq = old_value != new_value;
+        record_agg_delta(nidx, idx, old_value, new_value);
+    } // end for
+}
+
+void
+t_stree::record_agg_delta(
+    t_uindex nidx, t_uindex idx, const t_tscalar& old_value, const t_tscalar& new_value) {
+    bool val_neq = old_value != new_value;
+
+    m_has_delta = m_has_delta || val_neq;
+    bool deltas_enabled = m_features.at(CTX_FEAT_DELTA);
+    if (deltas_enabled && val_neq) {
+        m_deltas->insert(t_tcdelta(nidx, idx, old_value, new_value));
+    }
+}
+
+void
+t_stree::rebuild_stale_sketches(const t_agg_update_info& info, const t_gstate& gstate) {
+    std::vector<std::pair<t_uindex, t_uindex>> stale;
+    std::swap(stale, m_stale_sketches);
+
+    stale.erase(std::remove_if(stale.begin(), stale.end(),
+                    [this](const std::pair<t_uindex, t_uindex>& s) {
+                        return !node_exists(s.first);
+                    }),
+        stale.end());
 
-        m_has_delta = m_has_delta || val_neq;
-        bool deltas_enabled = m_features.at(CTX_FEAT_DELTA);
-        if (deltas_enabled && val_neq) {
-            m_deltas->insert(t_tcdelta(nidx, idx, old_value, new_value));
+    std::stable_sort(stale.begin(), stale.end(),
+        [this](const std::pair<t_uindex, t_uindex>& a, const std::pair<t_uindex, t_uindex>& b) {
+            return m_nodes->find(a.first)->m_depth > m_nodes->find(b.first)->m_depth;
+        });
+
+    std::vector<t_tscalar> values;
+    std::vector<t_uindex> child_aggidxs;
+
+    for (const auto& s : stale) {
+        t_uindex nidx = s.first;
+        t_uindex idx = s.second;
+        t_uindex aggidx = m_nodes->find(nidx)->m_aggidx;
+        const t_aggspec& spec = info.m_aggspecs[idx];
+        const std::vector<t_uindex>& slots = m_nodes->get_child_slots(nidx);
+
+        values.clear();
+        child_aggidxs.clear();
+
+        if (slots.empty()) {
+            gstate.read_column(spec.get_first_depname(), get_pkeys(nidx), values);
+        } else {
+            // Children are deeper, so any stale child is already rebuilt.
+            for (auto slot : slots) {
+                child_aggidxs.push_back(m_nodes->get_slot(slot).m_aggidx);
+            }
         }
 
-    } // end for
+        t_column* dst = info.m_dst[idx];
+        t_tscalar old_value = dst->get_scalar(aggidx);
+        t_tscalar new_value = mknone();
+
+        switch (spec.agg()) {
+            case AGGTYPE_APPROX_DISTINCT_COUNT: {
+                t_hyperloglog& sketch = m_sketches[std::make_pair(idx, aggidx)];
+                rebuild_sketch(sketch, m_sketches, idx, values, child_aggidxs);
+                new_value.set(static_cast<std::uint32_t>(sketch.estimate()));
+            } break;
+            case AGGTYPE_APPROX_PERCENTILE: {
+                t_tdigest& digest = m_digests[std::make_pair(idx, aggidx)];
+                rebuild_sketch(digest, m_digests, idx, values, child_aggidxs);
+                new_value.set(get_digest_quantile(digest, spec.get_quantile()));
+            } break;
+            default: { PSP_COMPLAIN_AND_ABORT("Not a sketch aggregate"); }
+        }
+
+        dst->set_scalar(aggidx, new_value);
+        record_agg_delta(nidx, idx, old_value, new_value);
+    }
 }
 
 std::vector<t_uindex>
 t_stree::zero_strands() const {
-    auto iterators = m_nodes->get<by_nstrands>().equal_range(0);
-    std::vector<t_uindex> rval;
-
-    for (auto& iter = iterators.first; iter != iterators.second; ++iter) {
-        rval.push_back(iter->m_idx);
-    }
-    return rval;
+    return m_nodes->zero_strands();
 }
 
 std::set<t_uindex>
@@ -1344,12 +1749,12 @@ t_stree::non_zero_ids(
 
 t_uindex
 t_stree::get_parent_idx(t_uindex ptidx) const {
-    iter_by_idx iter = m_nodes->get<by_idx>().find(ptidx);
-    if (iter == m_nodes->get<by_idx>().end()) {
+    const t_tnode* node = m_nodes->find(ptidx);
+    if (node == nullptr) {
         std::cout << "Failed in tree => " << repr() << std::endl;
         PSP_VERBOSE_ASSERT(false, "Did not find node");
     }
-    return iter->m_pidx;
+    return node->m_pidx;
 }
 
 std::vector<t_uindex>
@@ -1368,16 +1773,14 @@ t_stree::get_ancestry(t_uindex idx) const {
 
 t_index
 t_stree::get_sibling_idx(t_index p_ptidx, t_index p_nchild, t_uindex c_ptidx) const {
-    t_by_pidx_ipair iterators = m_nodes->get<by_pidx>().equal_range(p_ptidx);
-    iter_by_pidx c_iter = m_nodes->project<by_pidx>(m_nodes->get<by_idx>().find(c_ptidx));
-    return std::distance(iterators.first, c_iter);
+    return m_nodes->get_child_position(p_ptidx, c_ptidx);
 }
 
 t_uindex
 t_stree::get_aggidx(t_uindex idx) const {
-    iter_by_idx iter = m_nodes->get<by_idx>().find(idx);
-    PSP_VERBOSE_ASSERT(iter != m_nodes->get<by_idx>().end(), "Failed in get_aggidx");
-    return iter->m_aggidx;
+    const t_tnode* node = m_nodes->find(idx);
+    PSP_VERBOSE_ASSERT(node != nullptr, "Failed in get_aggidx");
+    return node->m_aggidx;
 }
 
 std::shared_ptr<const t_data_table>
@@ -1392,9 +1795,9 @@ t_stree::_get_aggtable() {
 
 t_stree::t_tnode
 t_stree::get_node(t_uindex idx) const {
-    iter_by_idx iter = m_nodes->get<by_idx>().find(idx);
-    PSP_VERBOSE_ASSERT(iter != m_nodes->get<by_idx>().end(), "Failed in get_node");
-    return *iter;
+    const t_tnode* node = m_nodes->find(idx);
+    PSP_VERBOSE_ASSERT(node != nullptr, "Failed in get_node");
+    return *node;
 }
 
 void
@@ -1405,9 +1808,9 @@ t_stree::get_path(t_uindex idx, std::vector<t_tscalar>& rval) const {
         return;
 
     while (1) {
-        iter_by_idx iter = m_nodes->get<by_idx>().find(curidx);
-        rval.push_back(iter->m_value);
-        curidx = iter->m_pidx;
+        const t_tnode* node = m_nodes->find(curidx);
+        rval.push_back(node->m_value);
+        curidx = node->m_pidx;
         if (curidx == 0) {
             break;
         }
@@ -1417,17 +1820,32 @@ t_stree::get_path(t_uindex idx, std::vector<t_tscalar>& rval) const {
 
 t_uindex
 t_stree::resolve_child(t_uindex root, const t_tscalar& datum) const {
-    auto iter = m_nodes->get<by_pidx_hash>().find(std::make_tuple(root, datum));
+    return m_nodes->find_child(root, datum);
+}
 
-    if (iter == m_nodes->get<by_pidx_hash>().end()) {
-        return INVALID_INDEX;
-    }
+namespace {
 
-    return iter->m_idx;
+// Erase the per node state of aggregate column `spec_idx` for the aggregate
+// rows in `cleared`, from a map keyed by aggregate column and aggregate row.
+template <typename MAP_T>
+void
+erase_cleared_aggregates(
+    MAP_T& map, t_uindex spec_idx, const std::vector<t_uindex>& cleared) {
+    if (map.empty())
+        return;
+
+    for (auto aggidx : cleared) {
+        map.erase(std::make_pair(spec_idx, aggidx));
+    }
 }
 
+} // namespace
+
 void
 t_stree::clear_aggregates(const std::vector<t_uindex>& indices) {
+    if (indices.empty())
+        return;
+
     auto cols = m_aggregates->get_columns();
     for (auto c : cols) {
         for (auto aggidx : indices) {
@@ -1435,12 +1853,22 @@ t_stree::clear_aggregates(const std::vector<t_uindex>& indices) {
         }
     }
 
+    for (t_uindex idx = 0, loop_end = m_aggspecs.size(); idx < loop_end; ++idx) {
+        if (!m_aggspecs[idx].tracks_values())
+            continue;
+
+        erase_cleared_aggregates(m_order_stats, idx, indices);
+        erase_cleared_aggregates(m_value_counts, idx, indices);
+        erase_cleared_aggregates(m_sketches, idx, indices);
+        erase_cleared_aggregates(m_digests, idx, indices);
+    }
+
     m_agg_freelist.insert(std::end(m_agg_freelist), std::begin(indices), std::end(indices));
 }
 
 void
 t_stree::drop_zero_strands() {
-    auto iterators = m_nodes->get<by_nstrands>().equal_range(0);
+    auto zeros = m_nodes->zero_strands();
 
     std::vector<t_uindex> leaves;
 
@@ -1448,10 +1876,11 @@ t_stree::drop_zero_strands() {
 
     std::vector<t_uindex> node_ids;
 
-    for (auto iter = iterators.first; iter != iterators.second; ++iter) {
-        if (iter->m_depth == lst)
-            leaves.push_back(iter->m_idx);
-        node_ids.push_back(iter->m_aggidx);
+    for (auto idx : zeros) {
+        const t_tnode* node = m_nodes->find(idx);
+        if (node->m_depth == lst)
+            leaves.push_back(node->m_idx);
+        node_ids.push_back(node->m_aggidx);
     }
 
     clear_aggregates(node_ids);
@@ -1466,9 +1895,7 @@ t_stree::drop_zero_strands() {
         }
     }
 
-    auto iterators2 = m_nodes->get<by_nstrands>().equal_range(0);
-
-    m_nodes->get<by_nstrands>().erase(iterators2.first, iterators2.second);
+    m_nodes->erase_zero_strands();
 }
 
 void
@@ -1540,8 +1967,7 @@ t_stree::get_leaves(t_uindex idx) const {
 
 t_depth
 t_stree::get_depth(t_uindex ptidx) const {
-    auto iter = m_nodes->get<by_idx>().find(ptidx);
-    return iter->m_depth;
+    return m_nodes->find(ptidx)->m_depth;
 }
 
 void
@@ -1575,29 +2001,18 @@ t_stree::get_drd_indices(
 
 std::vector<t_uindex>
 t_stree::get_child_idx(t_uindex idx) const {
-    t_index num_children = get_num_children(idx);
-    std::vector<t_uindex> children(num_children);
-    auto iterators = m_nodes->get<by_pidx>().equal_range(idx);
-    t_index count = 0;
-    while (iterators.first != iterators.second) {
-        children[count] = iterators.first->m_idx;
-        ++count;
-        ++iterators.first;
-    }
-    return children;
+    return get_children(idx);
 }
 
 std::vector<std::pair<t_index, t_index>>
 t_stree::get_child_idx_depth(t_uindex idx) const {
-    t_index num_children = get_num_children(idx);
-    std::vector<std::pair<t_index, t_index>> children(num_children);
-    auto iterators = m_nodes->get<by_pidx>().equal_range(idx);
+    const std::vector<t_uindex>& slots = m_nodes->get_child_slots(idx);
+    std::vector<std::pair<t_index, t_index>> children(slots.size());
     t_index count = 0;
-    while (iterators.first != iterators.second) {
-        children[count]
-            = std::pair<t_index, t_index>(iterators.first->m_idx, iterators.first->m_depth);
+    for (auto slot : slots) {
+        const t_tnode& node = m_nodes->get_slot(slot);
+        children[count] = std::pair<t_index, t_index>(node.m_idx, node.m_depth);
         ++count;
-        ++iterators.first;
     }
     return children;
 }
@@ -1623,9 +2038,9 @@ t_stree::last_level() const {
 
 bool
 t_stree::is_leaf(t_uindex nidx) const {
-    auto iter = m_nodes->get<by_idx>().find(nidx);
-    PSP_VERBOSE_ASSERT(iter != m_nodes->get<by_idx>().end(), "Did not find node");
-    return iter->m_depth == last_level();
+    const t_tnode* node = m_nodes->find(nidx);
+    PSP_VERBOSE_ASSERT(node != nullptr, "Did not find node");
+    return node->m_depth == last_level();
 }
 
 std::vector<t_uindex>
@@ -1659,12 +2074,11 @@ t_stree::resolve_path(t_uindex root, const std::vector<t_tscalar>& path) const {
         return curidx;
 
     for (t_index i = path.size() - 1; i >= 0; i--) {
-        iter_by_pidx_hash iter
-            = m_nodes->get<by_pidx_hash>().find(std::make_tuple(curidx, path[i]));
-        if (iter == m_nodes->get<by_pidx_hash>().end()) {
+        t_uindex child = m_nodes->find_child(curidx, path[i]);
+        if (child == t_treenodes::NO_CHILD) {
             return INVALID_INDEX;
         }
-        curidx = iter->m_idx;
+        curidx = child;
     }
 
     return curidx;
@@ -1741,12 +2155,11 @@ t_stree::get_aggregate(t_index idx, t_index aggnum) const {
 
 void
 t_stree::get_child_indices(t_index idx, std::vector<t_index>& out_data) const {
-    t_index num_children = get_num_children(idx);
-    std::vector<t_index> temp(num_children);
-    t_by_pidx_ipair iterators = m_nodes->get<by_pidx>().equal_range(idx);
+    const std::vector<t_uindex>& slots = m_nodes->get_child_slots(idx);
+    std::vector<t_index> temp(slots.size());
     t_index count = 0;
-    for (iter_by_pidx iter = iterators.first; iter != iterators.second; ++iter) {
-        temp[count] = iter->m_idx;
+    for (auto slot : slots) {
+        temp[count] = m_nodes->get_slot(slot).m_idx;
         ++count;
     }
     std::swap(out_data, temp);
@@ -1761,6 +2174,11 @@ t_stree::clear_deltas() {
 void
 t_stree::clear() {
     m_nodes->clear();
+    m_order_stats.clear();
+    m_value_counts.clear();
+    m_sketches.clear();
+    m_digests.clear();
+    m_stale_sketches.clear();
     clear_deltas();
 }
 
@@ -1834,8 +2252,7 @@ t_stree::first_last_helper(t_uindex nidx, const t_aggspec& spec, const t_gstate&
 
 bool
 t_stree::node_exists(t_uindex idx) {
-    iter_by_idx iter = m_nodes->get<by_idx>().find(idx);
-    return iter != m_nodes->get<by_idx>().end();
+    return m_nodes->contains(idx);
 }
 
 t_data_table*
@@ -1843,7 +2260,7 @@ t_stree::get_aggtable() {
     return m_aggregates.get();
 }
 
-std::pair<iter_by_idx, bool>
+bool
 t_stree::insert_node(const t_tnode& node) {
     return m_nodes->insert(node);
 }
@@ -1861,9 +2278,9 @@ t_stree::get_sortby_path(t_uindex idx, std::vector<t_tscalar>& rval) const {
         return;
 
     while (1) {
-        iter_by_idx iter = m_nodes->get<by_idx>().find(curidx);
-        rval.push_back(iter->m_sort_value);
-        curidx = iter->m_pidx;
+        const t_tnode* node = m_nodes->find(curidx);
+        rval.push_back(node->m_sort_value);
+        curidx = node->m_pidx;
         if (curidx == 0) {
             break;
         }
@@ -0,0 +1,285 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2017, the Perspective Authors.
+ *
+ * This file is part of the Perspective library, distributed under the terms of
+ * the Apache License 2.0.  The full license can be found in the LICENSE file.
+ *
+ */
+
+#include <perspective/first.h>
+#include <perspective/sparse_tree_nodes.h>
+#include <boost/functional/hash.hpp>
+#include <algorithm>
+
+namespace perspective {
+
+std::size_t
+t_stnode_key_hash::operator()(const t_stnode_key& key) const {
+    std::size_t seed = hash_value(key.second);
+    boost::hash_combine(seed, key.first);
+    return seed;
+}
+
+t_treenodes::t_treenodes() {}
+
+bool
+t_treenodes::insert(const t_stnode& node) {
+    if (m_slots.find(node.m_idx) != m_slots.end()) {
+        return false;
+    }
+
+    t_stnode_key key(node.m_pidx, node.m_value);
+    if (!m_child_index.insert(std::make_pair(key, node.m_idx)).second) {
+        return false;
+    }
+
+    t_uindex slot;
+    if (m_free_slots.empty()) {
+        slot = m_nodes.size();
+        m_nodes.push_back(node);
+        m_children.emplace_back();
+        m_children_sorted.push_back(true);
+    } else {
+        slot = m_free_slots.back();
+        m_free_slots.pop_back();
+        m_nodes[slot] = node;
+        m_children_sorted[slot] = true;
+    }
+
+    m_slots[node.m_idx] = slot;
+
+    if (node.m_nstrands == 0) {
+        m_zero_strands.insert(node.m_idx);
+    }
+
+    append_child(node.m_pidx, slot);
+    return true;
+}
+
+bool
+t_treenodes::contains(t_uindex idx) const {
+    return m_slots.find(idx) != m_slots.end();
+}
+
+const t_stnode*
+t_treenodes::find(t_uindex idx) const {
+    auto iter = m_slots.find(idx);
+    if (iter == m_slots.end()) {
+        return nullptr;
+    }
+
+    return &m_nodes[iter->second];
+}
+
+t_uindex
+t_treenodes::find_child(t_uindex pidx, const t_tscalar& value) const {
+    auto iter = m_child_index.find(t_stnode_key(pidx, value));
+    if (iter == m_child_index.end()) {
+        return NO_CHILD;
+    }
+
+    return iter->second;
+}
+
+void
+t_treenodes::set_nstrands(t_uindex idx, t_uindex nstrands) {
+    t_stnode& node = m_nodes[get_slot_idx(idx)];
+
+    if (nstrands == 0) {
+        m_zero_strands.insert(idx);
+    } else if (node.m_nstrands == 0) {
+        m_zero_strands.erase(idx);
+    }
+
+    node.set_nstrands(nstrands);
+}
+
+void
+t_treenodes::set_sort_value(t_uindex idx, const t_tscalar& sort_value) {
+    t_stnode& node = m_nodes[get_slot_idx(idx)];
+
+    if (node.m_sort_value == sort_value) {
+        return;
+    }
+
+    node.set_sort_value(sort_value);
+    mark_unsorted(node.m_pidx);
+}
+
+const std::vector<t_uindex>&
+t_treenodes::get_child_slots(t_uindex idx) const {
+    auto iter = m_slots.find(idx);
+    if (iter == m_slots.end()) {
+        return m_empty;
+    }
+
+    t_uindex slot = iter->second;
+    std::vector<t_uindex>& children = m_children[slot];
+
+    if (!m_children_sorted[slot]) {
+        std::sort(children.begin(), children.end(),
+            [this](t_uindex lslot, t_uindex rslot) { return child_lt(lslot, rslot); });
+        m_children_sorted[slot] = true;
+    }
+
+    return children;
+}
+
+const t_stnode&
+t_treenodes::get_slot(t_uindex slot) const {
+    return m_nodes[slot];
+}
+
+t_uindex
+t_treenodes::get_num_children(t_uindex idx) const {
+    auto iter = m_slots.find(idx);
+    if (iter == m_slots.end()) {
+        return 0;
+    }
+
+    return m_children[iter->second].size();
+}
+
+t_index
+t_treenodes::get_child_position(t_uindex pidx, t_uindex cidx) const {
+    const std::vector<t_uindex>& children = get_child_slots(pidx);
+    t_uindex cslot = get_slot_idx(cidx);
+
+    // Children are unique by `(m_sort_value, m_value)`, so the child is the
+    // lower bound of its own key.
+    auto iter = std::lower_bound(children.begin(), children.end(), cslot,
+        [this](t_uindex lslot, t_uindex rslot) { return child_lt(lslot, rslot); });
+
+    return std::distance(children.begin(), iter);
+}
+
+std::vector<t_uindex>
+t_treenodes::zero_strands() const {
+    std::vector<t_uindex> rval(m_zero_strands.begin(), m_zero_strands.end());
+    std::sort(rval.begin(), rval.end());
+    return rval;
+}
+
+void
+t_treenodes::erase_zero_strands() {
+    if (m_zero_strands.empty()) {
+        return;
+    }
+
+    tsl::hopscotch_set<t_uindex> parents;
+
+    for (auto idx : m_zero_strands) {
+        t_uindex slot = get_slot_idx(idx);
+        const t_stnode& node = m_nodes[slot];
+        m_child_index.erase(t_stnode_key(node.m_pidx, node.m_value));
+        m_slots.erase(idx);
+        parents.insert(node.m_pidx);
+
+        std::vector<t_uindex>().swap(m_children[slot]);
+        m_free_slots.push_back(slot);
+    }
+
+    m_zero_strands.clear();
+
+    // Erasing preserves the order of the surviving children.
+    for (auto pidx : parents) {
+        auto iter = m_slots.find(pidx);
+        if (iter == m_slots.end()) {
+            continue;
+        }
+
+        std::vector<t_uindex>& children = m_children[iter->second];
+        children.erase(std::remove_if(children.begin(), children.end(),
+                           [this](t_uindex slot) {
+                               auto citer = m_slots.find(m_nodes[slot].m_idx);
+                               return citer == m_slots.end() || citer->second != slot;
+                           }),
+            children.end());
+    }
+}
+
+t_uindex
+t_treenodes::size() const {
+    return m_slots.size();
+}
+
+void
+t_treenodes::clear() {
+    m_nodes.clear();
+    m_children.clear();
+    m_children_sorted.clear();
+    m_free_slots.clear();
+    m_slots.clear();
+    m_child_index.clear();
+    m_zero_strands.clear();
+}
+
+t_memory_usage
+t_treenodes::get_memory_usage(const std::string& name) const {
+    t_memory_usage rval = get_vector_memory_usage(name, m_nodes);
+    rval += get_vector_memory_usage(name, m_children);
+    rval += get_vector_memory_usage(name, m_children_sorted);
+    rval += get_vector_memory_usage(name, m_free_slots);
+
+    for (const auto& children : m_children) {
+        rval += get_vector_memory_usage(name, children);
+    }
+
+    rval += get_hash_memory_usage(name, m_slots);
+    rval += get_hash_memory_usage(name, m_child_index);
+    rval += get_hash_memory_usage(name, m_zero_strands);
+    return rval;
+}
+
+t_uindex
+t_treenodes::get_slot_idx(t_uindex idx) const {
+    auto iter = m_slots.find(idx);
+    PSP_VERBOSE_ASSERT(iter != m_slots.end(), "Did not find node");
+    return iter->second;
+}
+
+bool
+t_treenodes::child_lt(t_uindex lslot, t_uindex rslot) const {
+    const t_stnode& lnode = m_nodes[lslot];
+    const t_stnode& rnode = m_nodes[rslot];
+
+    if (lnode.m_sort_value < rnode.m_sort_value) {
+        return true;
+    }
+
+    if (rnode.m_sort_value < lnode.m_sort_value) {
+        return false;
+    }
+
+    return lnode.m_value < rnode.m_value;
+}
+
+void
+t_treenodes::append_child(t_uindex pidx, t_uindex slot) {
+    auto iter = m_slots.find(pidx);
+    if (iter == m_slots.end()) {
+        return;
+    }
+
+    t_uindex pslot = iter->second;
+    std::vector<t_uindex>& children = m_children[pslot];
+
+    // Pivots are usually inserted in sort order, in which case the children
+    // stay sorted without marking the parent.
+    if (m_children_sorted[pslot] && !children.empty() && child_lt(slot, children.back())) {
+        m_children_sorted[pslot] = false;
+    }
+
+    children.push_back(slot);
+}
+
+void
+t_treenodes::mark_unsorted(t_uindex pidx) {
+    auto iter = m_slots.find(pidx);
+    if (iter != m_slots.end()) {
+        m_children_sorted[iter->second] = false;
+    }
+}
+
+} // end namespace perspective
@@ -40,6 +40,7 @@ namespace perspective {
 
 t_lstore_recipe::t_lstore_recipe()
     : m_alignment(0)
+    , m_access_hint(ACCESS_HINT_NORMAL)
     , m_from_recipe(false) {}
 
 t_lstore_recipe::t_lstore_recipe(t_uindex capacity)
@@ -55,6 +56,7 @@ t_lstore_recipe::t_lstore_recipe(t_uindex capacity)
     , m_mprot(PSP_DEFAULT_MPROT)
     , m_mflags(PSP_DEFAULT_MFLAGS)
     , m_backing_store(BACKING_STORE_MEMORY)
+    , m_access_hint(ACCESS_HINT_NORMAL)
     , m_from_recipe(false)
 
 {
@@ -75,6 +77,7 @@ t_lstore_recipe::t_lstore_recipe(const std::string& dirname, const std::string&
     , m_mprot(PSP_DEFAULT_MPROT)
     , m_mflags(PSP_DEFAULT_MFLAGS)
     , m_backing_store(backing_store)
+    , m_access_hint(ACCESS_HINT_NORMAL)
     , m_from_recipe(false) {
     PSP_TRACE_SENTINEL();
     LOG_CONSTRUCTOR("t_lstore_recipe");
@@ -94,6 +97,7 @@ t_lstore_recipe::t_lstore_recipe(const std::string& dirname, const std::string&
     , m_mprot(mprot)
     , m_mflags(mflags)
     , m_backing_store(backing_store)
+    , m_access_hint(ACCESS_HINT_NORMAL)
     , m_from_recipe(false) {
     PSP_TRACE_SENTINEL();
     LOG_CONSTRUCTOR("t_lstore_recipe");
@@ -112,6 +116,7 @@ t_lstore_recipe::t_lstore_recipe(const std::string& colname, t_uindex capacity,
     , m_mprot(mprot)
     , m_mflags(mflags)
     , m_backing_store(backing_store)
+    , m_access_hint(ACCESS_HINT_NORMAL)
     , m_from_recipe(false) {
     PSP_TRACE_SENTINEL();
     LOG_CONSTRUCTOR("t_lstore_recipe");
@@ -124,6 +129,7 @@ t_lstore::t_lstore()
     , m_size(0)
     , m_alignment(0)
     , m_backing_store(BACKING_STORE_MEMORY)
+    , m_access_hint(ACCESS_HINT_NORMAL)
     , m_init(false)
     , m_resize_factor(1.2)
     , m_version(0) {
@@ -192,10 +198,12 @@ t_lstore::copy_helper_(const t_lstore& other) {
     m_mprot = other.m_mprot;
     m_mflags = other.m_mflags;
     m_backing_store = other.m_backing_store;
+    m_access_hint = other.m_access_hint;
     m_init = false;
     m_resize_factor = other.m_resize_factor;
     m_version = other.m_version;
     m_from_recipe = other.m_from_recipe;
+    m_pool = other.m_pool;
     PSP_CHECK_CAPACITY();
 }
 
@@ -234,6 +242,9 @@ t_lstore::~t_lstore() {
             }
         } break;
         case BACKING_STORE_MEMORY: {
+            if (m_pool) {
+                m_pool->release(m_base, m_capacity);
+            } else
 #ifdef _MSC_VER
             if (m_alignment >= 2) {
                 _aligned_free(m_base); // seriously
@@ -274,14 +285,23 @@ t_lstore::init() {
             PSP_VERBOSE_ASSERT(m_alignment < 2,
                 "nontrivial alignments currently "
                 "unsupported for BACKING_STORE_DISK");
+            if (!m_from_recipe) {
+                m_capacity = disk_capacity(m_capacity);
+            }
             m_fd = create_file();
             m_base = create_mapping();
+            advise_mapping();
         } break;
         case BACKING_STORE_MEMORY: {
             size_t const alloc_size
                 = std::max(std::max(size_t(m_alignment), size_t(8u)), size_t(capacity()));
 
-            if (m_alignment < 2) {
+            if (m_pool) {
+                // the pool rounds the capacity up to its size class
+                t_uindex capacity = alloc_size;
+                m_base = m_pool->allocate(capacity);
+                m_capacity = capacity;
+            } else if (m_alignment < 2) {
                 m_base = calloc(alloc_size, 1);
             } else {
                 // nontrivial alignment
@@ -315,6 +335,37 @@ t_lstore::reserve(t_uindex capacity) {
     reserve_impl(capacity, false);
 }
 
+void
+t_lstore::detach_pool() {
+    PSP_TRACE_SENTINEL();
+    if (!m_init || !m_pool || m_backing_store != BACKING_STORE_MEMORY)
+        return;
+
+    t_unlock_store tmp(this);
+    void* base = nullptr;
+
+    if (m_alignment < 2) {
+        base = malloc(size_t(m_capacity));
+    } else {
+#ifdef _MSC_VER
+        base = _aligned_malloc(size_t(m_capacity), size_t(m_alignment));
+#else
+        int result = posix_memalign(
+            &base, std::max(sizeof(void*), size_t(m_alignment)), size_t(m_capacity));
+        if (result != 0)
+            base = nullptr;
+#endif
+    }
+
+    PSP_VERBOSE_ASSERT(base, "MALLOC_FAILED");
+
+    // pool blocks are zeroed, so the whole block is copied
+    memcpy(base, m_base, size_t(m_capacity));
+    m_pool->release(m_base, m_capacity);
+    m_base = base;
+    m_pool.reset();
+}
+
 void
 t_lstore::shrink(t_uindex capacity) {
     reserve_impl(capacity, true);
@@ -336,6 +387,15 @@ t_lstore::reserve_impl(t_uindex capacity, bool allow_shrink) {
         capacity = (capacity + m_alignment - 1) & ~(m_alignment - 1);
     t_uindex ocapacity = m_capacity;
 
+    if (m_backing_store == BACKING_STORE_DISK) {
+        if (capacity > ocapacity) {
+            capacity = std::max(capacity, ocapacity + PSP_DISK_STORE_MIN_GROWTH);
+        }
+        capacity = disk_capacity(capacity);
+        if (capacity == ocapacity)
+            return;
+    }
+
     if (t_env::log_storage_resize()) {
         std::cout << repr() << " ocap => " << ocapacity << " ncap => " << capacity << std::endl;
     }
@@ -344,7 +404,11 @@ t_lstore::reserve_impl(t_uindex capacity, bool allow_shrink) {
         case BACKING_STORE_MEMORY: {
             void* base = 0;
 
-            if (m_alignment < 2) {
+            if (m_pool) {
+                base = m_pool->allocate(capacity);
+                memcpy(base, m_base, size_t(std::min(ocapacity, capacity)));
+                m_pool->release(m_base, ocapacity);
+            } else if (m_alignment < 2) {
                 base = realloc(m_base, size_t(capacity));
             } else {
 // nontrivial alignment
@@ -384,12 +448,15 @@ t_lstore::reserve_impl(t_uindex capacity, bool allow_shrink) {
                 "nontrivial alignments currently "
                 "unsupported for BACKING_STORE_DISK");
             resize_mapping(capacity);
+            advise_mapping();
             ++m_version;
         } break;
         default: { PSP_COMPLAIN_AND_ABORT("unknown backing medium"); }
     }
 
-    if (capacity > ocapacity) {
+    // `ftruncate` zero fills the file as it grows, so only memory needs to
+    // be cleared - touching the new pages of a disk store would commit them.
+    if (capacity > ocapacity && m_backing_store == BACKING_STORE_MEMORY) {
         memset(
             static_cast<unsigned char*>(m_base) + ocapacity, 0, size_t(capacity - ocapacity));
     }
@@ -534,6 +601,30 @@ t_lstore::get_recipe() const {
     return rval;
 }
 
+t_lstore_recipe
+t_lstore::get_empty_recipe() const {
+    t_lstore_recipe rval(m_dirname, m_colname, m_capacity, m_backing_store);
+    rval.m_alignment = m_alignment;
+    rval.m_access_hint = m_access_hint;
+    return rval;
+}
+
+void
+t_lstore::set_access_hint(t_access_hint hint) {
+    m_access_hint = hint;
+    if (m_init && m_backing_store == BACKING_STORE_DISK) {
+        advise_mapping();
+    }
+}
+
+t_uindex
+t_lstore::disk_capacity(t_uindex capacity) const {
+    // Mappings are made of whole pages, and cannot be empty.
+    t_uindex page_size = static_cast<t_uindex>(get_page_size());
+    capacity = std::max(capacity, page_size);
+    return (capacity + page_size - 1) / page_size * page_size;
+}
+
 void
 t_lstore::fill(const t_lstore& other) {
     PSP_TRACE_SENTINEL();
@@ -579,7 +670,7 @@ t_lstore::pprint() const {
 
 std::shared_ptr<t_lstore>
 t_lstore::clone() const {
-    auto recipe = get_recipe();
+    auto recipe = get_empty_recipe();
     std::shared_ptr<t_lstore> rval(new t_lstore(recipe));
     rval->init();
     rval->set_size(m_size);
@@ -46,10 +46,13 @@ t_lstore::t_lstore(const t_lstore_recipe& a)
     , m_mprot(a.m_mprot)
     , m_mflags(a.m_mflags)
     , m_backing_store(a.m_backing_store)
+    , m_access_hint(a.m_access_hint)
     , m_init(false)
     , m_resize_factor(1.3)
     , m_version(0)
-    , m_from_recipe(a.m_from_recipe) {
+    , m_from_recipe(a.m_from_recipe)
+    , m_pool(a.m_backing_store == BACKING_STORE_MEMORY && a.m_alignment < 2 ? a.m_pool
+                                                                             : nullptr) {
     if (m_from_recipe) {
         m_fname = a.m_fname;
         return;
@@ -106,6 +109,24 @@ t_lstore::destroy_mapping() {
     PSP_VERBOSE_ASSERT(!rc, "Failed to destroy mapping");
 }
 
+void
+t_lstore::advise_mapping() {
+    int advice = MADV_NORMAL;
+    switch (m_access_hint) {
+        case ACCESS_HINT_SEQUENTIAL: {
+            advice = MADV_SEQUENTIAL;
+        } break;
+        case ACCESS_HINT_RANDOM: {
+            advice = MADV_RANDOM;
+        } break;
+        default: break;
+    }
+
+    // Advice only tunes readahead and eviction, so failing to apply it is
+    // harmless.
+    madvise(m_base, capacity(), advice);
+}
+
 void
 t_lstore::freeze_impl() {
     PSP_COMPLAIN_AND_ABORT("Not implemented");
@@ -42,10 +42,13 @@ t_lstore::t_lstore(const t_lstore_recipe& a)
     , m_mprot(a.m_mprot)
     , m_mflags(a.m_mflags)
     , m_backing_store(a.m_backing_store)
+    , m_access_hint(a.m_access_hint)
     , m_init(false)
     , m_resize_factor(1.3)
     , m_version(0)
-    , m_from_recipe(a.m_from_recipe) {
+    , m_from_recipe(a.m_from_recipe)
+    , m_pool(a.m_backing_store == BACKING_STORE_MEMORY && a.m_alignment < 2 ? a.m_pool
+                                                                             : nullptr) {
     if (m_from_recipe) {
         m_fname = a.m_fname;
         return;
@@ -135,6 +138,11 @@ t_lstore::destroy_mapping() {
     m_base = 0;
 }
 
+void
+t_lstore::advise_mapping() {
+    // Windows has no equivalent of `madvise` for file mappings.
+}
+
 void
 t_lstore::freeze_impl() {
     DWORD dwOld;
@@ -8,6 +8,7 @@
  */
 
 #include <perspective/table.h>
+#include <perspective/snapshot.h>
 
 // Give each Table a unique ID so that operations on it map back correctly
 static perspective::t_uindex GLOBAL_TABLE_ID = 0;
@@ -136,7 +137,18 @@ Table::validate_expressions(
 std::shared_ptr<t_gnode>
 Table::make_gnode(const t_schema& in_schema) {
     t_schema out_schema = in_schema.drop({"psp_pkey", "psp_op"}); 
-    auto gnode = std::make_shared<t_gnode>(in_schema, out_schema);
+
+    // Without an index, the primary key of each row is its row number -
+    // modulo the limit, if there is one - so updates that only add rows, or
+    // overwrite the oldest rows of a limited table, can skip pkey processing.
+    t_gnode_type gnode_type = GNODE_TYPE_PKEYED;
+    if (m_index == "") {
+        gnode_type = m_limit == std::numeric_limits<std::uint32_t>::max()
+            ? GNODE_TYPE_APPEND_ONLY
+            : GNODE_TYPE_RING;
+    }
+
+    auto gnode = std::make_shared<t_gnode>(in_schema, out_schema, gnode_type, m_limit);
     gnode->init();
     return gnode;
 }
@@ -179,6 +191,58 @@ Table::calculate_offset(std::uint32_t row_count) {
     m_offset = (m_offset + row_count) % m_limit;
 }
 
+void
+Table::save_snapshot(const std::string& fname) const {
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    PSP_VERBOSE_ASSERT(m_gnode_set, "Cannot save a snapshot of a table without a gnode.");
+    t_snapshot_writer writer(fname);
+    writer.write<std::uint64_t>(PSP_SNAPSHOT_MAGIC);
+    writer.write<std::uint32_t>(PSP_SNAPSHOT_VERSION);
+    writer.write(m_index);
+    writer.write<std::uint64_t>(m_limit);
+    writer.write<std::uint64_t>(m_offset);
+    m_gnode->save_snapshot(writer);
+    writer.close();
+}
+
+void
+Table::load_snapshot(const std::string& fname) {
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    PSP_VERBOSE_ASSERT(m_gnode_set, "Cannot load a snapshot into a table without a gnode.");
+    t_snapshot_reader reader(fname);
+
+    if (reader.read<std::uint64_t>() != PSP_SNAPSHOT_MAGIC) {
+        PSP_COMPLAIN_AND_ABORT("`" + fname + "` is not a table snapshot");
+    }
+
+    if (reader.read<std::uint32_t>() != PSP_SNAPSHOT_VERSION) {
+        PSP_COMPLAIN_AND_ABORT("Snapshot `" + fname + "` was written by another version");
+    }
+
+    if (reader.read_string() != m_index || reader.read<std::uint64_t>() != m_limit) {
+        PSP_COMPLAIN_AND_ABORT("Snapshot does not match the index or limit of the table");
+    }
+
+    std::uint32_t offset = reader.read<std::uint64_t>();
+    m_gnode->load_snapshot(reader);
+    m_offset = offset;
+}
+
+t_memory_report
+Table::get_memory_usage() const {
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    PSP_VERBOSE_ASSERT(m_gnode_set, "Cannot get the memory usage of a table without a gnode.");
+    return m_gnode->get_memory_usage();
+}
+
+void
+Table::set_backing_store(
+    t_backing_store backing_store, const std::string& dirname, t_access_hint access_hint) {
+    PSP_VERBOSE_ASSERT(m_init, "touching uninited object");
+    PSP_VERBOSE_ASSERT(m_gnode_set, "Cannot set the storage of a table without a gnode.");
+    m_gnode->set_backing_store(backing_store, dirname, access_hint);
+}
+
 t_uindex
 Table::get_id() const {
     return m_id;
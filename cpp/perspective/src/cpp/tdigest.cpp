@@ -0,0 +1,196 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2017, the Perspective Authors.
+ *
+ * This file is part of the Perspective library, distributed under the terms of
+ * the Apache License 2.0.  The full license can be found in the LICENSE file.
+ *
+ */
+
+#include <perspective/first.h>
+#include <perspective/tdigest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace perspective {
+
+namespace {
+
+const double PSP_PI = 3.14159265358979323846;
+
+// The `k1` scale function, which maps a quantile to the index of the
+// centroid covering it; a centroid may span at most one unit of `k`.
+double
+quantile_to_k(double q, double compression) {
+    return compression / (2 * PSP_PI) * std::asin(2 * q - 1);
+}
+
+double
+k_to_quantile(double k, double compression) {
+    return (std::sin(k * 2 * PSP_PI / compression) + 1) / 2;
+}
+
+// The largest quantile the centroid starting at quantile `q` may reach.
+double
+quantile_limit(double q, double compression) {
+    double k = quantile_to_k(q, compression) + 1;
+    if (k >= compression / 4) {
+        return 1;
+    }
+
+    return k_to_quantile(k, compression);
+}
+
+} // namespace
+
+t_tdigest::t_tdigest()
+    : t_tdigest(PSP_TDIGEST_DEFAULT_COMPRESSION) {}
+
+t_tdigest::t_tdigest(double compression)
+    : m_compression(compression)
+    , m_count(0)
+    , m_min(std::numeric_limits<double>::infinity())
+    , m_max(-std::numeric_limits<double>::infinity()) {}
+
+void
+t_tdigest::add(const t_tscalar& value, double weight) {
+    if (!value.is_valid() || !value.is_numeric()) {
+        return;
+    }
+
+    double v = value.to_double();
+    if (std::isnan(v)) {
+        return;
+    }
+
+    add(v, weight);
+}
+
+void
+t_tdigest::add(double value, double weight) {
+    m_buffer.push_back(t_centroid{value, weight});
+    m_count += weight;
+    m_min = std::min(m_min, value);
+    m_max = std::max(m_max, value);
+
+    if (m_buffer.size() >= 5 * m_compression) {
+        compress();
+    }
+}
+
+void
+t_tdigest::merge(const t_tdigest& other) {
+    if (other.m_count == 0) {
+        return;
+    }
+
+    m_buffer.insert(m_buffer.end(), other.m_centroids.begin(), other.m_centroids.end());
+    m_buffer.insert(m_buffer.end(), other.m_buffer.begin(), other.m_buffer.end());
+    m_count += other.m_count;
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+    compress();
+}
+
+void
+t_tdigest::clear() {
+    std::vector<t_centroid>().swap(m_centroids);
+    std::vector<t_centroid>().swap(m_buffer);
+    m_count = 0;
+    m_min = std::numeric_limits<double>::infinity();
+    m_max = -std::numeric_limits<double>::infinity();
+}
+
+double
+t_tdigest::quantile(double quantile) {
+    compress();
+
+    if (m_centroids.empty()) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    if (m_centroids.size() == 1) {
+        return m_centroids[0].m_mean;
+    }
+
+    // Each centroid's weight is centred on its mean, and values between
+    // centres are interpolated linearly - towards the extremes at either
+    // end.
+    double index = quantile * m_count;
+    const t_centroid& first = m_centroids.front();
+    const t_centroid& last = m_centroids.back();
+
+    if (index <= first.m_weight / 2) {
+        return m_min + (first.m_mean - m_min) * index / (first.m_weight / 2);
+    }
+
+    if (index >= m_count - last.m_weight / 2) {
+        double tail = (m_count - index) / (last.m_weight / 2);
+        return m_max - (m_max - last.m_mean) * tail;
+    }
+
+    double centre = first.m_weight / 2;
+    for (t_uindex idx = 0, loop_end = m_centroids.size() - 1; idx < loop_end; ++idx) {
+        const t_centroid& lo = m_centroids[idx];
+        const t_centroid& hi = m_centroids[idx + 1];
+        double gap = (lo.m_weight + hi.m_weight) / 2;
+
+        if (index < centre + gap) {
+            return lo.m_mean + (hi.m_mean - lo.m_mean) * (index - centre) / gap;
+        }
+
+        centre += gap;
+    }
+
+    return last.m_mean;
+}
+
+double
+t_tdigest::count() const {
+    return m_count;
+}
+
+t_memory_usage
+t_tdigest::get_memory_usage(const std::string& name) const {
+    t_memory_usage rval = get_vector_memory_usage(name, m_centroids);
+    rval += get_vector_memory_usage(name, m_buffer);
+    return rval;
+}
+
+void
+t_tdigest::compress() {
+    if (m_buffer.empty()) {
+        return;
+    }
+
+    m_buffer.insert(m_buffer.end(), m_centroids.begin(), m_centroids.end());
+    std::sort(m_buffer.begin(), m_buffer.end(),
+        [](const t_centroid& a, const t_centroid& b) { return a.m_mean < b.m_mean; });
+
+    m_centroids.clear();
+
+    t_centroid current = m_buffer[0];
+    double weight_before = 0;
+    double limit = m_count * quantile_limit(0, m_compression);
+
+    for (t_uindex idx = 1, loop_end = m_buffer.size(); idx < loop_end; ++idx) {
+        const t_centroid& next = m_buffer[idx];
+
+        if (weight_before + current.m_weight + next.m_weight <= limit) {
+            double weight = current.m_weight + next.m_weight;
+            current.m_mean += (next.m_mean - current.m_mean) * next.m_weight / weight;
+            current.m_weight = weight;
+        } else {
+            weight_before += current.m_weight;
+            m_centroids.push_back(current);
+            limit = m_count * quantile_limit(weight_before / m_count, m_compression);
+            current = next;
+        }
+    }
+
+    m_centroids.push_back(current);
+    m_buffer.clear();
+}
+
+} // end namespace perspective
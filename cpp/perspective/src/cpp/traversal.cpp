@@ -493,6 +493,11 @@ t_traversal::get_num_tree_leaves(t_index idx) const {
     return rval;
 }
 
+t_memory_usage
+t_traversal::get_memory_usage(const std::string& name) const {
+    return get_vector_memory_usage(name, *m_nodes);
+}
+
 void
 t_traversal::post_order(t_index nidx, std::vector<t_index>& out_vec) {
     std::vector<std::pair<t_index, t_index>> children;
@@ -159,6 +159,20 @@ notify_sparse_tree(std::shared_ptr<t_stree> tree, std::shared_ptr<t_traversal> t
         aggregates, tree_sortby, ctx_sortby, gstate);
 }
 
+void
+notify_sparse_tree(std::shared_ptr<t_stree> tree, std::shared_ptr<t_traversal> traversal,
+    bool process_traversal, const std::vector<t_aggspec>& aggregates,
+    const std::vector<std::pair<std::string, std::string>>& tree_sortby,
+    const std::vector<t_sortspec>& ctx_sortby, const t_ring_step& step,
+    const t_config& config, const t_gstate& gstate) {
+    auto strand_values = tree->build_strand_table(step, aggregates, config);
+
+    auto strands = strand_values.first;
+    auto strand_deltas = strand_values.second;
+    notify_sparse_tree_common(strands, strand_deltas, tree, traversal, process_traversal,
+        aggregates, tree_sortby, ctx_sortby, gstate);
+}
+
 std::vector<t_path>
 ctx_get_expansion_state(
     std::shared_ptr<const t_stree> tree, std::shared_ptr<const t_traversal> traversal) {
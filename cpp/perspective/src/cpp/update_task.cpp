@@ -10,6 +10,12 @@
 #include <perspective/first.h>
 #include <perspective/pool.h>
 #include <perspective/update_task.h>
+#ifdef PSP_ENABLE_PYTHON
+#include <perspective/pyutils.h>
+#endif
+#ifdef PSP_PARALLEL_FOR
+#include <tbb/tbb.h>
+#endif
 
 namespace perspective {
 t_update_task::t_update_task(t_pool& pool)
@@ -21,23 +27,67 @@ t_update_task::run() {
     m_pool.m_data_remaining.store(false);
 
     if (work_to_do) {
+        m_pool._begin_batch();
+
+        std::vector<t_gnode*> gnodes;
+        t_uindex max_input_ports = 0;
+
         for (auto g : m_pool.m_gnodes) {
             if (g) {
-                t_uindex num_input_ports = g->num_input_ports();
-
-                // Call process for each port, and notify the updates from
-                // each port individually.
-                for (t_uindex port_id = 0; port_id < num_input_ports; ++port_id) {
-                    bool did_notify_context = g->process(port_id);
-                    if (did_notify_context) {
-                        m_pool.notify_userspace(port_id);
-                    }
-                    g->clear_output_ports();
+                gnodes.push_back(g);
+                max_input_ports = std::max(max_input_ports, g->num_input_ports());
+            }
+        }
+
+        // Each gnode's ports are processed in order, and each port's updates
+        // are notified before the gnode processes its next port, as the
+        // contexts only hold the deltas of the last process step.
+        for (t_uindex port_id = 0; port_id < max_input_ports; ++port_id) {
+            std::vector<std::uint8_t> did_notify_context = process_gnodes(gnodes, port_id);
+
+            // Notify the updates from each port individually, on the
+            // calling thread.
+            for (t_uindex gidx = 0, loop_end = gnodes.size(); gidx < loop_end; ++gidx) {
+                if (port_id >= gnodes[gidx]->num_input_ports())
+                    continue;
+
+                if (did_notify_context[gidx]) {
+                    m_pool.notify_userspace(gnodes[gidx]->get_id(), port_id);
                 }
+
+                gnodes[gidx]->clear_output_ports();
             }
         }
     }
 
     m_pool.inc_epoch();
 }
+
+std::vector<std::uint8_t>
+t_update_task::process_gnodes(const std::vector<t_gnode*>& gnodes, t_uindex port_id) {
+    t_uindex num_gnodes = gnodes.size();
+    std::vector<std::uint8_t> did_notify_context(num_gnodes, false);
+
+#ifdef PSP_ENABLE_PYTHON
+    PerspectiveScopedGILRelease acquire(m_pool.m_event_loop_thread_id);
+#endif
+
+#ifdef PSP_PARALLEL_FOR
+    tbb::parallel_for(0, int(num_gnodes), 1,
+        [&gnodes, &did_notify_context, port_id](int gidx)
+#else
+    for (t_uindex gidx = 0; gidx < num_gnodes; ++gidx)
+#endif
+        {
+            t_gnode* g = gnodes[gidx];
+            if (port_id < g->num_input_ports()) {
+                did_notify_context[gidx] = g->_process(port_id);
+            }
+        }
+#ifdef PSP_PARALLEL_FOR
+    );
+#endif
+
+    return did_notify_context;
+}
 } // end namespace perspective
@@ -0,0 +1,94 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2017, the Perspective Authors.
+ *
+ * This file is part of the Perspective library, distributed under the terms of
+ * the Apache License 2.0.  The full license can be found in the LICENSE file.
+ *
+ */
+
+#include <perspective/first.h>
+#include <perspective/value_counts.h>
+#include <algorithm>
+
+namespace perspective {
+
+t_value_counts::t_value_counts()
+    : m_size(0) {}
+
+bool
+t_value_counts::update(const t_tscalar& value, t_index count) {
+    if (count == 0) {
+        return false;
+    }
+
+    auto iter = m_counts.find(value);
+
+    if (count > 0) {
+        bool inserted = iter == m_counts.end();
+        m_counts[value] += count;
+        m_size += count;
+        return inserted;
+    }
+
+    // Removing a value that was never added leaves the rest intact.
+    if (iter == m_counts.end()) {
+        return false;
+    }
+
+    t_uindex removed = std::min<t_uindex>(iter->second, -count);
+    m_size -= removed;
+
+    if (iter->second == removed) {
+        m_counts.erase(iter);
+        return true;
+    }
+
+    m_counts[value] -= removed;
+    return false;
+}
+
+t_uindex
+t_value_counts::size() const {
+    return m_size;
+}
+
+t_uindex
+t_value_counts::num_distinct() const {
+    return m_counts.size();
+}
+
+bool
+t_value_counts::is_unique(t_tscalar& value) const {
+    value = mknone();
+
+    if (m_counts.size() > 1) {
+        return false;
+    }
+
+    if (!m_counts.empty()) {
+        value = m_counts.begin()->first;
+    }
+
+    return true;
+}
+
+std::vector<t_tscalar>
+t_value_counts::get_sorted_values() const {
+    std::vector<t_tscalar> rval;
+    rval.reserve(m_counts.size());
+
+    for (const auto& kv : m_counts) {
+        rval.push_back(kv.first);
+    }
+
+    std::sort(rval.begin(), rval.end());
+    return rval;
+}
+
+t_memory_usage
+t_value_counts::get_memory_usage(const std::string& name) const {
+    return get_hash_memory_usage(name, m_counts);
+}
+
+} // end namespace perspective
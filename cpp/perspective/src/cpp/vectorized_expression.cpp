@@ -0,0 +1,749 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2019, the Perspective Authors.
+ *
+ * This file is part of the Perspective library, distributed under the terms of
+ * the Apache License 2.0.  The full license can be found in the LICENSE file.
+ *
+ */
+
+#include <perspective/first.h>
+#include <perspective/vectorized_expression.h>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace perspective {
+
+t_vectorized_block::t_vectorized_block(t_uindex num_slots)
+    : m_values(num_slots, std::vector<double>(PSP_EXPRESSION_BLOCK_SIZE))
+    , m_valid(num_slots, std::vector<std::uint8_t>(PSP_EXPRESSION_BLOCK_SIZE))
+    , m_fallback(PSP_EXPRESSION_BLOCK_SIZE) {}
+
+namespace {
+
+double ceil_fn(double v) { return std::ceil(v); }
+double floor_fn(double v) { return std::floor(v); }
+double exp_fn(double v) { return std::exp(v); }
+double expm1_fn(double v) { return std::expm1(v); }
+double log_fn(double v) { return std::log(v); }
+double log10_fn(double v) { return std::log10(v); }
+double log2_fn(double v) { return std::log2(v); }
+double log1p_fn(double v) { return std::log1p(v); }
+double round_fn(double v) { return std::round(v); }
+double sqrt_fn(double v) { return std::sqrt(v); }
+double abs_fn(double v) { return std::abs(v); }
+double sin_fn(double v) { return std::sin(v); }
+double cos_fn(double v) { return std::cos(v); }
+double tan_fn(double v) { return std::tan(v); }
+
+/**
+ * @brief The unary math builtins that can be lowered. In exprtk, functions
+ * marked `float64_only` return null for integer inputs, and compute in
+ * single precision for `DTYPE_FLOAT32` inputs - they are only lowered for
+ * `DTYPE_FLOAT64` inputs.
+ */
+struct t_unary_fn_def {
+    const char* m_name;
+    t_vectorized_expression::t_unary_fn m_fn;
+    bool m_float64_only;
+};
+
+const t_unary_fn_def UNARY_FNS[] = {
+    {"ceil", ceil_fn, false},
+    {"floor", floor_fn, false},
+    {"exp", exp_fn, false},
+    {"expm1", expm1_fn, false},
+    {"log", log_fn, false},
+    {"log10", log10_fn, false},
+    {"log2", log2_fn, false},
+    {"log1p", log1p_fn, false},
+    {"round", round_fn, false},
+    {"sqrt", sqrt_fn, false},
+    {"abs", abs_fn, true},
+    {"sin", sin_fn, true},
+    {"cos", cos_fn, true},
+    {"tan", tan_fn, true}
+};
+
+/**
+ * @brief Whether `<`, `<=`, `>` and `>=` on two valid scalars of `dtype`
+ * give the same result as on their values converted to double.
+ */
+bool
+is_comparable_dtype(t_dtype dtype) {
+    switch (dtype) {
+        case DTYPE_FLOAT64:
+        case DTYPE_FLOAT32:
+        case DTYPE_INT32:
+        case DTYPE_INT16:
+        case DTYPE_INT8:
+        case DTYPE_UINT32:
+        case DTYPE_UINT16:
+        case DTYPE_UINT8: return true;
+        default: return false;
+    }
+}
+
+/**
+ * @brief Whether `==` and `!=` on two valid scalars of `dtype`, which
+ * compare their raw bits, give the same result as comparing the bits of
+ * their values converted to double.
+ */
+bool
+is_equatable_dtype(t_dtype dtype) {
+    return dtype != DTYPE_FLOAT32 && is_comparable_dtype(dtype);
+}
+
+bool
+bits_equal(double a, double b) {
+    std::uint64_t a_bits;
+    std::uint64_t b_bits;
+    std::memcpy(&a_bits, &a, sizeof(double));
+    std::memcpy(&b_bits, &b, sizeof(double));
+    return a_bits == b_bits;
+}
+
+template <typename DATA_T>
+void
+load_typed(double* values, std::uint8_t* valid, const t_column* column,
+    t_uindex offset, t_uindex num_rows) {
+    const DATA_T* data = column->get_nth<DATA_T>(offset);
+
+    for (t_uindex idx = 0; idx < num_rows; ++idx) {
+        values[idx] = static_cast<double>(data[idx]);
+    }
+
+    for (t_uindex bidx = 0; bidx < num_rows; bidx += 64) {
+        t_uindex block_rows = std::min(num_rows - bidx, t_uindex(64));
+        std::uint64_t valid_word = column->get_valid_word(offset + bidx, block_rows);
+        for (t_uindex idx = 0; idx < block_rows; ++idx) {
+            valid[bidx + idx] = (valid_word >> idx) & 1;
+        }
+    }
+}
+
+void
+load_dtype(t_dtype dtype, double* values, std::uint8_t* valid, const t_column* column,
+    t_uindex offset, t_uindex num_rows) {
+    switch (dtype) {
+        case DTYPE_INT64: {
+            load_typed<std::int64_t>(values, valid, column, offset, num_rows);
+        } break;
+        case DTYPE_INT32: {
+            load_typed<std::int32_t>(values, valid, column, offset, num_rows);
+        } break;
+        case DTYPE_INT16: {
+            load_typed<std::int16_t>(values, valid, column, offset, num_rows);
+        } break;
+        case DTYPE_INT8: {
+            load_typed<std::int8_t>(values, valid, column, offset, num_rows);
+        } break;
+        case DTYPE_UINT64: {
+            load_typed<std::uint64_t>(values, valid, column, offset, num_rows);
+        } break;
+        case DTYPE_UINT32: {
+            load_typed<std::uint32_t>(values, valid, column, offset, num_rows);
+        } break;
+        case DTYPE_UINT16: {
+            load_typed<std::uint16_t>(values, valid, column, offset, num_rows);
+        } break;
+        case DTYPE_UINT8: {
+            load_typed<std::uint8_t>(values, valid, column, offset, num_rows);
+        } break;
+        case DTYPE_FLOAT64: {
+            load_typed<double>(values, valid, column, offset, num_rows);
+        } break;
+        case DTYPE_FLOAT32: {
+            load_typed<float>(values, valid, column, offset, num_rows);
+        } break;
+        default: { PSP_COMPLAIN_AND_ABORT("Unexpected type"); }
+    }
+}
+
+} // namespace
+
+/**
+ * @brief A recursive descent parser over the parsed expression string, which
+ * emits an instruction for every node of the expression. Parsing fails on
+ * any token or construct that has no kernel, in which case the expression is
+ * evaluated by exprtk.
+ */
+class t_vectorized_lowering {
+public:
+    t_vectorized_lowering(const std::string& expression,
+        const std::vector<std::pair<std::string, std::string>>& column_ids,
+        t_vectorized_expression& rval)
+        : m_expression(expression)
+        , m_column_ids(column_ids)
+        , m_rval(rval)
+        , m_pos(0) {}
+
+    bool
+    lower() {
+        next();
+
+        t_node root;
+        if (!parse_comparison(root) || m_token.m_type != TOKEN_END) {
+            return false;
+        }
+
+        if (root.m_dtype != DTYPE_FLOAT64) {
+            return false;
+        }
+
+        m_rval.m_result_slot = root.m_slot;
+        return true;
+    }
+
+private:
+    enum t_token_type {
+        TOKEN_END,
+        TOKEN_NUMBER,
+        TOKEN_IDENTIFIER,
+        TOKEN_OPERATOR,
+        TOKEN_INVALID
+    };
+
+    struct t_token {
+        t_token_type m_type;
+        std::string m_text;
+        double m_number;
+    };
+
+    struct t_node {
+        t_uindex m_slot;
+        t_dtype m_dtype;
+    };
+
+    void
+    next() {
+        const std::string& s = m_expression;
+
+        while (m_pos < s.size() && std::isspace(static_cast<unsigned char>(s[m_pos]))) {
+            ++m_pos;
+        }
+
+        m_token.m_text.clear();
+        m_token.m_number = 0;
+
+        if (m_pos >= s.size()) {
+            m_token.m_type = TOKEN_END;
+            return;
+        }
+
+        char c = s[m_pos];
+        bool starts_number = std::isdigit(static_cast<unsigned char>(c))
+            || (c == '.' && m_pos + 1 < s.size()
+                && std::isdigit(static_cast<unsigned char>(s[m_pos + 1])));
+
+        if (starts_number) {
+            const char* begin = s.c_str() + m_pos;
+            char* end = nullptr;
+            m_token.m_number = std::strtod(begin, &end);
+            m_pos += end - begin;
+
+            // Numbers immediately followed by an identifier are implicit
+            // multiplication in exprtk, i.e. `2x`.
+            bool implicit_mul = m_pos < s.size()
+                && (std::isalpha(static_cast<unsigned char>(s[m_pos])) || s[m_pos] == '_');
+            m_token.m_type = implicit_mul ? TOKEN_INVALID : TOKEN_NUMBER;
+            return;
+        }
+
+        if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+            t_uindex begin = m_pos;
+            while (m_pos < s.size()
+                && (std::isalnum(static_cast<unsigned char>(s[m_pos])) || s[m_pos] == '_')) {
+                ++m_pos;
+            }
+            m_token.m_type = TOKEN_IDENTIFIER;
+            m_token.m_text = s.substr(begin, m_pos - begin);
+            return;
+        }
+
+        static const char* two_char_ops[] = {"<=", ">=", "==", "!=", "<>"};
+        for (const char* op : two_char_ops) {
+            if (s.compare(m_pos, 2, op) == 0) {
+                m_token.m_type = TOKEN_OPERATOR;
+                m_token.m_text = op;
+                m_pos += 2;
+                return;
+            }
+        }
+
+        if (std::strchr("+-*/%(),<>=", c) != nullptr) {
+            m_token.m_type = TOKEN_OPERATOR;
+            m_token.m_text = std::string(1, c);
+            ++m_pos;
+            return;
+        }
+
+        m_token.m_type = TOKEN_INVALID;
+    }
+
+    bool
+    is_operator(const char* op) const {
+        return m_token.m_type == TOKEN_OPERATOR && m_token.m_text == op;
+    }
+
+    t_node
+    emit(t_vectorized_expression::t_opcode opcode, const std::vector<t_uindex>& args,
+        double literal = 0, t_vectorized_expression::t_unary_fn fn = nullptr) {
+        t_vectorized_expression::t_instruction instruction;
+        instruction.m_opcode = opcode;
+        instruction.m_dst = m_rval.m_num_slots++;
+        instruction.m_args = args;
+        instruction.m_literal = literal;
+        instruction.m_fn = fn;
+        m_rval.m_instructions.push_back(instruction);
+
+        t_node rval;
+        rval.m_slot = instruction.m_dst;
+        rval.m_dtype = DTYPE_FLOAT64;
+        return rval;
+    }
+
+    // Comparisons do not chain without parentheses, as exprtk evaluates
+    // `a < b < c` over the result of `a < b`.
+    bool
+    parse_comparison(t_node& out) {
+        t_node lhs;
+        if (!parse_additive(lhs)) {
+            return false;
+        }
+
+        t_vectorized_expression::t_opcode opcode;
+        bool equality = false;
+
+        if (is_operator("<")) {
+            opcode = t_vectorized_expression::OPCODE_LT;
+        } else if (is_operator("<=")) {
+            opcode = t_vectorized_expression::OPCODE_LTE;
+        } else if (is_operator(">")) {
+            opcode = t_vectorized_expression::OPCODE_GT;
+        } else if (is_operator(">=")) {
+            opcode = t_vectorized_expression::OPCODE_GTE;
+        } else if (is_operator("==") || is_operator("=")) {
+            opcode = t_vectorized_expression::OPCODE_EQ;
+            equality = true;
+        } else if (is_operator("!=") || is_operator("<>")) {
+            opcode = t_vectorized_expression::OPCODE_NEQ;
+            equality = true;
+        } else {
+            out = lhs;
+            return true;
+        }
+
+        next();
+
+        t_node rhs;
+        if (!parse_additive(rhs)) {
+            return false;
+        }
+
+        // `t_tscalar` compares the dtypes of scalars of different dtypes,
+        // not their values.
+        if (lhs.m_dtype != rhs.m_dtype) {
+            return false;
+        }
+
+        if (equality ? !is_equatable_dtype(lhs.m_dtype) : !is_comparable_dtype(lhs.m_dtype)) {
+            return false;
+        }
+
+        out = emit(opcode, {lhs.m_slot, rhs.m_slot});
+        return true;
+    }
+
+    bool
+    parse_additive(t_node& out) {
+        if (!parse_multiplicative(out)) {
+            return false;
+        }
+
+        while (is_operator("+") || is_operator("-")) {
+            auto opcode = is_operator("+") ? t_vectorized_expression::OPCODE_ADD
+                                           : t_vectorized_expression::OPCODE_SUB;
+            next();
+
+            t_node rhs;
+            if (!parse_multiplicative(rhs)) {
+                return false;
+            }
+
+            out = emit(opcode, {out.m_slot, rhs.m_slot});
+        }
+
+        return true;
+    }
+
+    bool
+    parse_multiplicative(t_node& out) {
+        if (!parse_unary(out)) {
+            return false;
+        }
+
+        while (is_operator("*") || is_operator("/") || is_operator("%")) {
+            t_vectorized_expression::t_opcode opcode;
+            if (is_operator("*")) {
+                opcode = t_vectorized_expression::OPCODE_MUL;
+            } else if (is_operator("/")) {
+                opcode = t_vectorized_expression::OPCODE_DIV;
+            } else {
+                opcode = t_vectorized_expression::OPCODE_MOD;
+            }
+            next();
+
+            t_node rhs;
+            if (!parse_unary(rhs)) {
+                return false;
+            }
+
+            out = emit(opcode, {out.m_slot, rhs.m_slot});
+        }
+
+        return true;
+    }
+
+    // Unary operators keep the dtype of their operand, so only operands that
+    // are already `DTYPE_FLOAT64` are lowered.
+    bool
+    parse_unary(t_node& out) {
+        if (is_operator("-") || is_operator("+")) {
+            bool negate = is_operator("-");
+            next();
+
+            t_node operand;
+            if (!parse_unary(operand) || operand.m_dtype != DTYPE_FLOAT64) {
+                return false;
+            }
+
+            out = negate ? emit(t_vectorized_expression::OPCODE_NEG, {operand.m_slot})
+                         : operand;
+            return true;
+        }
+
+        return parse_primary(out);
+    }
+
+    bool
+    parse_primary(t_node& out) {
+        if (m_token.m_type == TOKEN_NUMBER) {
+            out = emit(t_vectorized_expression::OPCODE_LITERAL, {}, m_token.m_number);
+            next();
+            return true;
+        }
+
+        if (is_operator("(")) {
+            next();
+            if (!parse_comparison(out) || !is_operator(")")) {
+                return false;
+            }
+            next();
+            return true;
+        }
+
+        if (m_token.m_type != TOKEN_IDENTIFIER) {
+            return false;
+        }
+
+        std::string name = m_token.m_text;
+        next();
+
+        if (is_operator("(")) {
+            next();
+            return parse_call(name, out);
+        }
+
+        for (t_uindex cidx = 0, loop_end = m_column_ids.size(); cidx < loop_end; ++cidx) {
+            if (m_column_ids[cidx].first == name) {
+                t_dtype dtype = m_rval.m_input_dtypes[cidx];
+                if (!is_numeric_type(dtype)) {
+                    return false;
+                }
+
+                out.m_slot = cidx;
+                out.m_dtype = dtype;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool
+    parse_call(std::string name, t_node& out) {
+        std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+
+        std::vector<t_node> args;
+        if (!is_operator(")")) {
+            while (true) {
+                t_node arg;
+                if (!parse_comparison(arg)) {
+                    return false;
+                }
+
+                args.push_back(arg);
+
+                if (is_operator(",")) {
+                    next();
+                    continue;
+                }
+
+                break;
+            }
+        }
+
+        if (!is_operator(")")) {
+            return false;
+        }
+
+        next();
+
+        std::vector<t_uindex> slots;
+        for (const t_node& arg : args) {
+            slots.push_back(arg.m_slot);
+        }
+
+        if (name == "min" || name == "max") {
+            if (args.empty()) {
+                return false;
+            }
+
+            out = emit(name == "min" ? t_vectorized_expression::OPCODE_MIN
+                                     : t_vectorized_expression::OPCODE_MAX, slots);
+            return true;
+        }
+
+        if (name == "percent_of") {
+            if (args.size() != 2) {
+                return false;
+            }
+
+            out = emit(t_vectorized_expression::OPCODE_PERCENT_OF, slots);
+            return true;
+        }
+
+        if (name == "is_null" || name == "is_not_null") {
+            if (args.size() != 1) {
+                return false;
+            }
+
+            out = emit(name == "is_null" ? t_vectorized_expression::OPCODE_IS_NULL
+                                         : t_vectorized_expression::OPCODE_IS_NOT_NULL, slots);
+            return true;
+        }
+
+        for (const t_unary_fn_def& def : UNARY_FNS) {
+            if (name != def.m_name) {
+                continue;
+            }
+
+            if (args.size() != 1
+                || (def.m_float64_only && args[0].m_dtype != DTYPE_FLOAT64)) {
+                return false;
+            }
+
+            out = emit(t_vectorized_expression::OPCODE_UNARY_FN, slots, 0, def.m_fn);
+            return true;
+        }
+
+        return false;
+    }
+
+    const std::string& m_expression;
+    const std::vector<std::pair<std::string, std::string>>& m_column_ids;
+    t_vectorized_expression& m_rval;
+    t_uindex m_pos;
+    t_token m_token;
+};
+
+std::shared_ptr<t_vectorized_expression>
+t_vectorized_expression::lower(const std::string& parsed_expression_string,
+    const std::vector<std::pair<std::string, std::string>>& column_ids,
+    const std::vector<t_dtype>& input_dtypes) {
+    PSP_VERBOSE_ASSERT(
+        column_ids.size() == input_dtypes.size(), "Mismatched column ids and dtypes");
+
+    auto rval = std::make_shared<t_vectorized_expression>();
+    rval->m_input_dtypes = input_dtypes;
+    rval->m_num_slots = input_dtypes.size();
+    rval->m_result_slot = 0;
+
+    t_vectorized_lowering lowering(parsed_expression_string, column_ids, *rval);
+
+    if (!lowering.lower()) {
+        return nullptr;
+    }
+
+    return rval;
+}
+
+bool
+t_vectorized_expression::accepts(const std::vector<t_dtype>& input_dtypes) const {
+    return input_dtypes == m_input_dtypes;
+}
+
+void
+t_vectorized_expression::load(t_vectorized_block& block, t_uindex cidx,
+    const t_column* column, t_uindex offset, t_uindex num_rows) const {
+    if (num_rows == 0) {
+        return;
+    }
+
+    load_dtype(m_input_dtypes[cidx], block.m_values[cidx].data(),
+        block.m_valid[cidx].data(), column, offset, num_rows);
+}
+
+void
+t_vectorized_expression::load_row(t_vectorized_block& block, t_uindex cidx,
+    const t_column* column, t_uindex ridx, t_uindex bidx) const {
+    load_dtype(m_input_dtypes[cidx], block.m_values[cidx].data() + bidx,
+        block.m_valid[cidx].data() + bidx, column, ridx, 1);
+}
+
+void
+t_vectorized_expression::evaluate(t_vectorized_block& block, t_uindex num_rows) const {
+    std::uint8_t* fallback = block.m_fallback.data();
+    std::fill(fallback, fallback + num_rows, std::uint8_t(0));
+
+    for (const t_instruction& instruction : m_instructions) {
+        double* dst = block.m_values[instruction.m_dst].data();
+        std::uint8_t* dst_valid = block.m_valid[instruction.m_dst].data();
+
+        const std::vector<t_uindex>& args = instruction.m_args;
+        const double* a = args.size() > 0 ? block.m_values[args[0]].data() : nullptr;
+        const std::uint8_t* a_valid = args.size() > 0 ? block.m_valid[args[0]].data() : nullptr;
+        const double* b = args.size() > 1 ? block.m_values[args[1]].data() : nullptr;
+        const std::uint8_t* b_valid = args.size() > 1 ? block.m_valid[args[1]].data() : nullptr;
+
+        switch (instruction.m_opcode) {
+            case OPCODE_LITERAL: {
+                std::fill(dst, dst + num_rows, instruction.m_literal);
+                std::fill(dst_valid, dst_valid + num_rows, std::uint8_t(1));
+            } break;
+            case OPCODE_NEG: {
+                for (t_uindex idx = 0; idx < num_rows; ++idx) {
+                    dst[idx] = -a[idx];
+                    dst_valid[idx] = a_valid[idx];
+                }
+            } break;
+            case OPCODE_ADD: {
+                for (t_uindex idx = 0; idx < num_rows; ++idx) {
+                    dst[idx] = a[idx] + b[idx];
+                    dst_valid[idx] = a_valid[idx] & b_valid[idx];
+                }
+            } break;
+            case OPCODE_SUB: {
+                for (t_uindex idx = 0; idx < num_rows; ++idx) {
+                    dst[idx] = a[idx] - b[idx];
+                    dst_valid[idx] = a_valid[idx] & b_valid[idx];
+                }
+            } break;
+            case OPCODE_MUL: {
+                for (t_uindex idx = 0; idx < num_rows; ++idx) {
+                    dst[idx] = a[idx] * b[idx];
+                    dst_valid[idx] = a_valid[idx] & b_valid[idx];
+                }
+            } break;
+            case OPCODE_DIV: {
+                // Division by zero is null, not infinity.
+                for (t_uindex idx = 0; idx < num_rows; ++idx) {
+                    dst[idx] = a[idx] / b[idx];
+                    dst_valid[idx] = a_valid[idx] & b_valid[idx] & (b[idx] != 0);
+                }
+            } break;
+            case OPCODE_MOD: {
+                for (t_uindex idx = 0; idx < num_rows; ++idx) {
+                    dst[idx] = std::fmod(a[idx], b[idx]);
+                    dst_valid[idx] = a_valid[idx] & b_valid[idx] & (b[idx] != 0);
+                }
+            } break;
+            case OPCODE_LT:
+            case OPCODE_LTE:
+            case OPCODE_GT:
+            case OPCODE_GTE:
+            case OPCODE_EQ:
+            case OPCODE_NEQ: {
+                for (t_uindex idx = 0; idx < num_rows; ++idx) {
+                    double x = a[idx];
+                    double y = b[idx];
+                    bool result;
+
+                    switch (instruction.m_opcode) {
+                        case OPCODE_LT: result = x < y; break;
+                        case OPCODE_LTE: result = x <= y; break;
+                        case OPCODE_GT: result = x > y; break;
+                        case OPCODE_GTE: result = x >= y; break;
+                        case OPCODE_EQ: result = bits_equal(x, y); break;
+                        default: result = !bits_equal(x, y); break;
+                    }
+
+                    dst[idx] = result;
+                    dst_valid[idx] = 1;
+
+                    // `t_tscalar` orders null scalars by their status, which
+                    // is left to exprtk.
+                    fallback[idx] |= !(a_valid[idx] & b_valid[idx]);
+                }
+            } break;
+            case OPCODE_MIN:
+            case OPCODE_MAX: {
+                bool is_min = instruction.m_opcode == OPCODE_MIN;
+                std::copy(a, a + num_rows, dst);
+                std::copy(a_valid, a_valid + num_rows, dst_valid);
+
+                for (t_uindex aidx = 1, loop_end = args.size(); aidx < loop_end; ++aidx) {
+                    const double* v = block.m_values[args[aidx]].data();
+                    const std::uint8_t* v_valid = block.m_valid[args[aidx]].data();
+
+                    for (t_uindex idx = 0; idx < num_rows; ++idx) {
+                        bool replace = is_min ? v[idx] < dst[idx] : v[idx] > dst[idx];
+                        dst[idx] = replace ? v[idx] : dst[idx];
+                        dst_valid[idx] &= v_valid[idx];
+                    }
+                }
+            } break;
+            case OPCODE_PERCENT_OF: {
+                for (t_uindex idx = 0; idx < num_rows; ++idx) {
+                    dst[idx] = (a[idx] / b[idx]) * 100;
+                    dst_valid[idx] = a_valid[idx] & b_valid[idx] & (b[idx] != 0);
+                }
+            } break;
+            case OPCODE_IS_NULL: {
+                for (t_uindex idx = 0; idx < num_rows; ++idx) {
+                    dst[idx] = !a_valid[idx];
+                    dst_valid[idx] = 1;
+                }
+            } break;
+            case OPCODE_IS_NOT_NULL: {
+                for (t_uindex idx = 0; idx < num_rows; ++idx) {
+                    dst[idx] = a_valid[idx];
+                    dst_valid[idx] = 1;
+                }
+            } break;
+            case OPCODE_UNARY_FN: {
+                t_unary_fn fn = instruction.m_fn;
+                for (t_uindex idx = 0; idx < num_rows; ++idx) {
+                    dst[idx] = fn(a[idx]);
+                    dst_valid[idx] = a_valid[idx];
+                }
+            } break;
+        }
+    }
+}
+
+t_uindex
+t_vectorized_expression::num_slots() const {
+    return m_num_slots;
+}
+
+t_uindex
+t_vectorized_expression::get_result_slot() const {
+    return m_result_slot;
+}
+
+} // end namespace perspective
@@ -853,6 +853,12 @@ View<t_ctxunit>::get_step_delta(t_index bidx, t_index eidx) const {
     return t_stepdelta();
 }
 
+template <typename CTX_T>
+t_memory_report
+View<CTX_T>::get_memory_usage() const {
+    return m_ctx->get_memory_usage();
+}
+
 template <typename CTX_T>
 std::shared_ptr<t_data_slice<CTX_T>>
 View<CTX_T>::get_row_delta() const {
@@ -911,12 +917,14 @@ View<CTX_T>::_map_aggregate_types(
         if (agg.name() == name) {
             switch (agg.agg()) {
                 case AGGTYPE_DISTINCT_COUNT:
+                case AGGTYPE_APPROX_DISTINCT_COUNT:
                 case AGGTYPE_COUNT: {
                     return "integer";
                 } break;
                 case AGGTYPE_MEAN:
                 case AGGTYPE_MEAN_BY_COUNT:
                 case AGGTYPE_WEIGHTED_MEAN:
+                case AGGTYPE_APPROX_PERCENTILE:
                 case AGGTYPE_PCT_SUM_PARENT:
                 case AGGTYPE_PCT_SUM_GRAND_TOTAL: {
                     return "float";
@@ -252,6 +252,12 @@ t_view_config::fill_aggspecs(std::shared_ptr<t_schema> schema) {
             dependencies.push_back(t_dep("psp_okey", DEPTYPE_COLUMN));
             m_aggspecs.push_back(
                 t_aggspec(column, column, agg_type, dependencies, SORTTYPE_ASCENDING));
+        } else if (agg_type == AGGTYPE_PERCENTILE || agg_type == AGGTYPE_APPROX_PERCENTILE) {
+            m_aggspecs.push_back(t_aggspec(
+                column, agg_type, dependencies, str_to_quantile(aggregate.at(0))));
+        } else if (agg_type == AGGTYPE_APPROX_DISTINCT_COUNT) {
+            m_aggspecs.push_back(
+                t_aggspec(column, dependencies, str_to_hll_precision(aggregate.at(0))));
         } else {
             m_aggspecs.push_back(t_aggspec(column, agg_type, dependencies));
         }
@@ -293,7 +299,16 @@ t_view_config::fill_aggspecs(std::shared_ptr<t_schema> schema) {
                 agg_type = _get_default_aggregate(dtype);
             }
 
-            m_aggspecs.push_back(t_aggspec(column, agg_type, dependencies));
+            if (agg_type == AGGTYPE_PERCENTILE || agg_type == AGGTYPE_APPROX_PERCENTILE) {
+                m_aggspecs.push_back(t_aggspec(column, agg_type, dependencies,
+                    str_to_quantile(m_aggregates.at(column).at(0))));
+            } else if (agg_type == AGGTYPE_APPROX_DISTINCT_COUNT) {
+                m_aggspecs.push_back(t_aggspec(column, dependencies,
+                    str_to_hll_precision(m_aggregates.at(column).at(0))));
+            } else {
+                m_aggspecs.push_back(t_aggspec(column, agg_type, dependencies));
+            }
+
             m_aggregate_names.push_back(column);
         }
     }
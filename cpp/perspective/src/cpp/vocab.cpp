@@ -52,6 +52,12 @@ t_vocab::reserve(size_t total_string_size, size_t string_count) {
     rebuild_map();
 }
 
+void
+t_vocab::detach_pool() {
+    m_vlendata->detach_pool();
+    m_extents->detach_pool();
+}
+
 bool
 t_vocab::string_exists(const char* c, t_uindex& interned) const {
     auto iter = m_map.find(c);
@@ -63,6 +69,48 @@ t_vocab::string_exists(const char* c, t_uindex& interned) const {
     return true;
 }
 
+t_uindex
+t_vocab::compact(const std::vector<bool>& live, std::vector<t_uindex>& remap) {
+    typedef std::pair<t_uindex, t_uindex> t_extent;
+
+    remap.assign(m_vlenidx, 0);
+
+    // Strings only ever move towards the start of `m_vlendata`, so they
+    // can be compacted in place.
+    t_uindex vlen_size = 0;
+    t_uindex nidx = 0;
+
+    for (t_uindex idx = 0; idx < m_vlenidx; ++idx) {
+        if (!live[idx])
+            continue;
+
+        t_extent extent = *(m_extents->get_nth<t_extent>(idx));
+        t_uindex len = extent.second - extent.first;
+
+        if (extent.first != vlen_size) {
+            std::memmove(m_vlendata->get_ptr(vlen_size), m_vlendata->get_ptr(extent.first), len);
+        }
+
+        m_extents->set_nth<t_extent>(nidx, t_extent(vlen_size, vlen_size + len));
+        remap[idx] = nidx;
+        vlen_size += len;
+        ++nidx;
+    }
+
+    if (nidx == m_vlenidx) {
+        return 0;
+    }
+
+    t_uindex reclaimed = (m_vlendata->size() - vlen_size) + (m_vlenidx - nidx) * sizeof(t_extent);
+
+    m_vlendata->set_size(vlen_size);
+    m_extents->set_size(nidx * sizeof(t_extent));
+    m_vlenidx = nidx;
+    rebuild_map();
+
+    return reclaimed;
+}
+
 t_uindex
 t_vocab::get_interned(const char* s) {
 #ifdef PSP_COLUMN_VERIFY
@@ -197,6 +245,14 @@ t_vocab::clone(const t_vocab& v) {
     rebuild_map();
 }
 
+t_memory_usage
+t_vocab::get_memory_usage(const std::string& name) const {
+    t_memory_usage rval = perspective::get_memory_usage(name, *m_vlendata);
+    rval += perspective::get_memory_usage(name, *m_extents);
+    rval += get_hash_memory_usage(name, m_map);
+    return rval;
+}
+
 void
 t_vocab::set_vlenidx(t_uindex idx) {
     m_vlenidx = idx;
@@ -48,6 +48,20 @@ public:
         t_uindex agg_one_idx, t_uindex agg_two_idx, double agg_one_weight,
         double agg_two_weight);
 
+    /**
+     * @brief Construct an `AGGTYPE_PERCENTILE` or `AGGTYPE_APPROX_PERCENTILE`
+     * aggregate of `dependencies` at `quantile`, which is in [0, 1].
+     */
+    t_aggspec(const std::string& aggname, t_aggtype agg, const std::vector<t_dep>& dependencies,
+        double quantile);
+
+    /**
+     * @brief Construct an `AGGTYPE_APPROX_DISTINCT_COUNT` aggregate of
+     * `dependencies`, whose sketches have `2 ^ precision` registers.
+     */
+    t_aggspec(const std::string& aggname, const std::vector<t_dep>& dependencies,
+        std::uint8_t precision);
+
     std::string name() const;
     t_tscalar name_scalar() const;
     std::string disp_name() const;
@@ -62,6 +76,22 @@ public:
     double get_agg_one_weight() const;
     double get_agg_two_weight() const;
 
+    /**
+     * @brief Return the quantile selected by an order statistic or
+     * approximate percentile aggregate, 0.5 for `AGGTYPE_MEDIAN`.
+     *
+     * @return double
+     */
+    double get_quantile() const;
+
+    /**
+     * @brief Return the HyperLogLog precision of an approximate distinct
+     * count aggregate.
+     *
+     * @return std::uint8_t
+     */
+    std::uint8_t get_precision() const;
+
     t_invmode get_inv_mode() const;
 
     std::vector<std::string> get_input_depnames() const;
@@ -75,6 +105,26 @@ public:
 
     bool is_non_delta() const;
 
+    /**
+     * @brief Whether this aggregate selects a value by its rank amongst the
+     * values of a tree node, which the tree maintains from the values its
+     * strands add and remove rather than from their deltas.
+     *
+     * @return true
+     * @return false
+     */
+    bool is_order_statistic() const;
+
+    /**
+     * @brief Whether the tree keeps the values of this aggregate's first
+     * dependency under each node, as order statistics and aggregates of
+     * the distinct values do.
+     *
+     * @return true
+     * @return false
+     */
+    bool tracks_values() const;
+
     std::string get_first_depname() const;
 
 private:
@@ -88,6 +138,8 @@ private:
     t_uindex m_agg_two_idx;
     double m_agg_one_weight;
     double m_agg_two_weight;
+    double m_quantile;
+    std::uint8_t m_precision;
     t_invmode m_invmode;
     // t_uindex m_kernel;
 };
@@ -54,6 +54,50 @@ const t_index INVALID_INDEX = -1;
 #else
 #define PSP_PSORT std::sort
 #endif
+
+// Number of independent shards in a `t_pkey_map` - sharding only pays off
+// when shards can be written to concurrently.
+#ifdef PSP_PARALLEL_FOR
+const t_uindex PSP_PKEY_MAP_NUM_SHARDS = 16;
+#else
+const t_uindex PSP_PKEY_MAP_NUM_SHARDS = 1;
+#endif
+
+// Number of rows processed at a time by `t_gnode::_process_numeric_column`,
+// sized so that its block buffers stay small enough for the stack.
+const t_uindex PSP_PROCESS_COLUMN_BLOCK_SIZE = 256;
+
+// Number of rows evaluated at a time by `t_vectorized_expression`.
+const t_uindex PSP_EXPRESSION_BLOCK_SIZE = 1024;
+
+// Number of bytes a string column's vocabulary must grow by since it was
+// last compacted before `t_gstate` compacts it again - the vocabulary must
+// also have at least doubled in size.
+const t_uindex PSP_VOCAB_COMPACT_MIN_BYTES = 1 << 20;
+
+// Smallest and largest block sizes served from a `t_lstore_pool` size
+// class - larger stores are allocated directly and never retained.
+const t_uindex PSP_LSTORE_POOL_MIN_BYTES = 1 << 6;
+const t_uindex PSP_LSTORE_POOL_MAX_BYTES = 1 << 26;
+
+// Minimum number, and fraction, of the master table's rows that must be
+// free before `t_gstate` moves live rows into them and shrinks the table.
+const t_uindex PSP_ROW_COMPACT_MIN_FREE_ROWS = 1 << 12;
+const double PSP_ROW_COMPACT_MIN_FREE_RATIO = 0.5;
+
+// Identifies a table snapshot file, and the version of its layout, which
+// must be bumped whenever the layout changes.
+const std::uint64_t PSP_SNAPSHOT_MAGIC = 0x50414e5350535000; // "\0PSPSNAP"
+const std::uint32_t PSP_SNAPSHOT_VERSION = 1;
+
+// Size of the write buffer of a `t_snapshot_writer`
+const t_uindex PSP_SNAPSHOT_BUFFER_SIZE = 1 << 20;
+
+// Smallest step by which a `BACKING_STORE_DISK` store grows its file and
+// mapping - disk stores are sparse files, so a large step costs address
+// space rather than memory, and saves most `ftruncate`/`mremap` calls.
+const t_uindex PSP_DISK_STORE_MIN_GROWTH = 1 << 20;
+
 #define DEFAULT_CAPACITY 4000
 #define DEFAULT_CHUNK_SIZE 4000
 #define DEFAULT_EMPTY_CAPACITY 8
@@ -190,6 +234,10 @@ enum t_select_mode {
 
 enum t_backing_store { BACKING_STORE_MEMORY, BACKING_STORE_DISK };
 
+// How a `BACKING_STORE_DISK` store is expected to be read, passed on to the
+// OS as an `madvise` hint for its mapping.
+enum t_access_hint { ACCESS_HINT_NORMAL, ACCESS_HINT_SEQUENTIAL, ACCESS_HINT_RANDOM };
+
 enum t_filter_op {
     FILTER_OP_LT,
     FILTER_OP_LTEQ,
@@ -256,10 +304,34 @@ enum t_aggtype {
     AGGTYPE_DISTINCT_COUNT,
     AGGTYPE_DISTINCT_LEAF,
     AGGTYPE_PCT_SUM_PARENT,
-    AGGTYPE_PCT_SUM_GRAND_TOTAL
+    AGGTYPE_PCT_SUM_GRAND_TOTAL,
+    AGGTYPE_PERCENTILE,
+    AGGTYPE_APPROX_DISTINCT_COUNT,
+    AGGTYPE_APPROX_PERCENTILE
 };
 
 PERSPECTIVE_EXPORT t_aggtype str_to_aggtype(const std::string& str);
+
+/**
+ * @brief Return the quantile in [0, 1] of a percentile aggregate string such
+ * as `p90` or `p99.9`, or of an approximate percentile aggregate string,
+ * either `approx median` or `approx ` followed by a percentile, such as
+ * `approx p99`.
+ *
+ * @param str
+ * @return double
+ */
+PERSPECTIVE_EXPORT double str_to_quantile(const std::string& str);
+
+/**
+ * @brief Return the HyperLogLog precision of an approximate distinct count
+ * aggregate string, either `approx distinct count` or `hll` followed by the
+ * precision, such as `hll14`.
+ *
+ * @param str
+ * @return std::uint8_t
+ */
+PERSPECTIVE_EXPORT std::uint8_t str_to_hll_precision(const std::string& str);
 PERSPECTIVE_EXPORT t_aggtype _get_default_aggregate(t_dtype dtype);
 PERSPECTIVE_EXPORT std::string _get_default_aggregate_string(t_dtype dtype);
 
@@ -299,6 +371,9 @@ enum t_value_transition {
 
 enum t_gnode_type {
     GNODE_TYPE_PKEYED,         // Explicit user set pkey
+    GNODE_TYPE_APPEND_ONLY,    // Implicit row number pkey, rows are appended
+    GNODE_TYPE_RING            // Implicit row number pkey modulo a limit, rows
+                               // overwrite the oldest rows
 };
 
 enum t_gnode_port {
@@ -11,6 +11,7 @@
 #include <perspective/first.h>
 #include <perspective/base.h>
 #include <perspective/storage.h>
+#include <perspective/memory_usage.h>
 #include <perspective/exports.h>
 #include <perspective/scalar.h>
 
@@ -34,6 +35,8 @@ accessors!
 namespace perspective {
 
 class t_column;
+class t_snapshot_writer;
+class t_snapshot_reader;
 
 #ifdef PSP_COLUMN_VERIFY
 #define COLUMN_CHECK_ACCESS(idx) PSP_VERBOSE_ASSERT((idx) <= m_size, "Invalid column access")
@@ -98,9 +101,12 @@ public:
     template <typename T>
     const T* get_nth(t_uindex idx) const;
 
-    // idx is in items
+    // idx is in items, only for columns whose status is not packed
     const t_status* get_nth_status(t_uindex idx) const;
 
+    // idx is in items
+    t_status get_status(t_uindex idx) const;
+
     // idx is in items
     template <typename T>
     void set_nth(t_uindex idx, T v);
@@ -116,6 +122,12 @@ public:
 
     void reserve(t_uindex idx);
 
+    /**
+     * @brief Move every store of this column that was served from a
+     * `t_lstore_pool` to the system allocator, see `t_lstore::detach_pool`.
+     */
+    void detach_pool();
+
     //object storage
     template <typename T>
     void object_copied(std::uint64_t ptr) const;
@@ -144,6 +156,83 @@ public:
 
     bool is_status_enabled() const;
 
+    /**
+     * @brief Store the status of each row in two bitmaps instead of one
+     * `t_status` byte per row: an Arrow-compatible validity bitmap, where
+     * bit `i` of 64-bit word `i / 64` is set if row `i` is valid, and a
+     * bitmap of rows that are `STATUS_CLEAR`. Existing statuses are
+     * converted in place. The status API is unchanged, except for
+     * `get_nth_status` which requires unpacked statuses.
+     *
+     * @param packed
+     */
+    void set_status_packed(bool packed);
+
+    bool is_status_packed() const;
+
+    /**
+     * @brief Set the access hint of every store of this column, including
+     * its vocabulary and status stores.
+     *
+     * @param hint
+     */
+    void set_access_hint(t_access_hint hint);
+
+    /**
+     * @brief Return the memory of this column's `data`, `status` - both
+     * the status and cleared stores - and, for string columns, `vocab`.
+     *
+     * @return t_memory_report
+     */
+    t_memory_report get_memory_usage() const;
+
+    /**
+     * @brief Returns a word where bit `i` is set if row `offset + i` is
+     * valid, for `num_rows <= 64` rows. Rows of a column without status
+     * are always valid.
+     *
+     * @param offset
+     * @param num_rows
+     * @return std::uint64_t
+     */
+    std::uint64_t get_valid_word(t_uindex offset, t_uindex num_rows) const;
+
+    /**
+     * @brief Returns the number of valid rows in the column.
+     *
+     * @return t_uindex
+     */
+    t_uindex count_valid() const;
+
+    /**
+     * @brief Returns a mask with a bit set for each valid row, which can be
+     * combined with other masks of the same size.
+     *
+     * @return t_mask
+     */
+    t_mask get_valid_mask() const;
+
+    /**
+     * @brief Returns the validity bitmap of a column whose status is
+     * packed, which can be shared with Arrow as is.
+     *
+     * @return const std::uint64_t*
+     */
+    const std::uint64_t* get_validity_bitmap() const;
+
+    /**
+     * @brief Copy the status of `num_rows` rows of `other` from
+     * `src_offset` to the rows of this column from `dst_offset`, a word at
+     * a time where both columns are packed and the offsets line up.
+     *
+     * @param other
+     * @param src_offset
+     * @param dst_offset
+     * @param num_rows
+     */
+    void copy_status(
+        const t_column& other, t_uindex src_offset, t_uindex dst_offset, t_uindex num_rows);
+
     bool is_valid(t_uindex idx) const;
 
     bool is_cleared(t_uindex idx) const;
@@ -182,6 +271,14 @@ public:
 
     std::shared_ptr<t_column> clone(const t_mask& mask) const;
 
+    /**
+     * @brief Keep only the rows set in `mask`, moving them to the front of
+     * the column in place, and resize the column to `mask.count()`.
+     *
+     * @param mask
+     */
+    void retain(const t_mask& mask);
+
     void valid_raw_fill();
 
     template <typename DATA_T>
@@ -195,6 +292,24 @@ public:
 
     void unset(t_uindex idx);
 
+    /**
+     * @brief Copy the value and status of each row in `src` to the row at
+     * the same position in `dst`. The rows in `dst` must be distinct from
+     * the rows in `src`.
+     *
+     * @param src
+     * @param dst
+     */
+    void copy_rows(const std::vector<t_uindex>& src, const std::vector<t_uindex>& dst);
+
+    /**
+     * @brief Release capacity beyond `size` rows, which must not be less
+     * than the size of the column.
+     *
+     * @param size
+     */
+    void shrink(t_uindex size);
+
     void verify() const;
     void verify_size() const;
     void verify_size(t_uindex idx) const;
@@ -205,7 +320,51 @@ public:
 
     void borrow_vocabulary(const t_column& o);
 
+    /**
+     * @brief Remove strings that no row of this column refers to from its
+     * vocabulary, and rewrite the interned id of every row to match the
+     * compacted vocabulary. Any column that borrows this column's
+     * vocabulary holds stale ids until it is rewritten.
+     *
+     * @return t_uindex the number of bytes reclaimed.
+     */
+    t_uindex compact_vocabulary();
+
+    /**
+     * @brief Compact the vocabulary as above, filling `remap` with the new
+     * id of each old id that is still in use. `remap` is left empty if
+     * nothing was reclaimed.
+     *
+     * @param remap
+     * @return t_uindex
+     */
+    t_uindex compact_vocabulary(std::vector<t_uindex>& remap);
+
+    /**
+     * @brief Write the dtype, size, data, status and vocabulary of this
+     * column to a snapshot. `DTYPE_OBJECT` columns hold pointers, and
+     * cannot be written.
+     *
+     * @param writer
+     */
+    void save(t_snapshot_writer& writer) const;
+
+    /**
+     * @brief Replace the contents of this column with a column written by
+     * `save`, which must have the same dtype and status mode.
+     *
+     * @param reader
+     */
+    void load(t_snapshot_reader& reader);
+
 private:
+    // Size in bytes of the status of `num_rows` rows
+    t_uindex status_nbytes(t_uindex num_rows) const;
+
+    void resize_status(t_uindex num_rows);
+    void push_status(t_uindex idx, t_status status);
+    void fill_status(const t_column& other);
+
     t_dtype m_dtype;
     bool m_init;
     bool m_isvlen;
@@ -216,13 +375,19 @@ private:
 
     std::shared_ptr<t_vocab> m_vocab;
 
-    // Missing value support
+    // Missing value support - one `t_status` per row, or the validity
+    // bitmap if the status is packed
     std::shared_ptr<t_lstore> m_status;
 
+    // Bitmap of `STATUS_CLEAR` rows if the status is packed
+    std::shared_ptr<t_lstore> m_cleared;
+
     t_uindex m_size;
 
     bool m_status_enabled;
 
+    bool m_status_packed;
+
     bool m_from_recipe;
 
     std::uint32_t m_elemsize;
@@ -283,6 +448,35 @@ t_column::get_nth(t_uindex idx) const {
     return m_data->get_nth<T>(idx);
 }
 
+inline t_status
+t_column::get_status(t_uindex idx) const {
+    COLUMN_CHECK_ACCESS(idx);
+    if (!m_status_packed) {
+        return *(m_status->get_nth<t_status>(idx));
+    }
+
+    std::uint64_t bit = std::uint64_t(1) << (idx & 63);
+    if (*(m_status->get_nth<std::uint64_t>(idx >> 6)) & bit)
+        return STATUS_VALID;
+    if (*(m_cleared->get_nth<std::uint64_t>(idx >> 6)) & bit)
+        return STATUS_CLEAR;
+    return STATUS_INVALID;
+}
+
+inline void
+t_column::set_status(t_uindex idx, t_status status) {
+    if (!m_status_packed) {
+        m_status->set_nth<t_status>(idx, status);
+        return;
+    }
+
+    std::uint64_t bit = std::uint64_t(1) << (idx & 63);
+    std::uint64_t* valid = m_status->get_nth<std::uint64_t>(idx >> 6);
+    std::uint64_t* cleared = m_cleared->get_nth<std::uint64_t>(idx >> 6);
+    *valid = status == STATUS_VALID ? (*valid | bit) : (*valid & ~bit);
+    *cleared = status == STATUS_CLEAR ? (*cleared | bit) : (*cleared & ~bit);
+}
+
 template <typename T>
 T*
 t_column::extend() {
@@ -309,7 +503,7 @@ void
 t_column::push_back(DATA_T elem, t_status status) {
     PSP_VERBOSE_ASSERT(is_status_enabled(), "Validity not enabled for column");
     m_data->push_back(elem);
-    m_status->push_back(status);
+    push_status(m_data->size() / sizeof(DATA_T) - 1, status);
     ++m_size;
 }
 
@@ -322,7 +516,7 @@ t_column::set_nth(t_uindex idx, T v) {
     m_data->set_nth<T>(idx, v);
 
     if (is_status_enabled()) {
-        m_status->set_nth<t_status>(idx, STATUS_VALID);
+        set_status(idx, STATUS_VALID);
     }
 }
 
@@ -333,7 +527,7 @@ t_column::set_nth(t_uindex idx, T v, t_status status) {
     m_data->set_nth<T>(idx, v);
 
     if (is_status_enabled()) {
-        m_status->set_nth<t_status>(idx, status);
+        set_status(idx, status);
     }
 }
 
@@ -363,7 +557,7 @@ t_column::set_nth_body(t_uindex idx, DATA_T elem, t_status status) {
     m_data->set_nth<t_uindex>(idx, interned);
 
     if (is_status_enabled()) {
-        m_status->set_nth<t_status>(idx, status);
+        set_status(idx, status);
     }
 }
 
@@ -411,7 +605,7 @@ t_column::copy_helper(
 
     if (is_status_enabled() && other->is_status_enabled()) {
         for (t_uindex idx = 0; idx < eidx; ++idx) {
-            set_status(idx + offset, *other->get_nth_status(indices[idx]));
+            set_status(idx + offset, other->get_status(indices[idx]));
         }
     }
     COLUMN_CHECK_VALUES();
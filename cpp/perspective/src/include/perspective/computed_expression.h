@@ -17,8 +17,10 @@
 #include <perspective/data_table.h>
 #include <perspective/rlookup.h>
 #include <perspective/computed_function.h>
+#include <perspective/vectorized_expression.h>
 #include <date/date.h>
 #include <tsl/hopscotch_set.h>
+#include <mutex>
 
 // a header that includes exprtk and overload definitions for `t_tscalar` so
 // it can be used inside exprtk.
@@ -26,6 +28,44 @@
 
 namespace perspective {
 
+/**
+ * @brief The compiled form of a `t_computed_expression`, which is kept
+ * between calls to `compute` and `recompute` so that the expression is only
+ * parsed and compiled once. The compiled expression holds references to the
+ * symbol table, the stateful function instances and the variable slots in
+ * `m_values`, so they live together in one heap-allocated object - a call
+ * to `compute` or `recompute` only writes new values into the slots.
+ */
+struct PERSPECTIVE_EXPORT t_compiled_expression {
+    t_compiled_expression(std::shared_ptr<t_vocab> expression_vocab,
+        const std::vector<std::pair<std::string, std::string>>& column_ids);
+
+    PSP_NON_COPYABLE(t_compiled_expression);
+
+    computed_function::day_of_week m_day_of_week_fn;
+    computed_function::month_of_year m_month_of_year_fn;
+    computed_function::intern m_intern_fn;
+    computed_function::concat m_concat_fn;
+    computed_function::order m_order_fn;
+    computed_function::upper m_upper_fn;
+    computed_function::lower m_lower_fn;
+    computed_function::length m_length_fn;
+
+    exprtk::symbol_table<t_tscalar> m_sym_table;
+    exprtk::expression<t_tscalar> m_expression;
+
+    // One variable slot per input column, in the order of `column_ids` -
+    // the vector is never resized, as the symbol table holds references to
+    // its elements.
+    std::vector<t_tscalar> m_values;
+
+    // The expression lowered into vectorized kernels, which is `nullptr` if
+    // it could not be lowered. Lowering is attempted once, on first use,
+    // when the input column dtypes are known.
+    bool m_lowered;
+    std::shared_ptr<t_vectorized_expression> m_vectorized;
+};
+
 /**
  * @brief Contains the metadata for a single expression and the methods which
  * will compute the expression's output.
@@ -43,6 +83,16 @@ public:
         const std::vector<std::pair<std::string, std::string>>& column_ids,
         t_dtype dtype);
 
+    /**
+     * @brief Copy the expression's metadata. The copy does not share the
+     * compiled expression, and compiles its own on first use.
+     */
+    t_computed_expression(const t_computed_expression& other);
+    t_computed_expression& operator=(const t_computed_expression& other);
+
+    t_computed_expression(t_computed_expression&& other) = default;
+    t_computed_expression& operator=(t_computed_expression&& other) = default;
+
     /**
      * @brief Compute this expression and add the output column to
      * `data_table.`
@@ -60,6 +110,12 @@ public:
         std::shared_ptr<t_data_table> flattened,
         const std::vector<t_rlookup>& changed_rows) const;
 
+    /**
+     * @brief Set the vocab that string outputs are interned into, which
+     * invalidates the compiled expression.
+     *
+     * @param vocab
+     */
     void set_expression_vocab(std::shared_ptr<t_vocab> vocab);
 
     const std::string& get_expression_alias() const;
@@ -69,12 +125,37 @@ public:
     t_dtype get_dtype() const;
 
 private:
+    /**
+     * @brief Return the compiled expression, parsing and compiling
+     * `m_parsed_expression_string` on the first call. `caller` is used in
+     * the error message if compilation fails.
+     *
+     * @param caller
+     * @return t_compiled_expression&
+     */
+    t_compiled_expression& get_compiled_expression(const char* caller) const;
+
+    /**
+     * @brief Return the vectorized form of the compiled expression for input
+     * columns of `input_dtypes`, or `nullptr` if the expression must be
+     * evaluated row by row through exprtk.
+     *
+     * @param compiled
+     * @param input_dtypes
+     * @return const t_vectorized_expression*
+     */
+    const t_vectorized_expression* get_vectorized_expression(
+        t_compiled_expression& compiled, const std::vector<t_dtype>& input_dtypes) const;
+
     std::string m_expression_alias;
     std::string m_expression_string;
     std::string m_parsed_expression_string;
     std::vector<std::pair<std::string, std::string>> m_column_ids;
     std::shared_ptr<t_vocab> m_expression_vocab;
     t_dtype m_dtype;
+
+    // Compiled lazily under the parser mutex, and owned by this copy only.
+    mutable std::unique_ptr<t_compiled_expression> m_compiled_expression;
 };
 
 class PERSPECTIVE_EXPORT t_computed_expression_parser {
@@ -135,6 +216,10 @@ public:
 
     static std::shared_ptr<exprtk::parser<t_tscalar>> PARSER;
 
+    // Guards `PARSER` when expressions are compiled while gnodes are
+    // processed concurrently.
+    static std::mutex PARSER_MUTEX;
+
     // Instances of Exprtk functions
     static computed_function::bucket BUCKET_FN;
     static computed_function::hour_of_day HOUR_OF_DAY_FN;
@@ -77,6 +77,14 @@ t_dtype get_column_dtype(t_uindex idx) const;
 
 std::shared_ptr<t_data_table> get_table() const;
 
+/**
+ * @brief Return the memory held by this context - its trees, traversals and
+ * sort index - but not by the `t_gstate` it reads from.
+ *
+ * @return t_memory_report
+ */
+t_memory_report get_memory_usage() const;
+
 // Unity api
 std::vector<t_tscalar> unity_get_row_data(t_uindex idx) const;
 std::vector<t_tscalar> unity_get_column_data(t_uindex idx) const;
@@ -29,6 +29,14 @@ public:
 
     ~t_ctx2();
 
+    /**
+     * @brief Apply the rows that one update evicted from and appended to a
+     * ring buffer master table.
+     *
+     * @param step
+     */
+    void notify(const t_ring_step& step);
+
     t_index open(t_header header, t_index idx);
     t_index close(t_header header, t_index idx);
 
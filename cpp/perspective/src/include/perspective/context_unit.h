@@ -68,6 +68,14 @@ public:
     void notify(const t_data_table& flattened, const t_data_table& delta, const t_data_table& prev,
         const t_data_table& current, const t_data_table& transitions, const t_data_table& existed);
 
+    /**
+     * @brief Apply the rows that one update evicted from and appended to a
+     * ring buffer master table.
+     *
+     * @param step
+     */
+    void notify(const t_ring_step& step);
+
     void step_begin();
 
     void step_end();
@@ -101,6 +109,8 @@ public:
 
     bool has_deltas() const;
 
+    t_memory_report get_memory_usage() const;
+
     void pprint() const;
 
     t_dtype get_column_dtype(t_uindex idx) const;
@@ -32,6 +32,14 @@ public:
     ~t_ctx0();
 #include <perspective/context_common_decls.h>
 
+    /**
+     * @brief Apply the rows that one update evicted from and appended to a
+     * ring buffer master table.
+     *
+     * @param step
+     */
+    void notify(const t_ring_step& step);
+
     t_tscalar get_column_name(t_index idx);
 
     std::vector<std::string> get_column_names() const;
@@ -101,6 +101,9 @@ public:
     // Only increment capacity
     void reserve(t_uindex nelems);
 
+    // Only decrement capacity, to no less than the size of the table
+    void shrink(t_uindex nelems);
+
     // Increment capacity and size
     void extend(t_uindex nelems);
 
@@ -110,6 +113,15 @@ public:
 
     std::shared_ptr<t_data_table> flatten() const;
 
+    /**
+     * @brief Whether the rows of this table are already in the order that
+     * `flatten` writes them: `OP_INSERT`s with valid, strictly increasing
+     * primary keys.
+     *
+     * @return bool
+     */
+    bool is_flat() const;
+
     bool is_pkey_table() const;
     bool is_same_shape(t_data_table& tbl) const;
 
@@ -139,6 +151,44 @@ public:
     std::shared_ptr<t_data_table> borrow(
         const std::vector<std::string>& columns) const;
 
+    /**
+     * @brief Return a table over the same columns as this table, without
+     * copying them. Both tables mark the columns as shared, and `append`,
+     * `clear`, `reset`, `retain` and `drop_column` replace a shared column
+     * instead of writing to it. Writes through column pointers are not
+     * copied, so only share a table that is read until it is cleared.
+     *
+     * @return std::shared_ptr<t_data_table>
+     */
+    std::shared_ptr<t_data_table> share() const;
+
+    /**
+     * @brief Replace the columns of this empty table with the columns of
+     * `other` without copying them, if `other` has the same columns with
+     * the same dtypes. The columns are shared as in `share`.
+     *
+     * @param other
+     * @return bool whether the columns were shared
+     */
+    bool share_columns(const t_data_table& other);
+
+    /**
+     * @brief Return a column for another table to take over, marking it as
+     * shared so that this table no longer writes to it.
+     *
+     * @param colname
+     * @return std::shared_ptr<t_column>
+     */
+    std::shared_ptr<t_column> share_column(const std::string& colname) const;
+
+    /**
+     * @brief Keep only the rows set in `mask`, moving them to the front of
+     * each column in place. Shared columns are replaced by masked clones.
+     *
+     * @param mask
+     */
+    void retain(const t_mask& mask);
+
     t_column* clone_column(
         const std::string& existing_col, const std::string& new_colname);
 
@@ -184,6 +234,31 @@ public:
     void verify() const;
     void set_capacity(t_uindex idx);
 
+    /**
+     * @brief Allocate the stores of columns created after this call from
+     * `pool`. Tables flattened from this table share its pool.
+     *
+     * @param pool
+     */
+    void set_lstore_pool(std::shared_ptr<t_lstore_pool> pool);
+
+    /**
+     * @brief Set how the stores of this table's columns, and of columns
+     * created after this call, are expected to be read. Only affects tables
+     * on `BACKING_STORE_DISK`.
+     *
+     * @param hint
+     */
+    void set_access_hint(t_access_hint hint);
+
+    /**
+     * @brief Return the memory of each column of this table, under the
+     * column's name.
+     *
+     * @return t_memory_report
+     */
+    t_memory_report get_memory_usage() const;
+
     std::vector<t_tscalar> get_scalvec() const;
     std::shared_ptr<t_column> operator[](const std::string& name);
 
@@ -197,17 +272,39 @@ protected:
     template <typename DATA_T, typename ROWPACK_VEC_T>
     void flatten_helper_2(ROWPACK_VEC_T& sorted, std::vector<t_flatten_record>& fltrecs,
         const t_column* scol, t_column* dcol) const;
+
+    template <typename PKEY_T>
+    bool is_flat_helper() const;
+
     std::string repr() const;
 
 private:
+    bool is_column_shared(t_uindex idx) const;
+
+    /**
+     * @brief Stop sharing the column at `idx` before writing to it, by
+     * replacing it with a clone if `copy` is true, or an empty column if not.
+     *
+     * @param idx
+     * @param copy
+     */
+    void detach_column(t_uindex idx, bool copy);
+
     std::string m_name;
     std::string m_dirname;
     t_schema m_schema;
     t_uindex m_size;
     t_uindex m_capacity;
     t_backing_store m_backing_store;
+    t_access_hint m_access_hint;
     bool m_init;
     std::vector<std::shared_ptr<t_column>> m_columns;
+
+    // Non-zero for each column shared with another table - marked by const
+    // methods that hand out columns, and one byte per column so that columns
+    // can be marked from parallel loops.
+    mutable std::vector<std::uint8_t> m_shared;
+    std::shared_ptr<t_lstore_pool> m_lstore_pool;
 };
 
 PERSPECTIVE_EXPORT bool operator==(const t_data_table& lhs, const t_data_table& rhs);
@@ -271,6 +368,24 @@ t_data_table::flatten_body(FLATTENED_T flattened) const {
     return;
 }
 
+template <typename PKEY_T>
+bool
+t_data_table::is_flat_helper() const {
+    const t_column* pkey_col = get_const_column("psp_pkey").get();
+    const t_column* op_col = get_const_column("psp_op").get();
+    const PKEY_T* pkey_base = pkey_col->get_nth<PKEY_T>(0);
+    const std::uint8_t* op_base = op_col->get_nth<std::uint8_t>(0);
+
+    for (t_uindex idx = 0, loop_end = size(); idx < loop_end; ++idx) {
+        if (op_base[idx] != OP_INSERT || !pkey_col->is_valid(idx)
+            || (idx > 0 && !(pkey_base[idx - 1] < pkey_base[idx]))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 template <typename DATA_T, typename ROWPACK_VEC_T>
 void
 t_data_table::flatten_helper_2(ROWPACK_VEC_T& sorted, std::vector<t_flatten_record>& fltrecs,
@@ -282,7 +397,7 @@ t_data_table::flatten_helper_2(ROWPACK_VEC_T& sorted, std::vector<t_flatten_reco
         for (t_index spanidx = rec.m_eidx - 1; spanidx >= t_index(rec.m_bidx); --spanidx) {
             const auto& sort_rec = sorted[spanidx];
             fragidx = sort_rec.m_idx;
-            status = *(scol->get_nth_status(fragidx));
+            status = scol->get_status(fragidx);
             if (status != STATUS_INVALID) {
                 added = true;
                 break;
@@ -13,6 +13,7 @@
 #include <perspective/raw_types.h>
 #include <perspective/comparators.h>
 #include <perspective/mask.h>
+#include <perspective/column.h>
 #include <perspective/scalar.h>
 #include <perspective/exports.h>
 #include <boost/scoped_ptr.hpp>
@@ -163,6 +164,61 @@ struct PERSPECTIVE_EXPORT t_fterm {
     bool m_use_interned;
 };
 
+/**
+ * @brief A `t_fterm` bound to the column it filters, which evaluates the term
+ * for a block of rows at a time into the bits of a `t_mask::t_block`.
+ *
+ * Comparisons on numeric, date, time and boolean columns against a threshold
+ * of the column's dtype read the column buffer directly, `EQ`/`NE`/`IN`/
+ * `NOT_IN` on string columns compare vocab ids, and `IS_NULL`/`IS_NOT_NULL`
+ * read the status buffer. Any other term is evaluated on `t_tscalar`.
+ */
+class PERSPECTIVE_EXPORT t_fterm_kernel {
+public:
+    t_fterm_kernel(const t_fterm& fterm, t_column* column);
+
+    /**
+     * @brief Set bit `i` of the returned block if row `offset + i` passes the
+     * term, for `num_rows <= t_mask::BITS_PER_BLOCK` rows. A row passes if
+     * its cell is valid and the term holds, except for `FILTER_OP_IS_NULL`
+     * which does not require a valid cell.
+     *
+     * @param offset
+     * @param num_rows
+     * @return t_mask::t_block
+     */
+    t_mask::t_block evaluate(t_uindex offset, t_uindex num_rows) const;
+
+private:
+    enum t_kernel_type { KERNEL_SCALAR, KERNEL_VALUE, KERNEL_STATUS, KERNEL_VOCAB };
+
+    template <typename DATA_T>
+    t_mask::t_block evaluate_value(t_uindex offset, t_uindex num_rows) const;
+
+    t_mask::t_block evaluate_status(t_uindex offset, t_uindex num_rows) const;
+    t_mask::t_block evaluate_vocab(t_uindex offset, t_uindex num_rows) const;
+    t_mask::t_block evaluate_scalar(t_uindex offset, t_uindex num_rows) const;
+
+    // Bit `i` is set if row `offset + i` is valid
+    t_mask::t_block get_valid_block(t_uindex offset, t_uindex num_rows) const;
+
+    bool in_bag(std::uint64_t bits) const;
+
+    t_fterm m_fterm;
+    t_column* m_column;
+    t_kernel_type m_type;
+    t_dtype m_dtype;
+
+    // The raw bits of the threshold, or the vocab id of a string threshold
+    std::uint64_t m_threshold_bits;
+
+    // Whether a string threshold exists in the column's vocab
+    bool m_threshold_exists;
+
+    // The raw bits, or vocab ids, of the bag elements a valid cell can match
+    std::vector<std::uint64_t> m_bag_bits;
+};
+
 class PERSPECTIVE_EXPORT t_filter {
 public:
     t_filter();
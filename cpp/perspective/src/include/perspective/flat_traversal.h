@@ -84,6 +84,15 @@ public:
     std::vector<t_sortspec> get_sort_by() const;
     bool empty_sort_by() const;
 
+    /**
+     * @brief Return the memory of the sorted rows of the traversal as
+     * `sort_index`, including the sort keys of each row, and of its lookup
+     * from primary key to row as `pkey_index`.
+     *
+     * @return t_memory_report
+     */
+    t_memory_report get_memory_usage() const;
+
     void reset_step_state();
 
     t_uindex lower_bound_row_idx(std::shared_ptr<const t_gstate> gstate, const t_config& config,
@@ -90,6 +90,43 @@ public:
      * @param output_schema 
      */
     t_gnode(const t_schema& input_schema, const t_schema& output_schema);
+
+    /**
+     * @brief Construct a new `t_gnode` of `gnode_type`.
+     *
+     * A `GNODE_TYPE_APPEND_ONLY` gnode is used for `Table`s without an
+     * explicit index, whose primary keys are their row numbers. Updates that
+     * only add new rows are appended to the master table directly, skipping
+     * the primary key lookups and transitional tables - any other update
+     * falls back to the `GNODE_TYPE_PKEYED` process, after which all updates
+     * are processed as `GNODE_TYPE_PKEYED`.
+     *
+     * @param input_schema
+     * @param output_schema
+     * @param gnode_type
+     */
+    t_gnode(const t_schema& input_schema, const t_schema& output_schema,
+        t_gnode_type gnode_type);
+
+    /**
+     * @brief Construct a new `t_gnode` of `gnode_type` for a `Table` that
+     * holds at most `limit` rows.
+     *
+     * A `GNODE_TYPE_RING` gnode is used for `Table`s with a `limit` and
+     * without an explicit index, whose primary key is the row number modulo
+     * `limit`. The master table is a ring buffer of `limit` slots - updates
+     * that write the next slots in order overwrite them in place, and
+     * contexts are notified of the rows each one evicted and appended
+     * rather than of a set of transitions. Any other update falls back to
+     * the `GNODE_TYPE_PKEYED` process.
+     *
+     * @param input_schema
+     * @param output_schema
+     * @param gnode_type
+     * @param limit
+     */
+    t_gnode(const t_schema& input_schema, const t_schema& output_schema,
+        t_gnode_type gnode_type, t_uindex limit);
     ~t_gnode();
 
     void init();
@@ -114,6 +151,16 @@ public:
      */
     bool process(t_uindex port_id);
 
+    /**
+     * @brief Equivalent to `process`, but may be called from any thread, as
+     * it does not release the GIL - in Python, the caller must release it
+     * on the event loop thread first. Used to process independent gnodes
+     * concurrently.
+     *
+     * @param port_id
+     */
+    bool _process(t_uindex port_id);
+
     /**
      * @brief Create a new input port, store it in `m_input_ports`, and
      * return the integer ID that references the new port.
@@ -178,6 +225,69 @@ public:
     void clear_input_ports();
     void clear_output_ports();
 
+    /**
+     * @brief Return how many bytes the stores of this gnode's transient
+     * tables have reused from, and newly allocated into, its `t_lstore_pool`.
+     *
+     * @return t_lstore_pool_stats
+     */
+    t_lstore_pool_stats get_lstore_pool_stats() const;
+
+    /**
+     * @brief Return how many bytes compacting the vocabularies of the
+     * master table has reclaimed over the lifetime of this gnode.
+     *
+     * @return t_uindex
+     */
+    t_uindex get_vocab_bytes_reclaimed() const;
+
+    /**
+     * @brief Move live rows of the master table into the rows freed by
+     * removes, see `t_gstate::compact_rows`. A no-op while a unit context
+     * is registered, as it reads the master table in row order.
+     *
+     * @param force compact regardless of how many rows are free.
+     * @return t_uindex the number of free rows reclaimed.
+     */
+    t_uindex compact_rows(bool force = false);
+
+    /**
+     * @brief Write the state of this gnode to a snapshot, see
+     * `t_gstate::save_snapshot`.
+     *
+     * @param writer
+     */
+    void save_snapshot(t_snapshot_writer& writer) const;
+
+    /**
+     * @brief Restore the state of this gnode from a snapshot. The gnode
+     * must be empty, and have no registered contexts.
+     *
+     * @param reader
+     */
+    void load_snapshot(t_snapshot_reader& reader);
+
+    /**
+     * @brief Move the master table to `backing_store`, see
+     * `t_gstate::set_backing_store`. The gnode must have no registered
+     * contexts.
+     *
+     * @param backing_store
+     * @param dirname
+     * @param access_hint
+     */
+    void set_backing_store(
+        t_backing_store backing_store, const std::string& dirname, t_access_hint access_hint);
+
+    /**
+     * @brief Return the memory of the master table, see
+     * `t_gstate::get_memory_usage`, and the bytes retained by the
+     * `t_lstore_pool` of the transient tables as `lstore_pool`.
+     *
+     * @return t_memory_report
+     */
+    t_memory_report get_memory_usage() const;
+
     t_data_table* _get_pkeyed_table() const;
     std::shared_ptr<t_data_table> get_pkeyed_table_sptr() const;
     std::shared_ptr<t_data_table> get_sorted_pkeyed_table() const;
@@ -219,6 +329,23 @@ protected:
      */
     void _update_contexts_from_state(std::shared_ptr<t_data_table> tbl);
 
+    /**
+     * @brief Notify each registered context that the rows in `tbl` were
+     * appended to the master table. Unlike `_update_contexts_from_state`,
+     * contexts are not reset first.
+     *
+     * @param tbl
+     */
+    void _notify_contexts_appended(std::shared_ptr<t_data_table> tbl);
+
+    /**
+     * @brief Notify each registered context of the rows that one update
+     * evicted from and appended to a ring buffer master table.
+     *
+     * @param step
+     */
+    void _notify_contexts_ring(const t_ring_step& step);
+
     /**
      * @brief Notify a single registered `ctx` with `tbl`.
      * 
@@ -285,6 +412,29 @@ protected:
     void _process_column(const t_column* fcolumn, const t_column* scolumn, t_column* dcolumn,
         t_column* pcolumn, t_column* ccolumn, t_column* tcolumn, const t_process_state& process_state);
 
+    /**
+     * @brief Equivalent to `_process_column` for fixed-width numeric columns,
+     * processing rows in blocks of `PSP_PROCESS_COLUMN_BLOCK_SIZE`: previous
+     * values are gathered from the master column by row index into a
+     * contiguous buffer, deltas, current values and equality are then
+     * computed over the whole block in branch-free loops the compiler can
+     * vectorize, and transitions are read from a table of every result of
+     * `calc_transition`. Must not be used for `DTYPE_OBJECT` columns.
+     *
+     * @tparam DATA_T
+     * @param fcolumn
+     * @param scolumn
+     * @param dcolumn
+     * @param pcolumn
+     * @param ccolumn
+     * @param tcolumn
+     * @param process_state
+     */
+    template <typename DATA_T>
+    void _process_numeric_column(const t_column* fcolumn, const t_column* scolumn,
+        t_column* dcolumn, t_column* pcolumn, t_column* ccolumn, t_column* tcolumn,
+        const t_process_state& process_state);
+
     /**
      * @brief Calculate the transition state for a single cell, which depends
      * on whether the cell is/was valid, existed, or is new.
@@ -338,9 +488,54 @@ private:
      */
     t_process_table_result _process_table(t_uindex port_id);
 
+    /**
+     * @brief Append the table at `input_port`, which contains only new rows,
+     * to the master table with bulk copies, and notify contexts of the
+     * added rows.
+     *
+     * @param input_port
+     * @return t_process_table_result
+     */
+    t_process_table_result _process_appended_table(std::shared_ptr<t_port>& input_port);
+
+    /**
+     * @brief Write the table at `input_port`, which writes the next slots
+     * of a `GNODE_TYPE_RING` master table, in place, and notify contexts of
+     * the evicted and appended rows.
+     *
+     * @param input_port
+     * @return t_process_table_result
+     */
+    t_process_table_result _process_ring_table(std::shared_ptr<t_port>& input_port);
+
+    /**
+     * @brief Returns whether updates can be processed by
+     * `_process_ring_table`, i.e. the schema has no `DTYPE_OBJECT` columns,
+     * whose reference counts are maintained in `_process_column`, and no
+     * registered context requires the transitional tables themselves.
+     *
+     * @return true
+     * @return false
+     */
+    bool _supports_ring_process() const;
+
+    /**
+     * @brief Returns whether the `delta`, `prev`, `current` and `transitions`
+     * tables need to be written in `_process_table`, i.e. whether any
+     * registered context reads them, or the schema has `DTYPE_OBJECT`
+     * columns whose reference counts are maintained in `_process_column`.
+     *
+     * @return true
+     * @return false
+     */
+    bool _requires_transitional_tables() const;
+
     t_gnode_processing_mode m_mode;
     t_gnode_type m_gnode_type;
 
+    // The number of slots of a `GNODE_TYPE_RING` master table.
+    t_uindex m_limit;
+
     // A `t_schema` containing all columns, including internal metadata columns.
     t_schema m_input_schema;
 
@@ -371,9 +566,11 @@ private:
     std::vector<std::shared_ptr<t_port>> m_oports;
     std::map<std::string, t_ctx_handle> m_contexts;
     std::shared_ptr<t_gstate> m_gstate;
+    std::shared_ptr<t_lstore_pool> m_lstore_pool;
     std::chrono::high_resolution_clock::time_point m_epoch;
     std::function<void()> m_pool_cleanup;
     bool m_was_updated;
+    t_uindex m_vocab_bytes_reclaimed;
 
 #ifdef PSP_ENABLE_PYTHON
     std::thread::id m_event_loop_thread_id;
@@ -576,4 +773,135 @@ t_gnode::_process_column(
     }
 }
 
+template <typename DATA_T>
+void
+t_gnode::_process_numeric_column(
+    const t_column* fcolumn,
+    const t_column* scolumn,
+    t_column* dcolumn,
+    t_column* pcolumn,
+    t_column* ccolumn,
+    t_column* tcolumn,
+    const t_process_state& process_state) {
+    PSP_VERBOSE_ASSERT(fcolumn->get_dtype() != DTYPE_OBJECT, "Object columns must use _process_column");
+
+    t_uindex num_rows = fcolumn->size();
+
+    if (num_rows == 0 || dcolumn->size() == 0)
+        return;
+
+    // The transition only depends on these flags, so look them up instead
+    // of branching through `calc_transition` for every row.
+    enum {
+        FLAG_ROW_PRE_EXISTED = 1,
+        FLAG_PREV_VALID = 2,
+        FLAG_CUR_VALID = 4,
+        FLAG_PREV_CUR_EQ = 8,
+        FLAG_PREV_PKEY_EQ = 16,
+        NUM_FLAGS = 32
+    };
+
+    std::uint8_t transition_table[NUM_FLAGS];
+    for (std::uint8_t key = 0; key < NUM_FLAGS; ++key) {
+        bool row_pre_existed = key & FLAG_ROW_PRE_EXISTED;
+        bool prev_valid = key & FLAG_PREV_VALID;
+        bool cur_valid = key & FLAG_CUR_VALID;
+        transition_table[key] = calc_transition(row_pre_existed && prev_valid,
+            row_pre_existed, cur_valid, prev_valid, cur_valid, key & FLAG_PREV_CUR_EQ,
+            key & FLAG_PREV_PKEY_EQ);
+    }
+
+    const DATA_T* fbase = fcolumn->get_nth<DATA_T>(0);
+    const DATA_T* sbase = scolumn->get_nth<DATA_T>(0);
+    DATA_T* dbase = dcolumn->get_nth<DATA_T>(0);
+    DATA_T* pbase = pcolumn->get_nth<DATA_T>(0);
+    DATA_T* cbase = ccolumn->get_nth<DATA_T>(0);
+
+    DATA_T prev_values[PSP_PROCESS_COLUMN_BLOCK_SIZE];
+    DATA_T cur_values[PSP_PROCESS_COLUMN_BLOCK_SIZE];
+    DATA_T delta_values[PSP_PROCESS_COLUMN_BLOCK_SIZE];
+    DATA_T current_values[PSP_PROCESS_COLUMN_BLOCK_SIZE];
+    std::uint8_t prev_valid[PSP_PROCESS_COLUMN_BLOCK_SIZE];
+    std::uint8_t cur_valid[PSP_PROCESS_COLUMN_BLOCK_SIZE];
+    std::uint8_t flags[PSP_PROCESS_COLUMN_BLOCK_SIZE];
+
+    for (t_uindex bidx = 0; bidx < num_rows; bidx += PSP_PROCESS_COLUMN_BLOCK_SIZE) {
+        t_uindex block_size = std::min(num_rows - bidx, t_uindex(PSP_PROCESS_COLUMN_BLOCK_SIZE));
+
+        // Gather current values from `fcolumn` and previous values from the
+        // master column, zeroing previous values for new rows.
+        for (t_uindex i = 0; i < block_size; ++i) {
+            t_uindex idx = bidx + i;
+            const t_rlookup& rlookup = process_state.m_lookup[idx];
+            bool prev_pkey_eq = process_state.m_prev_pkey_eq_vec[idx];
+            bool row_pre_existed = rlookup.m_exists;
+
+            if (process_state.m_op_base[idx] == OP_INSERT) {
+                row_pre_existed = row_pre_existed && !prev_pkey_eq;
+            }
+
+            cur_values[i] = fbase[idx];
+            cur_valid[i] = fcolumn->is_valid(idx);
+
+            if (row_pre_existed) {
+                prev_values[i] = sbase[rlookup.m_idx];
+                prev_valid[i] = scolumn->is_valid(rlookup.m_idx);
+            } else {
+                memset(&prev_values[i], 0, sizeof(DATA_T));
+                prev_valid[i] = false;
+            }
+
+            flags[i] = (row_pre_existed ? FLAG_ROW_PRE_EXISTED : 0)
+                | (prev_pkey_eq ? FLAG_PREV_PKEY_EQ : 0);
+        }
+
+        for (t_uindex i = 0; i < block_size; ++i) {
+            bool prev_cur_eq = prev_values[i] == cur_values[i];
+            delta_values[i] = cur_valid[i] ? DATA_T(cur_values[i] - prev_values[i]) : DATA_T(0);
+            current_values[i] = cur_valid[i] ? cur_values[i] : prev_values[i];
+            flags[i] |= (prev_valid[i] ? FLAG_PREV_VALID : 0) | (cur_valid[i] ? FLAG_CUR_VALID : 0)
+                | (prev_cur_eq ? FLAG_PREV_CUR_EQ : 0);
+        }
+
+        // Scatter into the transitional columns at each row's offset.
+        for (t_uindex i = 0; i < block_size; ++i) {
+            t_uindex idx = bidx + i;
+            t_uindex added_count = process_state.m_added_offset[idx];
+            t_op op = static_cast<t_op>(process_state.m_op_base[idx]);
+
+            switch (op) {
+                case OP_INSERT: {
+                    dbase[added_count] = delta_values[i];
+                    dcolumn->set_valid(added_count, true);
+
+                    pbase[added_count] = prev_values[i];
+                    pcolumn->set_valid(added_count, prev_valid[i]);
+
+                    cbase[added_count] = current_values[i];
+                    ccolumn->set_valid(added_count, cur_valid[i] || prev_valid[i]);
+
+                    tcolumn->set_nth<std::uint8_t>(idx, transition_table[flags[i]]);
+                } break;
+                case OP_DELETE: {
+                    if (flags[i] & FLAG_ROW_PRE_EXISTED) {
+                        pbase[added_count] = prev_values[i];
+                        pcolumn->set_valid(added_count, prev_valid[i]);
+
+                        cbase[added_count] = prev_values[i];
+                        ccolumn->set_valid(added_count, prev_valid[i]);
+
+                        SUPPRESS_WARNINGS_VC(4146)
+                        dbase[added_count] = -prev_values[i];
+                        RESTORE_WARNINGS_VC()
+                        dcolumn->set_valid(added_count, true);
+
+                        tcolumn->set_nth<std::uint8_t>(added_count, VALUE_TRANSITION_NEQ_TDF);
+                    }
+                } break;
+                default: { PSP_COMPLAIN_AND_ABORT("Unknown OP"); }
+            }
+        }
+    }
+}
+
 } // end namespace perspective
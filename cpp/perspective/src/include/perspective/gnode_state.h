@@ -12,22 +12,48 @@
 #include <perspective/first.h>
 #include <perspective/base.h>
 #include <perspective/data_table.h>
-#include <tsl/hopscotch_map.h>
 #include <tsl/hopscotch_set.h>
 #include <perspective/mask.h>
-#include <perspective/sym_table.h>
+#include <perspective/pkey_map.h>
 #include <perspective/rlookup.h>
+#include <perspective/snapshot.h>
 
 namespace perspective {
 
 std::pair<t_tscalar, t_tscalar> get_vec_min_max(const std::vector<t_tscalar>& vec);
 
-class PERSPECTIVE_EXPORT t_gstate {
+/**
+ * @brief The rows written by one update to the master table of a
+ * `GNODE_TYPE_RING` gnode, which contexts apply in place of the
+ * transitional tables.
+ */
+struct PERSPECTIVE_EXPORT t_ring_step {
+    t_ring_step();
+
     /**
-     * @brief A mapping of `t_tscalar` primary keys to `t_uindex` row indices.
+     * @brief Returns whether row `idx` of `m_appended` overwrote, and so
+     * evicted, an existing row of the master table.
+     *
+     * @param idx
+     * @return true
+     * @return false
      */
-    typedef tsl::hopscotch_map<t_tscalar, t_uindex> t_mapping;
+    bool is_evicted(t_uindex idx) const;
+
+    // The rows written to the master table, each keyed by its slot.
+    std::shared_ptr<t_data_table> m_appended;
+
+    // The rows evicted by each row of `m_appended`, or null if no context
+    // reads the values of evicted rows.
+    std::shared_ptr<t_data_table> m_evicted;
+
+    // Rows of `m_appended` in `[m_fresh_begin, m_fresh_end)` were written
+    // to new slots at the end of the master table.
+    t_uindex m_fresh_begin;
+    t_uindex m_fresh_end;
+};
 
+class PERSPECTIVE_EXPORT t_gstate {
     typedef tsl::hopscotch_set<t_uindex> t_free_items;
 
 public:
@@ -49,6 +75,29 @@ public:
 
     void init();
 
+    /**
+     * @brief Move the master `t_data_table` to `backing_store`. On
+     * `BACKING_STORE_DISK`, the stores of its columns and their
+     * vocabularies are memory-mapped files in `dirname`, which the OS can
+     * page out, and `access_hint` tells it how they will be read. Existing
+     * rows keep their row indices.
+     *
+     * @param backing_store
+     * @param dirname
+     * @param access_hint
+     */
+    void set_backing_store(
+        t_backing_store backing_store, const std::string& dirname, t_access_hint access_hint);
+
+    /**
+     * @brief Return the memory of each column of the master `t_data_table`
+     * under `columns`, of the primary key mapping as `pkey_map`, and of the
+     * set of free rows as `free_rows`.
+     *
+     * @return t_memory_report
+     */
+    t_memory_report get_memory_usage() const;
+
     /**
      * @brief Look up a primary key in the `t_gstate`'s mapping of primary
      * keys to row numbers.
@@ -60,6 +109,15 @@ public:
      */
     t_rlookup lookup(t_tscalar pkey) const;
 
+    /**
+     * @brief Look up every primary key in `pkey_col`, returning one
+     * `t_rlookup` per row. Lookups are read-only and run in parallel.
+     *
+     * @param pkey_col
+     * @return std::vector<t_rlookup>
+     */
+    std::vector<t_rlookup> lookup(const t_column* pkey_col) const;
+
     /**
      * @brief If the master table has 0 rows, fill it using `flattened`.
      * 
@@ -76,6 +134,106 @@ public:
      */
     void update_master_table(const t_data_table* flattened);
 
+    /**
+     * @brief Use the row number of each row as its primary key, without
+     * storing the mapping. Must be called before any data is added.
+     */
+    void set_implicit_pkeys();
+
+    /**
+     * @brief Returns whether `tbl` only appends new rows to a master table
+     * with implicit primary keys - i.e. every row of `tbl` is an
+     * `OP_INSERT` whose primary key is the next row number.
+     *
+     * @param tbl
+     * @return true
+     * @return false
+     */
+    bool is_append(const t_data_table* tbl) const;
+
+    /**
+     * @brief Append `tbl`, for which `is_append` is true, to the end of the
+     * master `t_data_table` with a bulk copy of each column.
+     *
+     * @param tbl
+     */
+    void append_master_table(const t_data_table* tbl);
+
+    /**
+     * @brief Returns whether `tbl` can be written to a ring buffer of
+     * `limit` rows in place - i.e. every row of `tbl` is an `OP_INSERT`
+     * whose primary key is the next slot modulo `limit`, starting at or
+     * before the end of the master `t_data_table`, and every row that
+     * overwrites a slot sets all of its columns, so that nothing is
+     * read from the row it evicts.
+     *
+     * @param tbl
+     * @param limit
+     * @return true
+     * @return false
+     */
+    bool is_ring_write(const t_data_table* tbl, t_uindex limit) const;
+
+    /**
+     * @brief Write `tbl`, for which `is_ring_write` is true, to the slots
+     * of the master `t_data_table` named by its primary keys, without
+     * looking them up. Slots past the end of the table are appended. If
+     * `copy_evicted` is true, the rows that are overwritten are copied
+     * to `m_evicted` of the returned step before they are written.
+     *
+     * @param tbl
+     * @param copy_evicted
+     * @return t_ring_step
+     */
+    t_ring_step write_ring(std::shared_ptr<t_data_table> tbl, bool copy_evicted);
+
+    /**
+     * @brief Compact the vocabulary of each string column in the master
+     * `t_data_table`, removing strings that were overwritten or erased.
+     * Unless `force` is true, a column is only compacted once its
+     * vocabulary has grown by `PSP_VOCAB_COMPACT_MIN_BYTES`, and at least
+     * doubled, since it was last compacted.
+     *
+     * @param force
+     * @return t_uindex the number of bytes reclaimed.
+     */
+    t_uindex compact_vocabularies(bool force = false);
+
+    /**
+     * @brief Move the live rows at the end of the master `t_data_table`
+     * into its free rows, rewriting their row index in the primary key
+     * mapping, and shrink the table to the live rows. Unless `force` is
+     * true, the table is only compacted once at least
+     * `PSP_ROW_COMPACT_MIN_FREE_ROWS` rows, and a
+     * `PSP_ROW_COMPACT_MIN_FREE_RATIO` fraction of its rows, are free.
+     *
+     * Row indices into the master table that were looked up before
+     * compaction are invalidated.
+     *
+     * @param force
+     * @return t_uindex the number of free rows reclaimed.
+     */
+    t_uindex compact_rows(bool force = false);
+
+    /**
+     * @brief Write the columns of the master `t_data_table` in the input
+     * schema, whether the primary key mapping is implicit, and the free
+     * rows to a snapshot. Expression columns are not written, as contexts
+     * compute them again when they are registered.
+     *
+     * @param writer
+     */
+    void save_snapshot(t_snapshot_writer& writer) const;
+
+    /**
+     * @brief Restore a snapshot written by `save_snapshot` into an empty
+     * `t_gstate` with the same input schema, rebuilding the primary key
+     * mapping from the restored primary key column.
+     *
+     * @param reader
+     */
+    void load_snapshot(t_snapshot_reader& reader);
+
     /**
      * @brief Given a column in the master data table and the corresponding
      * column in the `flattened` data table, fill the master column with data
@@ -269,6 +427,16 @@ protected:
      */
     t_uindex lookup_or_create(const t_tscalar& pkey);
 
+    /**
+     * @brief Return a row index for a new primary key, reusing a free row
+     * if one exists and appending (and growing) the master table otherwise.
+     * Does not write to `m_mapping`.
+     *
+     * @param pkey
+     * @return t_uindex
+     */
+    t_uindex create_row(const t_tscalar& pkey);
+
     /**
      * @brief Clear the value at `pkey` for every column in the table.
      * 
@@ -296,6 +464,15 @@ private:
 
     std::vector<t_tscalar> get_row(t_tscalar pkey) const;
 
+    /**
+     * @brief Pack the status of every column in the master table into
+     * validity bitmaps, as it lives for as long as the table.
+     */
+    void pack_status();
+
+    std::shared_ptr<t_data_table> make_master_table(
+        const t_schema& schema, t_uindex capacity) const;
+
     // Unimplemented header
     bool apply(const std::vector<t_tscalar>& pkeys, const std::string& colname,
         t_tscalar& value) const;
@@ -303,12 +480,17 @@ private:
     t_schema m_input_schema; // pkeyed
     t_schema m_output_schema; // tblschema
     bool m_init;
+    t_backing_store m_backing_store;
+    std::string m_dirname;
+    t_access_hint m_access_hint;
     std::shared_ptr<t_data_table> m_table;
-    t_mapping m_mapping;
+    t_pkey_map m_mapping;
     t_free_items m_free;
-    t_symtable m_symtable;
     std::shared_ptr<t_column> m_pkcol;
     std::shared_ptr<t_column> m_opcol;
+
+    // Size of each string column's vocabulary after it was last compacted
+    std::map<std::string, t_uindex> m_vocab_compacted_size;
 };
 
 template <typename FN_T>
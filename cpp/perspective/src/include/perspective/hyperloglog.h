@@ -0,0 +1,76 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2017, the Perspective Authors.
+ *
+ * This file is part of the Perspective library, distributed under the terms of
+ * the Apache License 2.0.  The full license can be found in the LICENSE file.
+ *
+ */
+
+#pragma once
+#include <perspective/first.h>
+#include <perspective/base.h>
+#include <perspective/exports.h>
+#include <perspective/scalar.h>
+#include <perspective/memory_usage.h>
+#include <cstdint>
+#include <vector>
+
+namespace perspective {
+
+const std::uint8_t PSP_HLL_MIN_PRECISION = 4;
+const std::uint8_t PSP_HLL_MAX_PRECISION = 16;
+const std::uint8_t PSP_HLL_DEFAULT_PRECISION = 12;
+
+/**
+ * @brief A HyperLogLog sketch of the number of distinct scalars added to
+ * it, with `2 ^ precision` registers and a standard error of roughly
+ * `1.04 / sqrt(2 ^ precision)`.
+ *
+ * Registers are allocated densely only once the sketch holds more than an
+ * eighth of them; until then the non-zero registers are kept as a sorted
+ * list, so the many small sketches of a deep pivot stay small. Sketches of
+ * the same precision merge losslessly, but values cannot be removed.
+ */
+class PERSPECTIVE_EXPORT t_hyperloglog {
+public:
+    t_hyperloglog();
+    t_hyperloglog(std::uint8_t precision);
+
+    void add(const t_tscalar& value);
+    void add_hash(std::uint64_t hash);
+
+    /**
+     * @brief Add every value added to `other`, which must have the same
+     * precision.
+     *
+     * @param other
+     */
+    void merge(const t_hyperloglog& other);
+
+    void clear();
+
+    /**
+     * @brief Return the estimated number of distinct values added.
+     *
+     * @return std::uint64_t
+     */
+    std::uint64_t estimate() const;
+
+    std::uint8_t precision() const;
+    t_memory_usage get_memory_usage(const std::string& name) const;
+
+private:
+    t_uindex num_registers() const;
+    void set_register(std::uint32_t idx, std::uint8_t rank);
+    void densify();
+
+    std::uint8_t m_precision;
+
+    // Each sparse entry is a register index shifted left by 8 bits, or'd
+    // with its rank, in index order.
+    std::vector<std::uint32_t> m_sparse;
+    std::vector<std::uint8_t> m_registers;
+};
+
+} // end namespace perspective
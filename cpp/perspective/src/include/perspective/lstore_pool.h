@@ -0,0 +1,87 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2017, the Perspective Authors.
+ *
+ * This file is part of the Perspective library, distributed under the terms of
+ * the Apache License 2.0.  The full license can be found in the LICENSE file.
+ *
+ */
+
+#pragma once
+#include <perspective/first.h>
+#include <perspective/base.h>
+#include <perspective/exports.h>
+#include <mutex>
+#include <vector>
+
+namespace perspective {
+
+struct PERSPECTIVE_EXPORT t_lstore_pool_stats {
+    t_lstore_pool_stats();
+
+    // bytes served from a previously released block
+    t_uindex m_bytes_reused;
+
+    // bytes newly allocated from the system
+    t_uindex m_bytes_allocated;
+
+    // bytes currently held in the free lists
+    t_uindex m_bytes_retained;
+
+    t_uindex m_num_resets;
+};
+
+/**
+ * @brief A size-class pool of zeroed memory blocks for the `t_lstore`s of
+ * transient tables, i.e. the input, flattened and transitional tables that
+ * `t_gnode` rebuilds on every update.
+ *
+ * Blocks are rounded up to a power of two between `PSP_LSTORE_POOL_MIN_BYTES`
+ * and `PSP_LSTORE_POOL_MAX_BYTES`, and released blocks are kept on a free
+ * list for their size class until the next `reset()`. Stores hold a
+ * `shared_ptr` to their pool, so the pool outlives every block it served.
+ */
+class PERSPECTIVE_EXPORT t_lstore_pool {
+public:
+    t_lstore_pool();
+    ~t_lstore_pool();
+
+    PSP_NON_COPYABLE(t_lstore_pool);
+
+    /**
+     * @brief Return a zeroed block of at least `capacity` bytes, and set
+     * `capacity` to the size of the block.
+     *
+     * @param capacity
+     * @return void*
+     */
+    void* allocate(t_uindex& capacity);
+
+    /**
+     * @brief Return a block from `allocate` to the pool - `capacity` must be
+     * the size `allocate` returned.
+     *
+     * @param base
+     * @param capacity
+     */
+    void release(void* base, t_uindex capacity);
+
+    /**
+     * @brief Mark the end of an update cycle, freeing the released blocks of
+     * each size class beyond the number that were allocated since the
+     * previous reset.
+     */
+    void reset();
+
+    t_lstore_pool_stats get_stats() const;
+
+private:
+    t_uindex size_class(t_uindex capacity) const;
+
+    mutable std::mutex m_mutex;
+    std::vector<std::vector<void*>> m_free;
+    std::vector<t_uindex> m_allocated_since_reset;
+    t_lstore_pool_stats m_stats;
+};
+
+} // end namespace perspective
@@ -23,11 +23,23 @@ class PERSPECTIVE_EXPORT t_mask {
     typedef boost::dynamic_bitset<>::size_type t_msize;
 
 public:
+    typedef boost::dynamic_bitset<>::block_type t_block;
+    static const t_uindex BITS_PER_BLOCK = boost::dynamic_bitset<>::bits_per_block;
+
     t_mask();
     t_mask(t_uindex size);
 
     t_mask(const t_simple_bitmask& m);
 
+    /**
+     * @brief Construct a mask of `size` bits from whole blocks, where bit `i`
+     * of `blocks[j]` is bit `j * BITS_PER_BLOCK + i` of the mask.
+     *
+     * @param blocks
+     * @param size
+     */
+    t_mask(const std::vector<t_block>& blocks, t_uindex size);
+
     ~t_mask();
 
     void clear();
@@ -0,0 +1,90 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2017, the Perspective Authors.
+ *
+ * This file is part of the Perspective library, distributed under the terms of
+ * the Apache License 2.0.  The full license can be found in the LICENSE file.
+ *
+ */
+
+#pragma once
+#include <perspective/first.h>
+#include <perspective/base.h>
+#include <perspective/exports.h>
+#include <perspective/storage.h>
+#include <string>
+#include <vector>
+
+namespace perspective {
+
+// Estimated pointers per element added by each index of a node based
+// container - parent, left and right for an ordered index, and the next
+// node and the bucket for a hashed index.
+const t_uindex PSP_ORDERED_INDEX_LINKS = 3;
+const t_uindex PSP_HASHED_INDEX_LINKS = 2;
+
+/**
+ * @brief The memory held by one component of a table or view, named by its
+ * dotted path, e.g. `columns.x.vocab`. `m_reserved` bytes are allocated,
+ * of which `m_used` hold live data. Stores report their exact capacity and
+ * size, while containers are estimated from their element count and
+ * layout.
+ */
+struct PERSPECTIVE_EXPORT t_memory_usage {
+    t_memory_usage();
+    t_memory_usage(const std::string& name, t_uindex reserved, t_uindex used);
+
+    t_memory_usage& operator+=(const t_memory_usage& other);
+
+    std::string m_name;
+    t_uindex m_reserved;
+    t_uindex m_used;
+};
+
+typedef std::vector<t_memory_usage> t_memory_report;
+
+/**
+ * @brief Append `entries` to `report`, prefixing the name of each with
+ * `prefix` and a dot.
+ *
+ * @param report
+ * @param prefix
+ * @param entries
+ */
+PERSPECTIVE_EXPORT void append_memory_usage(
+    t_memory_report& report, const std::string& prefix, const t_memory_report& entries);
+
+PERSPECTIVE_EXPORT t_memory_usage get_memory_usage(
+    const std::string& name, const t_lstore& store);
+
+/**
+ * @brief Estimate the memory of a node based container of `size` elements
+ * of `value_size` bytes, where each element carries `num_links` pointers.
+ *
+ * @param name
+ * @param size
+ * @param value_size
+ * @param num_links
+ * @return t_memory_usage
+ */
+PERSPECTIVE_EXPORT t_memory_usage get_node_memory_usage(
+    const std::string& name, t_uindex size, t_uindex value_size, t_uindex num_links);
+
+template <typename T>
+t_memory_usage
+get_vector_memory_usage(const std::string& name, const std::vector<T>& vec) {
+    return t_memory_usage(name, vec.capacity() * sizeof(T), vec.size() * sizeof(T));
+}
+
+/**
+ * @brief Estimate the memory of an open addressing hash container, such as
+ * `tsl::hopscotch_map`, which stores its values in the bucket array.
+ */
+template <typename HASH_T>
+t_memory_usage
+get_hash_memory_usage(const std::string& name, const HASH_T& hash) {
+    t_uindex value_size = sizeof(typename HASH_T::value_type);
+    return t_memory_usage(name, hash.bucket_count() * value_size, hash.size() * value_size);
+}
+
+} // end namespace perspective
@@ -0,0 +1,74 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2017, the Perspective Authors.
+ *
+ * This file is part of the Perspective library, distributed under the terms of
+ * the Apache License 2.0.  The full license can be found in the LICENSE file.
+ *
+ */
+
+#pragma once
+#include <perspective/first.h>
+#include <perspective/base.h>
+#include <perspective/exports.h>
+#include <perspective/scalar.h>
+#include <map>
+
+namespace perspective {
+
+/**
+ * @brief Orders scalars as `t_tscalar::operator<` does, except that NaN
+ * sorts after every other float and equal to itself, which keeps the
+ * ordering strict and weak for use as a map key.
+ */
+struct PERSPECTIVE_EXPORT t_order_statistic_cmp {
+    bool operator()(const t_tscalar& a, const t_tscalar& b) const;
+};
+
+/**
+ * @brief The quantile of a multiset of scalars, maintained as values are
+ * inserted and removed. Values are kept with their multiplicity in an
+ * ordered map, alongside a cursor at the value last returned and the
+ * number of values below it. Each insert or removal moves the selected
+ * rank by at most one, so reading the quantile after `n` updates walks
+ * the cursor at most `n` values.
+ *
+ * The quantile of `n` values is the value at rank `floor(quantile * n)`,
+ * clamped to `n - 1`, so a quantile of 0.5 is the upper median.
+ */
+class PERSPECTIVE_EXPORT t_order_statistic {
+public:
+    t_order_statistic();
+    t_order_statistic(double quantile);
+
+    /**
+     * @brief Add `count` copies of `value`, or remove them if `count` is
+     * negative.
+     *
+     * @param value
+     * @param count
+     */
+    void update(const t_tscalar& value, t_index count);
+
+    /**
+     * @brief Return the value at the quantile, or none if there are no
+     * values.
+     *
+     * @return t_tscalar
+     */
+    t_tscalar get();
+
+    t_uindex size() const;
+    t_uindex num_distinct() const;
+
+private:
+    typedef std::map<t_tscalar, t_uindex, t_order_statistic_cmp> t_counts;
+
+    double m_quantile;
+    t_uindex m_size;
+    t_counts m_counts;
+    t_tscalar m_cursor;
+    t_uindex m_below;
+};
+
+} // end namespace perspective
@@ -0,0 +1,302 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2017, the Perspective Authors.
+ *
+ * This file is part of the Perspective library, distributed under the terms of
+ * the Apache License 2.0.  The full license can be found in the LICENSE file.
+ *
+ */
+
+#pragma once
+
+#include <perspective/first.h>
+#include <perspective/base.h>
+#include <perspective/exports.h>
+#include <perspective/scalar.h>
+#include <perspective/sym_table.h>
+#include <perspective/column.h>
+#include <perspective/rlookup.h>
+#include <tsl/hopscotch_map.h>
+
+namespace perspective {
+
+/**
+ * @brief A mapping of `t_tscalar` primary keys to `t_uindex` row indices,
+ * hash-partitioned into a fixed number of independent shards.
+ *
+ * The index is specialized on the dtype of the primary key column: valid
+ * keys of a fixed-width dtype are stored as their raw 64-bit value, and
+ * valid string keys as their id in the vocabulary of the primary key column
+ * set by `set_pkey_column`, so that neither hashes nor stores a full
+ * `t_tscalar` and each string key is stored only once. Keys that do not
+ * match the index dtype (nulls, or scalars of another type) fall back to a
+ * `t_tscalar` keyed map, so the semantics of `t_tscalar::operator==` are
+ * preserved.
+ *
+ * A primary key always lives in the same shard, so operations on different
+ * shards never touch the same memory. This allows batches of inserts to be
+ * bucketed by shard and applied concurrently, one task per shard, while
+ * lookups remain safe to run from any number of threads as long as no
+ * shard is being written to.
+ *
+ * A `DTYPE_INT32` map can also be put in implicit mode, for tables whose
+ * primary keys are the synthetic row numbers assigned to unindexed data:
+ * while every key `k` in `[0, size)` maps to row `k`, nothing is stored at
+ * all. The first write that breaks this pattern materializes the range.
+ */
+class PERSPECTIVE_EXPORT t_pkey_map {
+public:
+    typedef tsl::hopscotch_map<t_tscalar, t_uindex> t_mapping;
+    typedef tsl::hopscotch_map<std::uint64_t, t_uindex> t_raw_mapping;
+    // Maps the vocabulary id of a string primary key to its row index
+    typedef tsl::hopscotch_map<t_uindex, t_uindex> t_str_mapping;
+
+    /**
+     * @brief Each shard owns the interned copies of the fallback primary
+     * keys that are stored in its mapping, so that inserts into different
+     * shards do not contend on a shared symbol table.
+     */
+    struct t_shard {
+        t_raw_mapping m_raw_mapping;
+        t_str_mapping m_str_mapping;
+        t_mapping m_mapping;
+        t_symtable m_symtable;
+    };
+
+    t_pkey_map();
+
+    /**
+     * @brief Construct a new `t_pkey_map` specialized for primary keys of
+     * `pkey_dtype`, with `num_shards` shards, which is rounded up to the
+     * next power of two.
+     *
+     * @param pkey_dtype
+     * @param num_shards
+     */
+    t_pkey_map(t_dtype pkey_dtype, t_uindex num_shards = PSP_PKEY_MAP_NUM_SHARDS);
+
+    PSP_NON_COPYABLE(t_pkey_map);
+
+    /**
+     * @brief Return the index of the shard that owns `pkey`.
+     *
+     * The shard is selected from the high bits of the key's hash, as the
+     * low bits are used by each shard's hopscotch map to select a bucket.
+     *
+     * @param pkey
+     * @return t_uindex
+     */
+    t_uindex get_shard_idx(const t_tscalar& pkey) const;
+
+    /**
+     * @brief Store string primary keys by their id in the vocabulary of
+     * `column`, which must be the `DTYPE_STR` primary key column of the
+     * master table. String keys are interned into its vocabulary on insert
+     * if they are not already present. Must be called while the map is
+     * empty, and again whenever the column is replaced - by a copy of the
+     * current column that keeps its vocabulary ids if the map is not empty.
+     *
+     * @param column
+     */
+    void set_pkey_column(std::shared_ptr<t_column> column);
+
+    /**
+     * @brief Rewrite the vocabulary id of every string primary key after
+     * the vocabulary of the primary key column has been compacted, where
+     * `remap` holds the new id of each old id.
+     *
+     * @param remap
+     */
+    void remap_vocabulary(const std::vector<t_uindex>& remap);
+
+    /**
+     * @brief Rewrite the row index of every primary key after rows of the
+     * master table have been moved, where `remap` holds the new row of each
+     * old row. Not valid in implicit mode, which has no free rows to move
+     * into.
+     *
+     * @param remap
+     */
+    void remap_rows(const std::vector<t_uindex>& remap);
+
+    t_uindex num_shards() const;
+
+    /**
+     * @brief Return the dtype of the keys in the map - the index dtype if
+     * any specialized keys are stored, otherwise the dtype of an arbitrary
+     * fallback key, or `DTYPE_STR` if the map is empty.
+     *
+     * @return t_dtype
+     */
+    t_dtype get_pkey_dtype() const;
+
+    /**
+     * @brief Look up `pkey`, returning a `t_rlookup` with `m_exists` set to
+     * false if `pkey` is not in the map.
+     *
+     * @param pkey
+     * @return t_rlookup
+     */
+    t_rlookup find(const t_tscalar& pkey) const;
+
+    bool contains(const t_tscalar& pkey) const;
+
+    /**
+     * @brief Map `pkey` to `idx`, interning string keys into the vocabulary
+     * of the primary key column. Only the owning shard is written to.
+     *
+     * @param pkey
+     * @param idx
+     */
+    void insert(const t_tscalar& pkey, t_uindex idx);
+
+    /**
+     * @brief Map each of `pkeys` to the row index at the same position in
+     * `idxs`. Keys are interned and bucketed by shard serially, and then
+     * each shard is written to by a single task, in parallel. `pkeys` must
+     * not contain duplicates.
+     *
+     * @param pkeys
+     * @param idxs
+     */
+    void insert(const std::vector<t_tscalar>& pkeys, const std::vector<t_uindex>& idxs);
+
+    /**
+     * @brief Remove `pkey` from the map, writing its row index into `idx`.
+     * Returns false if `pkey` was not in the map.
+     *
+     * @param pkey
+     * @param idx
+     * @return bool
+     */
+    bool erase(const t_tscalar& pkey, t_uindex& idx);
+
+    /**
+     * @brief Reserve space for `size` keys, spread evenly across shards.
+     *
+     * @param size
+     */
+    void reserve(t_uindex size);
+
+    t_uindex size() const;
+
+    /**
+     * @brief Return the memory of the mappings of every shard - nothing is
+     * stored for keys in the implicit range.
+     *
+     * @param name
+     * @return t_memory_usage
+     */
+    t_memory_usage get_memory_usage(const std::string& name) const;
+    bool empty() const;
+
+    /**
+     * @brief Remove every key from the map. A map that was put in implicit
+     * mode returns to implicit mode.
+     */
+    void clear();
+
+    /**
+     * @brief Put an empty map into implicit mode. Only `DTYPE_INT32` maps
+     * support implicit mode, and this is a no-op for any other dtype.
+     */
+    void set_implicit();
+
+    /**
+     * @brief Whether the map is in implicit mode, i.e. it contains exactly
+     * the keys `[0, size())`, each mapped to the row of the same index.
+     *
+     * @return bool
+     */
+    bool is_implicit() const;
+
+    /**
+     * @brief In implicit mode, add the keys `[size(), size() + count)`.
+     *
+     * @param count
+     */
+    void extend_implicit(t_uindex count);
+
+    /**
+     * @brief Call `fn(pkey, idx)` on every entry in the map. Iteration order
+     * is unspecified.
+     *
+     * @tparam FN_T
+     * @param fn
+     */
+    template <typename FN_T>
+    void for_each(FN_T fn) const;
+
+private:
+    enum t_keytype { KEYTYPE_RAW, KEYTYPE_STR, KEYTYPE_SCALAR };
+
+    /**
+     * @brief Return how `pkey` is stored - as a raw or string key only if it
+     * is valid and has the same dtype as the index, and string keys only
+     * once a primary key column has been set.
+     */
+    t_keytype get_keytype(const t_tscalar& pkey) const;
+
+    t_tscalar mk_raw_pkey(std::uint64_t key) const;
+
+    /**
+     * @brief Look up the vocabulary id of a string key without interning
+     * it, returning false if it is not in the vocabulary.
+     */
+    bool find_str_id(const t_tscalar& pkey, t_uindex& id) const;
+
+    /**
+     * @brief Insert into a shard that is known to own `pkey`, where `id` is
+     * the vocabulary id of a string key.
+     */
+    void insert(t_uindex shard_idx, const t_tscalar& pkey, t_uindex id, t_uindex idx);
+
+    /**
+     * @brief Return whether `pkey` is a key in the implicit range.
+     */
+    bool is_implicit_key(const t_tscalar& pkey) const;
+
+    /**
+     * @brief Leave implicit mode, writing the implicit range into the
+     * shards so that it can be modified arbitrarily.
+     */
+    void materialize();
+
+    std::vector<t_shard> m_shards;
+    std::shared_ptr<t_column> m_pkey_column;
+    t_uindex m_shard_bits;
+    t_dtype m_dtype;
+    t_keytype m_keytype;
+    bool m_allow_implicit;
+    bool m_implicit;
+    t_uindex m_implicit_size;
+};
+
+template <typename FN_T>
+void
+t_pkey_map::for_each(FN_T fn) const {
+    if (m_implicit) {
+        for (t_uindex idx = 0; idx < m_implicit_size; ++idx) {
+            fn(mk_raw_pkey(idx), idx);
+        }
+        return;
+    }
+
+    for (const auto& shard : m_shards) {
+        for (const auto& kv : shard.m_raw_mapping) {
+            fn(mk_raw_pkey(kv.first), kv.second);
+        }
+
+        for (const auto& kv : shard.m_str_mapping) {
+            t_tscalar pkey;
+            pkey.set(m_pkey_column->unintern_c(kv.first));
+            fn(pkey, kv.second);
+        }
+
+        for (const auto& kv : shard.m_mapping) {
+            fn(kv.first, kv.second);
+        }
+    }
+}
+
+} // end namespace perspective
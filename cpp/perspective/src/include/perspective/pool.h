@@ -14,6 +14,8 @@
 #include <perspective/exports.h>
 #include <mutex>
 #include <atomic>
+#include <chrono>
+#include <map>
 
 #ifdef PSP_ENABLE_PYTHON
 #include <thread>
@@ -37,6 +39,25 @@ struct PERSPECTIVE_EXPORT t_updctx {
     std::string m_ctx;
 };
 
+/**
+ * @brief The batching policy of one gnode of a `t_pool`, the state of its
+ * pending batch, and the counters of the batches it has processed.
+ */
+struct PERSPECTIVE_EXPORT t_batch_state {
+    t_batch_state();
+
+    // Whether a batching policy is set.
+    bool is_batching() const;
+
+    t_uindex m_max_rows;
+    t_uindex m_max_latency_ms;
+    t_uindex m_pending_rows;
+    t_uindex m_pending_updates;
+    std::chrono::steady_clock::time_point m_pending_since;
+    t_uindex m_num_batches;
+    t_uindex m_num_rows_coalesced;
+};
+
 class t_update_task;
 
 class PERSPECTIVE_EXPORT t_pool {
@@ -51,6 +72,16 @@ public:
 
 #if defined PSP_ENABLE_WASM || defined PSP_ENABLE_PYTHON
     void set_update_delegate(t_val ud);
+
+    /**
+     * @brief Set the delegate notified of the updates to `gnode_id` in place
+     * of the pool's delegate, so that each of the tables sharing a pool is
+     * notified of its own updates only.
+     *
+     * @param gnode_id
+     * @param ud
+     */
+    void set_gnode_update_delegate(t_uindex gnode_id, t_val ud);
 #endif
 
 #ifdef PSP_ENABLE_WASM
@@ -67,12 +98,14 @@ public:
 #endif
 
     /**
-     * @brief Call the binding language's `update_callback` method,
-     * set at initialize time.
-     * 
-     * @param port_id 
+     * @brief Call the binding language's `update_callback` method on the
+     * delegate of `gnode_id`, or on the pool's delegate set at initialize
+     * time.
+     *
+     * @param gnode_id
+     * @param port_id
      */
-    void notify_userspace(t_uindex port_id);
+    void notify_userspace(t_uindex gnode_id, t_uindex port_id);
 
     ~t_pool();
 
@@ -87,6 +120,78 @@ public:
     void init();
     void stop();
     void set_sleep(t_uindex ms);
+
+    /**
+     * @brief Set a batching policy for updates sent to `gnode_id`: instead
+     * of processing each update as soon as it is sent, the bindings wait
+     * until `max_rows` rows are pending, or `max_latency_ms` milliseconds
+     * have elapsed since the first pending update, and process all pending
+     * updates in a single step. Updates sent to the same port are merged
+     * into one `t_port` table, so they are flattened and processed once.
+     *
+     * A `max_rows` of 0 disables the row threshold, and a `max_latency_ms`
+     * of 0 disables the latency bound, so that a batch is only processed
+     * once it reaches `max_rows` or the table is read. Setting both to 0
+     * disables batching, which is the default.
+     *
+     * Each gnode of a shared pool has its own policy, but a process step
+     * applies the pending updates of every gnode, so a batch may be
+     * processed early along with another gnode's.
+     *
+     * @param gnode_id
+     * @param max_rows
+     * @param max_latency_ms
+     */
+    void set_batching(t_uindex gnode_id, t_uindex max_rows, t_uindex max_latency_ms);
+
+    /**
+     * @brief Returns whether a batching policy is set for `gnode_id`.
+     *
+     * @param gnode_id
+     * @return true
+     * @return false
+     */
+    bool is_batching(t_uindex gnode_id);
+
+    /**
+     * @brief Returns whether batching is enabled for `gnode_id` and its
+     * pending updates should be processed now, because they have reached
+     * the row threshold or latency bound of its batching policy.
+     *
+     * @param gnode_id
+     * @return true
+     * @return false
+     */
+    bool is_batch_ready(t_uindex gnode_id);
+
+    /**
+     * @brief Returns the number of milliseconds until the pending updates
+     * of `gnode_id` reach the latency bound of its batching policy - 0 if
+     * batching is disabled, the policy has no latency bound, or the batch
+     * is ready.
+     *
+     * @param gnode_id
+     * @return t_uindex
+     */
+    t_uindex get_batch_wait_ms(t_uindex gnode_id);
+
+    /**
+     * @brief Returns the number of batches processed for `gnode_id`, i.e.
+     * the number of process steps that applied at least one of its updates.
+     *
+     * @param gnode_id
+     * @return t_uindex
+     */
+    t_uindex get_num_batches(t_uindex gnode_id);
+
+    /**
+     * @brief Returns the number of rows of `gnode_id` that were coalesced,
+     * i.e. processed in a batch that merged more than one update.
+     *
+     * @param gnode_id
+     * @return t_uindex
+     */
+    t_uindex get_num_rows_coalesced(t_uindex gnode_id);
     std::vector<t_stree*> get_trees();
 
     bool get_data_remaining() const;
@@ -110,6 +215,14 @@ protected:
     // use the python api
     bool validate_gnode_id(t_uindex gnode_id) const;
 
+    /**
+     * @brief Count the pending updates of each gnode as a batch that is
+     * about to be processed, and reset the pending batches. Called at the
+     * start of a process step, so updates sent while it runs form the next
+     * batch.
+     */
+    void _begin_batch();
+
 private:
 #ifdef PSP_ENABLE_PYTHON
     std::thread::id m_event_loop_thread_id;
@@ -119,11 +232,15 @@ private:
 
 #if defined PSP_ENABLE_WASM || defined PSP_ENABLE_PYTHON
     t_val m_update_delegate;
+    std::map<t_uindex, t_val> m_gnode_update_delegates;
 #endif
     std::atomic_flag m_run;
     std::atomic<bool> m_data_remaining;
     std::atomic<t_uindex> m_sleep;
     std::atomic<t_uindex> m_epoch;
+
+    // The batching policy and pending batch of each gnode, by gnode id.
+    std::map<t_uindex, t_batch_state> m_batches;
 };
 
 } // end namespace perspective
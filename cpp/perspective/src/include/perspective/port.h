@@ -37,12 +37,20 @@ public:
     void release_or_clear();
     void clear();
 
+    /**
+     * @brief Allocate the tables this port creates from `pool`.
+     *
+     * @param pool
+     */
+    void set_lstore_pool(std::shared_ptr<t_lstore_pool> pool);
+
 private:
     // t_port_mode m_mode;
     t_schema m_schema;
     bool m_init;
     std::shared_ptr<t_data_table> m_table;
     t_uindex m_prevsize;
+    std::shared_ptr<t_lstore_pool> m_lstore_pool;
 };
 
 } // end namespace perspective
@@ -31,6 +31,7 @@ struct t_process_state {
 
     /**
      * @brief Reserve `size` elements for each transitional table in the state.
+     * If `m_materialize_transitions` is false, only `existed` is reserved.
      * 
      * @param size 
      */
@@ -38,6 +39,8 @@ struct t_process_state {
 
     /**
      * @brief For each transitional table in the state, set its size to `size`.
+     * If `m_materialize_transitions` is false, only `existed` is resized, and
+     * `delta`, `prev`, `current` and `transitions` remain empty.
      * 
      * @param size 
      */
@@ -57,6 +60,10 @@ struct t_process_state {
     std::vector<bool> m_prev_pkey_eq_vec;
 
     std::uint8_t* m_op_base;
+
+    // Whether any registered context reads the `delta`, `prev`, `current` or
+    // `transitions` tables - if not, they are never written to.
+    bool m_materialize_transitions;
 };
 
 } // end namespace perspective
\ No newline at end of file
@@ -0,0 +1,126 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2017, the Perspective Authors.
+ *
+ * This file is part of the Perspective library, distributed under the terms of
+ * the Apache License 2.0.  The full license can be found in the LICENSE file.
+ *
+ */
+
+#pragma once
+#include <perspective/first.h>
+#include <perspective/base.h>
+#include <perspective/compat.h>
+#include <perspective/exports.h>
+#include <perspective/storage.h>
+#include <fstream>
+#include <type_traits>
+
+namespace perspective {
+
+/**
+ * @brief Writes a table snapshot to a file with sequential, buffered I/O.
+ *
+ * A snapshot is a flat sequence of fixed-width values and length-prefixed
+ * byte blobs. Every blob starts on an 8 byte boundary, so that a reader
+ * can use the buffers of a memory-mapped snapshot in place.
+ */
+class PERSPECTIVE_EXPORT t_snapshot_writer {
+public:
+    t_snapshot_writer(const std::string& fname);
+    ~t_snapshot_writer();
+
+    PSP_NON_COPYABLE(t_snapshot_writer);
+
+    template <typename T>
+    void write(T value);
+
+    void write(const std::string& value);
+
+    /**
+     * @brief Write `len` bytes from `ptr` as a blob.
+     *
+     * @param ptr
+     * @param len
+     */
+    void write(const void* ptr, t_uindex len);
+
+    /**
+     * @brief Write the contents of `store`, up to its size, as a blob.
+     *
+     * @param store
+     */
+    void write(const t_lstore& store);
+
+    /**
+     * @brief Flush the file, aborting if any write failed.
+     */
+    void close();
+
+private:
+    void write_raw(const void* ptr, t_uindex len);
+    void pad();
+
+    std::string m_fname;
+    std::ofstream m_out;
+    std::vector<char> m_buffer;
+    t_uindex m_offset;
+};
+
+/**
+ * @brief Reads a snapshot written by `t_snapshot_writer` from a read-only
+ * memory mapping of the file, without parsing - values and blobs are read
+ * in the order they were written, and bounds checked against the file.
+ */
+class PERSPECTIVE_EXPORT t_snapshot_reader {
+public:
+    t_snapshot_reader(const std::string& fname);
+
+    PSP_NON_COPYABLE(t_snapshot_reader);
+
+    template <typename T>
+    T read();
+
+    std::string read_string();
+
+    /**
+     * @brief Return a pointer to the next blob in the mapping, writing its
+     * length into `len`.
+     *
+     * @param len
+     * @return const void*
+     */
+    const void* read(t_uindex& len);
+
+    /**
+     * @brief Replace the contents of `store` with the next blob.
+     *
+     * @param store
+     */
+    void read(t_lstore& store);
+
+private:
+    const char* read_raw(t_uindex len);
+    void skip_pad();
+
+    t_rfmapping m_mapping;
+    t_uindex m_offset;
+};
+
+template <typename T>
+void
+t_snapshot_writer::write(T value) {
+    static_assert(std::is_arithmetic<T>::value, "Only arithmetic values can be written");
+    write_raw(&value, sizeof(T));
+}
+
+template <typename T>
+T
+t_snapshot_reader::read() {
+    static_assert(std::is_arithmetic<T>::value, "Only arithmetic values can be read");
+    T value;
+    memcpy(&value, read_raw(sizeof(T)), sizeof(T));
+    return value;
+}
+
+} // end namespace perspective
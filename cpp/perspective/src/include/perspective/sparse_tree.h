@@ -21,6 +21,12 @@ SUPPRESS_WARNINGS_VC(4503)
 #include <boost/multi_index/composite_key.hpp>
 #include <perspective/sort_specification.h>
 #include <perspective/sparse_tree_node.h>
+#include <perspective/sparse_tree_nodes.h>
+#include <perspective/order_statistic.h>
+#include <perspective/value_counts.h>
+#include <perspective/hyperloglog.h>
+#include <perspective/tdigest.h>
+#include <tsl/hopscotch_map.h>
 #include <perspective/pivot.h>
 #include <perspective/aggspec.h>
 #include <perspective/step_delta.h>
@@ -37,6 +43,7 @@ SUPPRESS_WARNINGS_VC(4503)
 namespace perspective {
 
 class t_gstate;
+struct t_ring_step;
 class t_dtree_ctx;
 class t_config;
 class t_ctx2;
@@ -47,16 +54,6 @@ using namespace boost::multi_index;
 typedef std::pair<t_depth, t_index> t_dptipair;
 typedef std::vector<t_dptipair> t_dptipairvec;
 
-struct by_idx {};
-
-struct by_depth {};
-
-struct by_pidx {};
-
-struct by_pidx_hash {};
-
-struct by_nstrands {};
-
 struct by_idx_pkey {};
 
 struct by_idx_lfidx {};
@@ -70,22 +67,12 @@ struct t_build_strand_table_common_rval {
     t_uindex m_npivotlike;
     std::vector<std::string> m_pivot_like_columns;
     t_uindex m_pivsize;
-};
 
-typedef multi_index_container<t_stnode,
-    indexed_by<ordered_unique<tag<by_idx>, BOOST_MULTI_INDEX_MEMBER(t_stnode, t_uindex, m_idx)>,
-        hashed_non_unique<tag<by_depth>,
-            BOOST_MULTI_INDEX_MEMBER(t_stnode, std::uint8_t, m_depth)>,
-        hashed_non_unique<tag<by_nstrands>,
-            BOOST_MULTI_INDEX_MEMBER(t_stnode, t_uindex, m_nstrands)>,
-        ordered_unique<tag<by_pidx>,
-            composite_key<t_stnode, BOOST_MULTI_INDEX_MEMBER(t_stnode, t_uindex, m_pidx),
-                BOOST_MULTI_INDEX_MEMBER(t_stnode, t_tscalar, m_sort_value),
-                BOOST_MULTI_INDEX_MEMBER(t_stnode, t_tscalar, m_value)>>,
-        ordered_unique<tag<by_pidx_hash>,
-            composite_key<t_stnode, BOOST_MULTI_INDEX_MEMBER(t_stnode, t_uindex, m_pidx),
-                BOOST_MULTI_INDEX_MEMBER(t_stnode, t_tscalar, m_value)>>>>
-    t_treenodes;
+    // The dependencies of aggregates which track their values follow the
+    // pivots in `m_pivot_like_columns`, and each strand's `psp_value_count`
+    // column says whether it adds or removes their values.
+    t_uindex m_nvalues;
+};
 
 typedef multi_index_container<t_stpkey,
     indexed_by<ordered_unique<tag<by_idx_pkey>,
@@ -99,19 +86,12 @@ typedef multi_index_container<t_stleaves,
             BOOST_MULTI_INDEX_MEMBER(t_stleaves, t_uindex, m_lfidx)>>>>
     t_idxleaf;
 
-typedef t_treenodes::index<by_idx>::type index_by_idx;
-typedef t_treenodes::index<by_pidx>::type index_by_pidx;
-
-typedef t_treenodes::index<by_idx>::type::iterator iter_by_idx;
-typedef t_treenodes::index<by_pidx>::type::iterator iter_by_pidx;
-typedef t_treenodes::index<by_pidx_hash>::type::iterator iter_by_pidx_hash;
-typedef std::pair<iter_by_pidx, iter_by_pidx> t_by_pidx_ipair;
-
 typedef t_idxpkey::index<by_idx_pkey>::type::iterator iter_by_idx_pkey;
 
 typedef std::pair<iter_by_idx_pkey, iter_by_idx_pkey> t_by_idx_pkey_ipair;
 
 struct PERSPECTIVE_EXPORT t_agg_update_info {
+    const t_dtree_ctx* m_ctx;
     std::vector<const t_column*> m_src;
     std::vector<t_column*> m_dst;
     std::vector<t_aggspec> m_aggspecs;
@@ -152,13 +132,13 @@ public:
     t_tscalar get_sortby_value(t_index idx) const;
 
     void build_strand_table_phase_1(t_tscalar pkey, t_op op, t_uindex idx, t_uindex npivots,
-        t_uindex strand_count_idx, t_uindex aggcolsize, bool force_current_row,
-        const std::vector<const t_column*>& piv_pcolcontexts,
+        t_uindex nvalues, t_uindex strand_count_idx, t_uindex aggcolsize,
+        bool force_current_row, const std::vector<const t_column*>& piv_pcolcontexts,
         const std::vector<const t_column*>& piv_tcols,
         const std::vector<const t_column*>& agg_ccols,
         const std::vector<const t_column*>& agg_dcols, std::vector<t_column*>& piv_scols,
         std::vector<t_column*>& agg_acols, t_column* agg_scountspar, t_column* spkey,
-        t_uindex& insert_count, bool& pivots_neq,
+        t_column* svalues, t_uindex& insert_count, bool& pivots_neq,
         const std::vector<std::string>& pivot_like) const;
 
     void build_strand_table_phase_2(t_tscalar pkey, t_uindex idx, t_uindex npivots,
@@ -166,7 +146,8 @@ public:
         const std::vector<const t_column*>& piv_pcols,
         const std::vector<const t_column*>& agg_pcols, std::vector<t_column*>& piv_scols,
         std::vector<t_column*>& agg_acols, t_column* agg_scount, t_column* spkey,
-        t_uindex& insert_count, const std::vector<std::string>& pivot_like) const;
+        t_column* svalues, t_uindex& insert_count,
+        const std::vector<std::string>& pivot_like) const;
 
     std::pair<std::shared_ptr<t_data_table>, std::shared_ptr<t_data_table>> build_strand_table(
         const t_data_table& flattened, const t_data_table& delta, const t_data_table& prev,
@@ -177,6 +158,21 @@ public:
         const t_data_table& flattened, const std::vector<t_aggspec>& aggspecs,
         const t_config& config) const;
 
+    /**
+     * @brief Build the strands for one update to a ring buffer: each evicted
+     * row that passed the filters is backed out of its old path with a
+     * strand count of -1 and its values negated, and each appended row
+     * that passes them is added to its new path with a strand count of 1.
+     *
+     * @param step
+     * @param aggspecs
+     * @param config
+     * @return std::pair<std::shared_ptr<t_data_table>, std::shared_ptr<t_data_table>>
+     */
+    std::pair<std::shared_ptr<t_data_table>, std::shared_ptr<t_data_table>> build_strand_table(
+        const t_ring_step& step, const std::vector<t_aggspec>& aggspecs,
+        const t_config& config) const;
+
     void update_shape_from_static(const t_dtree_ctx& ctx);
     void update_aggs_from_static(const t_dtree_ctx& ctx, const t_gstate& gstate);
 
@@ -262,7 +258,7 @@ public:
 
     void clear_aggregates(const std::vector<t_uindex>& indices);
 
-    std::pair<iter_by_idx, bool> insert_node(const t_tnode& node);
+    bool insert_node(const t_tnode& node);
     bool has_deltas() const;
     void set_has_deltas(bool v);
 
@@ -275,6 +271,15 @@ public:
     t_dfs_iter<t_stree> dfs() const;
     void pprint() const;
 
+    /**
+     * @brief Return the memory of the tree's `nodes`, the estimated memory
+     * of its `pkey_index` and `leaf_index`, and the exact memory of each
+     * column of the `aggregates` table.
+     *
+     * @return t_memory_report
+     */
+    t_memory_report get_memory_usage() const;
+
 protected:
     void mark_zero_desc();
     t_uindex get_num_aggcols() const;
@@ -288,6 +293,33 @@ protected:
 
     bool is_leaf(t_uindex nidx) const;
 
+    /**
+     * @brief Call `fn(value, count)` for the value of `depname` in each
+     * strand under `src_ridx` which adds or removes it from its node.
+     *
+     * @tparam FUNCTION_T
+     * @param info
+     * @param src_ridx
+     * @param depname
+     * @param fn
+     */
+    template <typename FUNCTION_T>
+    void for_each_strand_value(const t_agg_update_info& info, t_uindex src_ridx,
+        const std::string& depname, FUNCTION_T fn);
+
+    void record_agg_delta(
+        t_uindex nidx, t_uindex idx, const t_tscalar& old_value, const t_tscalar& new_value);
+
+    /**
+     * @brief Rebuild the sketches and digests which had values removed by
+     * the last update, deepest nodes first: leaves from the values of their pkeys,
+     * and every other node by merging the sketches of its children.
+     *
+     * @param info
+     * @param gstate
+     */
+    void rebuild_stale_sketches(const t_agg_update_info& info, const t_gstate& gstate);
+
     t_build_strand_table_common_rval build_strand_table_common(const t_data_table& flattened,
         const std::vector<t_aggspec>& aggspecs, const t_config& config) const;
 
@@ -316,6 +348,27 @@ private:
     t_symtable m_symtable;
     bool m_has_delta;
     std::string m_grand_agg_str;
+
+    // The values under each node for each order statistic aggregate, keyed
+    // by the aggregate's column and the node's row in `m_aggregates`.
+    tsl::hopscotch_map<std::pair<t_uindex, t_uindex>, t_order_statistic> m_order_stats;
+
+    // The distinct values under each node for each unique, join and
+    // distinct count aggregate, keyed as `m_order_stats` is.
+    tsl::hopscotch_map<std::pair<t_uindex, t_uindex>, t_value_counts> m_value_counts;
+
+    // The HyperLogLog sketch of each node for each approximate distinct
+    // count aggregate, keyed as `m_order_stats` is. Sketches cannot remove
+    // values, so the node and aggregate column of each sketch which had
+    // values removed is queued in `m_stale_sketches` and rebuilt once the
+    // update has been applied.
+    tsl::hopscotch_map<std::pair<t_uindex, t_uindex>, t_hyperloglog> m_sketches;
+
+    // The t-digest of each node for each approximate percentile aggregate,
+    // keyed as `m_order_stats` is, and rebuilt through `m_stale_sketches`
+    // as HyperLogLog sketches are.
+    tsl::hopscotch_map<std::pair<t_uindex, t_uindex>, t_tdigest> m_digests;
+    std::vector<std::pair<t_uindex, t_uindex>> m_stale_sketches;
 };
 
 
@@ -0,0 +1,141 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2017, the Perspective Authors.
+ *
+ * This file is part of the Perspective library, distributed under the terms of
+ * the Apache License 2.0.  The full license can be found in the LICENSE file.
+ *
+ */
+
+#pragma once
+#include <perspective/first.h>
+#include <perspective/base.h>
+#include <perspective/exports.h>
+#include <perspective/scalar.h>
+#include <perspective/sparse_tree_node.h>
+#include <perspective/memory_usage.h>
+#include <tsl/hopscotch_map.h>
+#include <tsl/hopscotch_set.h>
+#include <utility>
+#include <vector>
+
+namespace perspective {
+
+typedef std::pair<t_uindex, t_tscalar> t_stnode_key;
+
+struct PERSPECTIVE_EXPORT t_stnode_key_hash {
+    std::size_t operator()(const t_stnode_key& key) const;
+};
+
+/**
+ * @brief The nodes of a `t_stree`, stored contiguously in a vector of
+ * slots. A node is found by its `m_idx` through `m_slots`, and by its
+ * parent and value through `m_child_index`; both are open addressing hash
+ * maps. Each slot also owns the slots of its children, which are kept in
+ * `(m_sort_value, m_value)` order - an insert or sort value change that
+ * would break the order only marks the parent, and its children are
+ * sorted the next time they are read.
+ *
+ * Slots freed by `erase_zero_strands` are reused by later inserts, so
+ * callers hold on to node ids and never to slots.
+ */
+class PERSPECTIVE_EXPORT t_treenodes {
+public:
+    // Returned by `find_child` when there is no such child; this is
+    // `INVALID_INDEX` typed as a node id.
+    static const t_uindex NO_CHILD = static_cast<t_uindex>(INVALID_INDEX);
+
+    t_treenodes();
+
+    /**
+     * @brief Insert `node`, returning false if a node with the same
+     * `m_idx`, or with the same `m_pidx` and `m_value`, already exists.
+     *
+     * @param node
+     * @return true
+     * @return false
+     */
+    bool insert(const t_stnode& node);
+
+    bool contains(t_uindex idx) const;
+
+    /**
+     * @brief Return the node with id `idx`, or nullptr if it does not
+     * exist.
+     *
+     * @param idx
+     * @return const t_stnode*
+     */
+    const t_stnode* find(t_uindex idx) const;
+
+    /**
+     * @brief Return the id of the child of `pidx` with value `value`, or
+     * `NO_CHILD` if there is none.
+     *
+     * @param pidx
+     * @param value
+     * @return t_uindex
+     */
+    t_uindex find_child(t_uindex pidx, const t_tscalar& value) const;
+
+    void set_nstrands(t_uindex idx, t_uindex nstrands);
+    void set_sort_value(t_uindex idx, const t_tscalar& sort_value);
+
+    /**
+     * @brief Return the slots of the children of `idx` in sort order, which
+     * can be read with `get_slot` until the next mutation.
+     *
+     * @param idx
+     * @return const std::vector<t_uindex>&
+     */
+    const std::vector<t_uindex>& get_child_slots(t_uindex idx) const;
+    const t_stnode& get_slot(t_uindex slot) const;
+    t_uindex get_num_children(t_uindex idx) const;
+
+    /**
+     * @brief Return the position of `cidx` amongst the sorted children of
+     * `pidx`.
+     *
+     * @param pidx
+     * @param cidx
+     * @return t_index
+     */
+    t_index get_child_position(t_uindex pidx, t_uindex cidx) const;
+
+    /**
+     * @brief Return the ids of every node with no strands, in id order.
+     *
+     * @return std::vector<t_uindex>
+     */
+    std::vector<t_uindex> zero_strands() const;
+    void erase_zero_strands();
+
+    t_uindex size() const;
+    void clear();
+
+    /**
+     * @brief Return the memory of the node slots, the child lists and the
+     * three hash indices as one entry named `name`.
+     *
+     * @param name
+     * @return t_memory_usage
+     */
+    t_memory_usage get_memory_usage(const std::string& name) const;
+
+private:
+    t_uindex get_slot_idx(t_uindex idx) const;
+    bool child_lt(t_uindex lslot, t_uindex rslot) const;
+    void append_child(t_uindex pidx, t_uindex slot);
+    void mark_unsorted(t_uindex pidx);
+
+    std::vector<t_stnode> m_nodes;
+    mutable std::vector<std::vector<t_uindex>> m_children;
+    mutable std::vector<std::uint8_t> m_children_sorted;
+    std::vector<t_uindex> m_free_slots;
+    tsl::hopscotch_map<t_uindex, t_uindex> m_slots;
+    tsl::hopscotch_map<t_stnode_key, t_uindex, t_stnode_key_hash> m_child_index;
+    tsl::hopscotch_set<t_uindex> m_zero_strands;
+    std::vector<t_uindex> m_empty;
+};
+
+} // end namespace perspective
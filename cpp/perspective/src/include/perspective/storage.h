@@ -15,6 +15,7 @@
 #include <perspective/mask.h>
 #include <perspective/compat.h>
 #include <perspective/debug_helpers.h>
+#include <perspective/lstore_pool.h>
 #include <cmath>
 
 
@@ -59,7 +60,12 @@ struct PERSPECTIVE_EXPORT t_lstore_recipe {
     t_fflag m_mprot;
     t_fflag m_mflags;
     t_backing_store m_backing_store;
+    t_access_hint m_access_hint;
     bool m_from_recipe;
+
+    // serve memory backed stores from this pool instead of the system
+    // allocator, if set
+    std::shared_ptr<t_lstore_pool> m_pool;
 };
 
 typedef std::vector<t_lstore_recipe> t_lstore_argvec;
@@ -121,6 +127,13 @@ public:
     // in bytes
     void reserve(t_uindex capacity);
     void shrink(t_uindex capacity);
+
+    /**
+     * @brief Move a store served from a `t_lstore_pool` into a block from
+     * the system allocator, so that it grows with `realloc` and is freed
+     * rather than released to the pool. A no-op for stores without a pool.
+     */
+    void detach_pool();
     void copy(t_lstore& out);
     void load(const std::string& fname);
     void save(const std::string& fname);
@@ -181,6 +194,23 @@ public:
 
     t_lstore_recipe get_recipe() const;
 
+    /**
+     * @brief Return a recipe for a new, writable store of the same kind and
+     * capacity as this one, rather than one that shares its file like
+     * `get_recipe()`.
+     *
+     * @return t_lstore_recipe
+     */
+    t_lstore_recipe get_empty_recipe() const;
+
+    /**
+     * @brief Set how this store is expected to be read, and advise the OS
+     * accordingly if it is backed by a mapped file.
+     *
+     * @param hint
+     */
+    void set_access_hint(t_access_hint hint);
+
     void fill(const t_lstore& other);
 
     void fill(const t_lstore& other, const t_mask& mask, t_uindex elem_size);
@@ -220,6 +250,8 @@ private:
     void* create_mapping();
     void resize_mapping(t_uindex cap_new);
     void destroy_mapping();
+    void advise_mapping();
+    t_uindex disk_capacity(t_uindex capacity) const;
 
     void* m_base;
     std::string m_dirname;
@@ -236,10 +268,12 @@ private:
     t_fflag m_mprot;
     t_fflag m_mflags;
     t_backing_store m_backing_store;
+    t_access_hint m_access_hint;
     bool m_init;
     double m_resize_factor;
     t_uindex m_version;
     bool m_from_recipe;
+    std::shared_ptr<t_lstore_pool> m_pool;
 
 #ifdef PSP_MPROTECT
     // size of padding + size of fields above
@@ -247,7 +281,7 @@ private:
     // page_size. this invariant is checked in
     // the constructor if
     // mprotect is enabled
-    char m_padding[3820];
+    char m_padding[3800];
 #endif
 };
 
@@ -365,9 +399,11 @@ struct PERSPECTIVE_EXPORT t_column_recipe {
     t_lstore_recipe m_vlendata;
     t_lstore_recipe m_extents;
     t_lstore_recipe m_status;
+    t_lstore_recipe m_cleared;
     t_uindex m_vlenidx;
     t_uindex m_size;
     bool m_status_enabled;
+    bool m_status_packed;
 };
 
 } // end namespace perspective
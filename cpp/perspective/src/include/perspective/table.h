@@ -162,6 +162,47 @@ public:
      */
     void calculate_offset(std::uint32_t row_count);
 
+    /**
+     * @brief Write the rows, primary keys and free rows of this table to a
+     * snapshot file at `fname`, with sequential I/O.
+     *
+     * @param fname
+     */
+    void save_snapshot(const std::string& fname) const;
+
+    /**
+     * @brief Restore a snapshot written by `save_snapshot` into this table,
+     * which must be empty, have no views, and have been created with the
+     * same schema, index and limit. The snapshot is memory-mapped and its
+     * buffers are copied into the table without parsing them.
+     *
+     * @param fname
+     */
+    void load_snapshot(const std::string& fname);
+
+    /**
+     * @brief Move the rows of this table to `backing_store`. On
+     * `BACKING_STORE_DISK` its columns are memory-mapped files in
+     * `dirname`, so the table can grow larger than memory, and
+     * `access_hint` tells the OS whether they are mostly scanned or read at
+     * random. The table must have no views.
+     *
+     * @param backing_store
+     * @param dirname
+     * @param access_hint
+     */
+    void set_backing_store(
+        t_backing_store backing_store, const std::string& dirname, t_access_hint access_hint);
+
+    /**
+     * @brief Return the bytes reserved and used by each column of this
+     * table - its data, status and vocabulary - and by its primary key
+     * mapping, free rows and update pool. Views report their own memory.
+     *
+     * @return t_memory_report
+     */
+    t_memory_report get_memory_usage() const;
+
     // Getters
     t_uindex get_id() const;
     std::shared_ptr<t_pool> get_pool() const;
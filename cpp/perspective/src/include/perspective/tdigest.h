@@ -0,0 +1,77 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2017, the Perspective Authors.
+ *
+ * This file is part of the Perspective library, distributed under the terms of
+ * the Apache License 2.0.  The full license can be found in the LICENSE file.
+ *
+ */
+
+#pragma once
+#include <perspective/first.h>
+#include <perspective/base.h>
+#include <perspective/exports.h>
+#include <perspective/scalar.h>
+#include <perspective/memory_usage.h>
+#include <vector>
+
+namespace perspective {
+
+const double PSP_TDIGEST_DEFAULT_COMPRESSION = 100;
+
+/**
+ * @brief A merging t-digest, which approximates the distribution of the
+ * numeric values added to it with at most about `compression` weighted
+ * centroids. Centroids are kept small near both tails, so extreme
+ * quantiles such as p99 stay accurate.
+ *
+ * Added values are buffered and merged into the centroids in batches.
+ * Digests merge with each other, but values cannot be removed.
+ */
+class PERSPECTIVE_EXPORT t_tdigest {
+public:
+    t_tdigest();
+    t_tdigest(double compression);
+
+    /**
+     * @brief Add `value` `weight` times if it is a valid, non-NaN number;
+     * other values are ignored, as the numeric aggregates ignore nulls.
+     *
+     * @param value
+     * @param weight
+     */
+    void add(const t_tscalar& value, double weight = 1);
+    void add(double value, double weight);
+
+    void merge(const t_tdigest& other);
+    void clear();
+
+    /**
+     * @brief Return the approximate value at `quantile`, interpolating
+     * between the centroids around it, or NaN if there are no values.
+     *
+     * @param quantile
+     * @return double
+     */
+    double quantile(double quantile);
+
+    double count() const;
+    t_memory_usage get_memory_usage(const std::string& name) const;
+
+private:
+    struct t_centroid {
+        double m_mean;
+        double m_weight;
+    };
+
+    void compress();
+
+    double m_compression;
+    double m_count;
+    double m_min;
+    double m_max;
+    std::vector<t_centroid> m_centroids;
+    std::vector<t_centroid> m_buffer;
+};
+
+} // end namespace perspective
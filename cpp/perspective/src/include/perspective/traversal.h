@@ -83,6 +83,8 @@ public:
 
     t_index get_num_tree_leaves(t_index idx) const;
 
+    t_memory_usage get_memory_usage(const std::string& name) const;
+
     void post_order(t_index nidx, std::vector<t_index>& out_vec);
 
     // Traversal
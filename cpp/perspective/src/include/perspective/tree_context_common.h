@@ -39,6 +39,13 @@ PERSPECTIVE_EXPORT void notify_sparse_tree(std::shared_ptr<t_stree> tree,
     const std::vector<t_sortspec>& ctx_sortby, const t_data_table& flattened,
     const t_config& config, const t_gstate& gstate);
 
+PERSPECTIVE_EXPORT void notify_sparse_tree(std::shared_ptr<t_stree> tree,
+    std::shared_ptr<t_traversal> traversal, bool process_traversal,
+    const std::vector<t_aggspec>& aggregates,
+    const std::vector<std::pair<std::string, std::string>>& tree_sortby,
+    const std::vector<t_sortspec>& ctx_sortby, const t_ring_step& step,
+    const t_config& config, const t_gstate& gstate);
+
 template <typename CONTEXT_T>
 void
 ctx_expand_path(CONTEXT_T& ctx, t_header header, std::shared_ptr<t_stree> tree,
@@ -11,9 +11,11 @@
 #include <perspective/first.h>
 #include <perspective/base.h>
 #include <perspective/exports.h>
+#include <vector>
 
 namespace perspective {
 class t_pool;
+class t_gnode;
 
 class PERSPECTIVE_EXPORT t_update_task {
 public:
@@ -21,6 +23,19 @@ public:
     virtual void run();
 
 private:
+    /**
+     * @brief Process `port_id` on each of `gnodes`, returning whether each
+     * gnode notified its contexts. Gnodes are independent, so they are
+     * processed concurrently - userspace is not notified here, as it may
+     * only be called from the thread that runs the update task.
+     *
+     * @param gnodes
+     * @param port_id
+     * @return std::vector<std::uint8_t>
+     */
+    std::vector<std::uint8_t> process_gnodes(
+        const std::vector<t_gnode*>& gnodes, t_uindex port_id);
+
     t_pool& m_pool;
 };
 
@@ -0,0 +1,69 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2017, the Perspective Authors.
+ *
+ * This file is part of the Perspective library, distributed under the terms of
+ * the Apache License 2.0.  The full license can be found in the LICENSE file.
+ *
+ */
+
+#pragma once
+#include <perspective/first.h>
+#include <perspective/base.h>
+#include <perspective/exports.h>
+#include <perspective/scalar.h>
+#include <perspective/memory_usage.h>
+#include <tsl/hopscotch_map.h>
+#include <vector>
+
+namespace perspective {
+
+/**
+ * @brief A multiset of scalars, stored as the number of times each distinct
+ * value occurs, for aggregates which depend only on the distinct values
+ * under a tree node.
+ */
+class PERSPECTIVE_EXPORT t_value_counts {
+public:
+    t_value_counts();
+
+    /**
+     * @brief Add `count` copies of `value`, or remove them if `count` is
+     * negative, returning whether the set of distinct values changed.
+     *
+     * @param value
+     * @param count
+     * @return true
+     * @return false
+     */
+    bool update(const t_tscalar& value, t_index count);
+
+    t_uindex size() const;
+    t_uindex num_distinct() const;
+
+    /**
+     * @brief Whether there is at most one distinct value, which is written
+     * to `value` - none if there are no values - as `t_gstate::is_unique`
+     * does.
+     *
+     * @param value
+     * @return true
+     * @return false
+     */
+    bool is_unique(t_tscalar& value) const;
+
+    /**
+     * @brief Return the distinct values in ascending order.
+     *
+     * @return std::vector<t_tscalar>
+     */
+    std::vector<t_tscalar> get_sorted_values() const;
+
+    t_memory_usage get_memory_usage(const std::string& name) const;
+
+private:
+    t_uindex m_size;
+    tsl::hopscotch_map<t_tscalar, t_uindex> m_counts;
+};
+
+} // end namespace perspective
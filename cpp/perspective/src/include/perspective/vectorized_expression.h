@@ -0,0 +1,150 @@
+/******************************************************************************
+ *
+ * Copyright (c) 2019, the Perspective Authors.
+ *
+ * This file is part of the Perspective library, distributed under the terms of
+ * the Apache License 2.0.  The full license can be found in the LICENSE file.
+ *
+ */
+
+#pragma once
+
+#include <perspective/first.h>
+#include <perspective/base.h>
+#include <perspective/exports.h>
+#include <perspective/raw_types.h>
+#include <perspective/column.h>
+
+namespace perspective {
+
+/**
+ * @brief The buffers that a `t_vectorized_expression` evaluates one block
+ * of rows into - one value and validity buffer of `PSP_EXPRESSION_BLOCK_SIZE`
+ * per slot, where the first slots hold the input columns.
+ *
+ * Rows with `m_fallback` set could not be evaluated exactly by the
+ * vectorized kernels, and must be evaluated by exprtk instead.
+ */
+struct PERSPECTIVE_EXPORT t_vectorized_block {
+    t_vectorized_block(t_uindex num_slots);
+
+    std::vector<std::vector<double>> m_values;
+    std::vector<std::vector<std::uint8_t>> m_valid;
+    std::vector<std::uint8_t> m_fallback;
+};
+
+/**
+ * @brief A computed expression lowered from its parsed expression string into
+ * a sequence of kernels that each operate on a block of rows at a time,
+ * instead of evaluating the expression row by row over `t_tscalar` through
+ * exprtk.
+ *
+ * Only a subset of expressions can be lowered: numeric input columns and
+ * literals, arithmetic, comparisons, and the null checks, `min`, `max`,
+ * `percent_of` and the math builtins, producing a `DTYPE_FLOAT64` result.
+ * Every kernel reproduces the `t_tscalar` semantics of the same operation in
+ * exprtk, including null propagation - where that is not possible for a row,
+ * such as comparisons on null values, the row is marked for fallback.
+ * Anything else can not be lowered at all, and is left to exprtk.
+ */
+class PERSPECTIVE_EXPORT t_vectorized_expression {
+public:
+    enum t_opcode {
+        OPCODE_LITERAL,
+        OPCODE_NEG,
+        OPCODE_ADD,
+        OPCODE_SUB,
+        OPCODE_MUL,
+        OPCODE_DIV,
+        OPCODE_MOD,
+        OPCODE_LT,
+        OPCODE_LTE,
+        OPCODE_GT,
+        OPCODE_GTE,
+        OPCODE_EQ,
+        OPCODE_NEQ,
+        OPCODE_MIN,
+        OPCODE_MAX,
+        OPCODE_PERCENT_OF,
+        OPCODE_IS_NULL,
+        OPCODE_IS_NOT_NULL,
+        OPCODE_UNARY_FN
+    };
+
+    typedef double (*t_unary_fn)(double);
+
+    struct t_instruction {
+        t_opcode m_opcode;
+        t_uindex m_dst;
+        std::vector<t_uindex> m_args;
+        double m_literal;
+        t_unary_fn m_fn;
+    };
+
+    /**
+     * @brief Lower `parsed_expression_string`, reading input columns of
+     * `input_dtypes` in the order of `column_ids`. Returns `nullptr` if the
+     * expression contains anything that cannot be lowered.
+     *
+     * @param parsed_expression_string
+     * @param column_ids
+     * @param input_dtypes
+     * @return std::shared_ptr<t_vectorized_expression>
+     */
+    static std::shared_ptr<t_vectorized_expression> lower(
+        const std::string& parsed_expression_string,
+        const std::vector<std::pair<std::string, std::string>>& column_ids,
+        const std::vector<t_dtype>& input_dtypes);
+
+    /**
+     * @brief Returns whether the expression was lowered for input columns
+     * of `input_dtypes`.
+     *
+     * @param input_dtypes
+     * @return true
+     * @return false
+     */
+    bool accepts(const std::vector<t_dtype>& input_dtypes) const;
+
+    /**
+     * @brief Load rows `[offset, offset + num_rows)` of `column` into the
+     * slot of input `cidx`.
+     */
+    void load(t_vectorized_block& block, t_uindex cidx, const t_column* column,
+        t_uindex offset, t_uindex num_rows) const;
+
+    /**
+     * @brief Load row `ridx` of `column` into row `bidx` of the slot of
+     * input `cidx`.
+     */
+    void load_row(t_vectorized_block& block, t_uindex cidx, const t_column* column,
+        t_uindex ridx, t_uindex bidx) const;
+
+    /**
+     * @brief Evaluate the first `num_rows` rows of `block`, whose inputs
+     * have already been loaded.
+     *
+     * @param block
+     * @param num_rows
+     */
+    void evaluate(t_vectorized_block& block, t_uindex num_rows) const;
+
+    t_uindex num_slots() const;
+
+    /**
+     * @brief The slot that holds the result of the expression.
+     *
+     * @return t_uindex
+     */
+    t_uindex get_result_slot() const;
+
+private:
+    std::vector<t_dtype> m_input_dtypes;
+    std::vector<t_instruction> m_instructions;
+    t_uindex m_num_slots;
+    t_uindex m_result_slot;
+
+    friend class t_vectorized_lowering;
+};
+
+} // end namespace perspective
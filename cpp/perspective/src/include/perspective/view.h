@@ -233,6 +233,15 @@ public:
     std::vector<t_computed_expression> get_expressions() const;
     std::vector<t_tscalar> get_row_path(t_uindex idx) const;
     t_stepdelta get_step_delta(t_index bidx, t_index eidx) const;
+
+    /**
+     * @brief Return the bytes reserved and used by the context of this
+     * view - its trees, aggregate tables, traversals and sort index. The
+     * rows it reads from are reported by `Table::get_memory_usage`.
+     *
+     * @return t_memory_report
+     */
+    t_memory_report get_memory_usage() const;
     t_dtype get_column_dtype(t_uindex idx) const;
     bool is_column_only() const;
 #ifdef PSP_ENABLE_PYTHON
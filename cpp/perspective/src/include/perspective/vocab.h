@@ -11,6 +11,7 @@
 #include <perspective/first.h>
 #include <perspective/base.h>
 #include <perspective/storage.h>
+#include <perspective/memory_usage.h>
 #include <perspective/exports.h>
 #include <perspective/compat.h>
 #include <perspective/vocab.h>
@@ -53,6 +54,33 @@ public:
 
     void reserve(size_t total_string_size, size_t string_count);
 
+    /**
+     * @brief Move the vocabulary's stores to the system allocator, see
+     * `t_lstore::detach_pool`.
+     */
+    void detach_pool();
+
+    /**
+     * @brief Remove every string whose id is not marked in `live`, and
+     * renumber the remaining strings in order so that their ids are
+     * contiguous. `remap` is filled with the new id of each live id - ids
+     * of removed strings are left at 0.
+     *
+     * @param live
+     * @param remap
+     * @return t_uindex the number of bytes reclaimed.
+     */
+    t_uindex compact(const std::vector<bool>& live, std::vector<t_uindex>& remap);
+
+    /**
+     * @brief Return the memory of the string data, extents and lookup map
+     * of this vocabulary.
+     *
+     * @param name
+     * @return t_memory_usage
+     */
+    t_memory_usage get_memory_usage(const std::string& name) const;
+
 protected:
     // vlen interface
     t_uindex genidx();
@@ -101,6 +101,12 @@ table.prototype.get_index = async_queue("get_index", "table_method");
 
 table.prototype.get_limit = async_queue("get_limit", "table_method");
 
+table.prototype.set_batching = async_queue("set_batching", "table_method");
+
+table.prototype.get_batch_stats = async_queue("get_batch_stats", "table_method");
+
+table.prototype.get_memory_usage = async_queue("get_memory_usage", "table_method");
+
 table.prototype.make_port = async_queue("make_port", "table_method");
 
 table.prototype.remove_port = async_queue("remove_port", "table_method");
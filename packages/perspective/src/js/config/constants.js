@@ -38,6 +38,7 @@ const NUMBER_AGGREGATES = [
     "abs sum",
     "count",
     "distinct count",
+    "approx distinct count",
     "dominant",
     "first by index",
     "last by index",
@@ -46,6 +47,12 @@ const NUMBER_AGGREGATES = [
     "low",
     "mean",
     "median",
+    "p90",
+    "p95",
+    "p99",
+    "approx median",
+    "approx p95",
+    "approx p99",
     "pct sum parent",
     "pct sum grand total",
     "sum",
@@ -54,9 +61,9 @@ const NUMBER_AGGREGATES = [
     "unique"
 ];
 
-const STRING_AGGREGATES = ["any", "count", "distinct count", "distinct leaf", "dominant", "first by index", "last by index", "last", "unique"];
+const STRING_AGGREGATES = ["any", "count", "distinct count", "approx distinct count", "distinct leaf", "dominant", "first by index", "last by index", "last", "unique"];
 
-const BOOLEAN_AGGREGATES = ["any", "count", "distinct count", "distinct leaf", "dominant", "first by index", "last by index", "last", "unique", "and", "or"];
+const BOOLEAN_AGGREGATES = ["any", "count", "distinct count", "approx distinct count", "distinct leaf", "dominant", "first by index", "last by index", "last", "unique", "and", "or"];
 
 export const SORT_ORDERS = ["none", "asc", "desc", "col asc", "col desc", "asc abs", "desc abs", "col asc abs", "col desc abs"];
 
@@ -45,11 +45,22 @@ export default function(Module) {
      */
 
     let _POOL_DEBOUNCES = {};
+    let _POOL_TIMERS = {};
 
-    function _set_process(pool, table_id) {
+    function _set_process(pool, table_id, gnode_id) {
         if (!_POOL_DEBOUNCES[table_id]) {
             _POOL_DEBOUNCES[table_id] = pool;
-            setTimeout(() => _call_process(table_id));
+            const wait_ms = pool.get_batch_wait_ms(gnode_id);
+
+            // A batch without a latency bound waits for its row threshold,
+            // or for the table to be read.
+            if (!pool.is_batching(gnode_id) || pool.is_batch_ready(gnode_id) || wait_ms > 0) {
+                _POOL_TIMERS[table_id] = setTimeout(() => _call_process(table_id), wait_ms);
+            }
+        } else if (pool.is_batch_ready(gnode_id)) {
+            // The pending batch reached its row threshold before the timer
+            // fired, so process it now.
+            _call_process(table_id);
         }
     }
 
@@ -62,6 +73,8 @@ export default function(Module) {
     }
 
     function _remove_process(table_id) {
+        clearTimeout(_POOL_TIMERS[table_id]);
+        delete _POOL_TIMERS[table_id];
         delete _POOL_DEBOUNCES[table_id];
     }
 
@@ -109,7 +122,7 @@ export default function(Module) {
         const table_id = _Table.get_id();
 
         if (is_update || op == __MODULE__.t_op.OP_DELETE) {
-            _set_process(pool, table_id);
+            _set_process(pool, table_id, _Table.get_gnode().get_id());
         } else {
             pool._process();
         }
@@ -258,6 +271,21 @@ export default function(Module) {
         return extracted;
     }
 
+    /**
+     * Converts a `std::vector<t_memory_usage>` into an Object mapping the
+     * dotted name of each component to its `reserved` and `used` bytes, and
+     * deletes the vector.
+     */
+    function memory_report_to_object(vector) {
+        let report = {};
+        for (let i = 0; i < vector.size(); i++) {
+            const usage = vector.get(i);
+            report[usage.name] = {reserved: usage.reserved, used: usage.used};
+        }
+        vector.delete();
+        return report;
+    }
+
     const extract_vector_scalar = function(vector) {
         // handles deletion already - do not call delete() on the input vector
         // again
@@ -754,6 +782,23 @@ export default function(Module) {
         return this._View.num_rows();
     };
 
+    /**
+     * The memory held by this {@link module:perspective~view} - its trees,
+     * aggregates, traversals and sort index. The rows it reads from are
+     * reported by {@link module:perspective~table#get_memory_usage}.
+     *
+     * @async
+     *
+     * @returns {Promise<Object>} An Object mapping the dotted name of each
+     * component, e.g. `tree.nodes` or `traversal.sort_index`, to the number
+     * of bytes it has `reserved`, and the number of those that are `used`.
+     * Sizes of trees and indices are estimates.
+     */
+    view.prototype.get_memory_usage = function() {
+        _call_process(this.table.get_id());
+        return memory_report_to_object(this._View.get_memory_usage());
+    };
+
     /**
      * The number of aggregated columns in this {@link view}.  This is affected
      * by the "column_pivots" configuration parameter supplied to this
@@ -1144,6 +1189,40 @@ export default function(Module) {
         return this.limit;
     };
 
+    /**
+     * Batch updates to this {@link module:perspective~table}: rather than
+     * processing each call to `update()` or `remove()` separately, pending
+     * updates are merged and processed in a single step once `max_rows` rows
+     * are pending, or `max_latency_ms` milliseconds have elapsed since the
+     * first pending update, trading a bounded amount of latency for
+     * throughput. Reading from the table or its views always processes
+     * pending updates first.
+     *
+     * @param {Number} max_rows - the number of pending rows at which a batch
+     * is processed immediately, or 0 to only use `max_latency_ms`.
+     * @param {Number} max_latency_ms - the maximum time an update may be
+     * pending, or 0 to only use `max_rows`. Batching is disabled when both
+     * are 0.
+     */
+    table.prototype.set_batching = function(max_rows, max_latency_ms) {
+        this._Table.get_pool().set_batching(this.gnode_id, max_rows || 0, max_latency_ms || 0);
+    };
+
+    /**
+     * Returns counters for the batches of updates processed by this
+     * {@link module:perspective~table}.
+     *
+     * @returns {Object} an Object with the number of `batches` processed, and
+     * the number of `rows_coalesced` into batches of more than one update.
+     */
+    table.prototype.get_batch_stats = function() {
+        const pool = this._Table.get_pool();
+        return {
+            batches: pool.get_num_batches(this.gnode_id),
+            rows_coalesced: pool.get_num_rows_coalesced(this.gnode_id)
+        };
+    };
+
     /**
      * Remove all rows in this {@link module:perspective~table} while preserving
      * the schema and construction options.
@@ -1222,6 +1301,24 @@ export default function(Module) {
         return this._Table.size();
     };
 
+    /**
+     * The memory held by this {@link module:perspective~table}, not including
+     * its views - see {@link module:perspective~view#get_memory_usage}.
+     *
+     * @async
+     *
+     * @returns {Promise<Object>} An Object mapping the dotted name of each
+     * component to the number of bytes it has `reserved`, and the number of
+     * those that are `used`: `columns.<name>.data`, `columns.<name>.status`
+     * and `columns.<name>.vocab` for each column, `pkey_map` and `free_rows`
+     * for the primary key index, and `lstore_pool` for buffers retained
+     * between updates.
+     */
+    table.prototype.get_memory_usage = function() {
+        _call_process(this._Table.get_id());
+        return memory_report_to_object(this._Table.get_memory_usage());
+    };
+
     /**
      * The schema of this {@link module:perspective~table}.  A schema is an
      * Object whose keys are the columns of this
@@ -408,6 +408,21 @@ module.exports = perspective => {
                 view.delete();
                 table.delete();
             });
+
+            it("y == 'a' OR x > 3", async function() {
+                var table = await perspective.table(data);
+                var view = await table.view({
+                    filter_op: "or",
+                    filter: [
+                        ["y", "==", "a"],
+                        ["x", ">", 3]
+                    ]
+                });
+                let json = await view.to_json();
+                expect(json).toEqual([rdata[0], rdata[3]]);
+                view.delete();
+                table.delete();
+            });
         });
 
         describe("is null", function() {
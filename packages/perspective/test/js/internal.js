@@ -46,5 +46,28 @@ module.exports = (perspective, mode) => {
             }
             table.delete();
         });
+
+        describe("Memory usage", function() {
+            it("reports the data, status and vocab of each column", async function() {
+                var table = await perspective.table({a: [1, 2, null], b: ["x", "y", "x"]}, {index: "a"});
+                let usage = await table.get_memory_usage();
+                expect(usage["columns.a.data"].used).toBeGreaterThanOrEqual(3 * 4);
+                expect(usage["columns.b.vocab"].used).toBeGreaterThan(0);
+                expect(usage["columns.b.status"].reserved).toBeGreaterThanOrEqual(usage["columns.b.status"].used);
+                expect(usage["pkey_map"].used).toBeGreaterThan(0);
+                table.delete();
+            });
+
+            it("reports the tree and traversal of a pivoted view", async function() {
+                var table = await perspective.table({a: [1, 2, 3], b: ["x", "y", "x"]});
+                var view = await table.view({row_pivots: ["b"], columns: ["a"]});
+                let usage = await view.get_memory_usage();
+                expect(usage["tree.nodes"].used).toBeGreaterThan(0);
+                expect(usage["tree.aggregates.a.data"].used).toBeGreaterThan(0);
+                expect(usage["traversal"].used).toBeGreaterThan(0);
+                view.delete();
+                table.delete();
+            });
+        });
     });
 };
@@ -911,6 +911,54 @@ module.exports = perspective => {
         });
     });
 
+    describe("Batching", function() {
+        it("coalesces updates until `max_rows` rows are pending", async function() {
+            var table = await perspective.table(meta);
+            await table.set_batching(8, 1000);
+            var view = await table.view();
+            table.update(data);
+            table.update(data_2);
+            let result = await view.to_json();
+            expect(result).toEqual(data.concat(data_2));
+            let stats = await table.get_batch_stats();
+            expect(stats.rows_coalesced).toEqual(8);
+            view.delete();
+            table.delete();
+        });
+
+        it("waits for `max_rows` rows without a `max_latency_ms`", async function() {
+            var table = await perspective.table(meta);
+            await table.set_batching(8, 0);
+            var view = await table.view();
+            var updates = 0;
+            view.on_update(() => updates++);
+            table.update(data);
+            await new Promise(resolve => setTimeout(resolve, 50));
+            expect(updates).toEqual(0);
+            table.update(data_2);
+            await new Promise(resolve => setTimeout(resolve, 50));
+            expect(updates).toEqual(1);
+            let stats = await table.get_batch_stats();
+            expect(stats).toEqual({batches: 1, rows_coalesced: 8});
+            view.delete();
+            table.delete();
+        });
+
+        it("processes each update separately by default", async function() {
+            var table = await perspective.table(meta);
+            var view = await table.view();
+            table.update(data);
+            await view.to_json();
+            table.update(data_2);
+            let result = await view.to_json();
+            expect(result).toEqual(data.concat(data_2));
+            let stats = await table.get_batch_stats();
+            expect(stats.rows_coalesced).toEqual(0);
+            view.delete();
+            table.delete();
+        });
+    });
+
     describe("Limit", function() {
         it("{limit: 2} with table of size 4", async function() {
             var table = await perspective.table(data, {limit: 2});
@@ -19,6 +19,10 @@ class Aggregate(Enum):
 
     AND = "and"
     ANY = "any"
+    APPROX_DISTINCT_COUNT = "approx distinct count"
+    APPROX_MEDIAN = "approx median"
+    APPROX_P95 = "approx p95"
+    APPROX_P99 = "approx p99"
     AVG = "avg"
     COUNT = "count"
     DISTINCT_COUNT = "distinct count"
@@ -32,6 +36,9 @@ class Aggregate(Enum):
     MEAN = "mean"
     MEDIAN = "median"
     OR = "or"
+    P90 = "p90"
+    P95 = "p95"
+    P99 = "p99"
     PCT_SUM_PARENT = "pct sum parent"
     PCT_SUM_GRAND_TOTAL = "pct sum grand total"
     SUM = "sum"
@@ -78,6 +78,10 @@ PYBIND11_MODULE(libbinding, m)
         .def("reset_gnode", &Table::reset_gnode)
         .def("make_port", &Table::make_port)
         .def("remove_port", &Table::remove_port)
+        .def("save_snapshot", &Table::save_snapshot)
+        .def("load_snapshot", &Table::load_snapshot)
+        .def("set_backing_store", &Table::set_backing_store)
+        .def("get_memory_usage", &Table::get_memory_usage)
         .def("get_id", &Table::get_id)
         .def("get_pool", &Table::get_pool)
         .def("get_gnode", &Table::get_gnode);
@@ -108,6 +112,7 @@ PYBIND11_MODULE(libbinding, m)
         .def("get_sort", &View<t_ctxunit>::get_sort)
         .def("get_min_max", &View<t_ctxunit>::get_min_max)
         .def("get_step_delta", &View<t_ctxunit>::get_step_delta)
+        .def("get_memory_usage", &View<t_ctxunit>::get_memory_usage)
         .def("get_column_dtype", &View<t_ctxunit>::get_column_dtype)
         .def("is_column_only", &View<t_ctxunit>::is_column_only);
 
@@ -132,6 +137,7 @@ PYBIND11_MODULE(libbinding, m)
         .def("get_sort", &View<t_ctx0>::get_sort)
         .def("get_min_max", &View<t_ctx0>::get_min_max)
         .def("get_step_delta", &View<t_ctx0>::get_step_delta)
+        .def("get_memory_usage", &View<t_ctx0>::get_memory_usage)
         .def("get_column_dtype", &View<t_ctx0>::get_column_dtype)
         .def("is_column_only", &View<t_ctx0>::is_column_only);
 
@@ -159,6 +165,7 @@ PYBIND11_MODULE(libbinding, m)
         .def("get_sort", &View<t_ctx1>::get_sort)
         .def("get_min_max", &View<t_ctx1>::get_min_max)
         .def("get_step_delta", &View<t_ctx1>::get_step_delta)
+        .def("get_memory_usage", &View<t_ctx1>::get_memory_usage)
         .def("get_column_dtype", &View<t_ctx1>::get_column_dtype)
         .def("is_column_only", &View<t_ctx1>::is_column_only);
 
@@ -187,6 +194,7 @@ PYBIND11_MODULE(libbinding, m)
         .def("get_min_max", &View<t_ctx2>::get_min_max)
         .def("get_row_path", &View<t_ctx2>::get_row_path)
         .def("get_step_delta", &View<t_ctx2>::get_step_delta)
+        .def("get_memory_usage", &View<t_ctx2>::get_memory_usage)
         .def("get_column_dtype", &View<t_ctx2>::get_column_dtype)
         .def("is_column_only", &View<t_ctx2>::is_column_only);
 
@@ -229,7 +237,20 @@ PYBIND11_MODULE(libbinding, m)
      * t_gnode
      */
     py::class_<t_gnode, std::shared_ptr<t_gnode>>(m, "t_gnode")
-        .def("get_id", reinterpret_cast<t_uindex (t_gnode::*)() const>(&t_gnode::get_id));
+        .def("get_id", reinterpret_cast<t_uindex (t_gnode::*)() const>(&t_gnode::get_id))
+        .def("get_lstore_pool_stats", &t_gnode::get_lstore_pool_stats)
+        .def("get_vocab_bytes_reclaimed", &t_gnode::get_vocab_bytes_reclaimed);
+
+    /******************************************************************************
+     *
+     * t_lstore_pool_stats
+     */
+    py::class_<t_lstore_pool_stats>(m, "t_lstore_pool_stats")
+        .def(py::init<>())
+        .def_readwrite("bytes_reused", &t_lstore_pool_stats::m_bytes_reused)
+        .def_readwrite("bytes_allocated", &t_lstore_pool_stats::m_bytes_allocated)
+        .def_readwrite("bytes_retained", &t_lstore_pool_stats::m_bytes_retained)
+        .def_readwrite("num_resets", &t_lstore_pool_stats::m_num_resets);
 
     /******************************************************************************
      *
@@ -293,8 +314,15 @@ PYBIND11_MODULE(libbinding, m)
     py::class_<t_pool, std::shared_ptr<t_pool>>(m, "t_pool")
         .def(py::init<>())
         .def("set_update_delegate", &t_pool::set_update_delegate)
+        .def("set_gnode_update_delegate", &t_pool::set_gnode_update_delegate)
         .def("unregister_gnode", &t_pool::unregister_gnode)
         .def("set_event_loop", &t_pool::set_event_loop)
+        .def("set_batching", &t_pool::set_batching)
+        .def("is_batching", &t_pool::is_batching)
+        .def("is_batch_ready", &t_pool::is_batch_ready)
+        .def("get_batch_wait_ms", &t_pool::get_batch_wait_ms)
+        .def("get_num_batches", &t_pool::get_num_batches)
+        .def("get_num_rows_coalesced", &t_pool::get_num_rows_coalesced)
         .def("_process", &t_pool::_process);
 
     /******************************************************************************
@@ -344,6 +372,16 @@ PYBIND11_MODULE(libbinding, m)
         .def_readwrite("columns_changed", &t_stepdelta::columns_changed)
         .def_readwrite("cells", &t_stepdelta::cells);
 
+    /******************************************************************************
+     *
+     * t_memory_usage
+     */
+    py::class_<t_memory_usage>(m, "t_memory_usage")
+        .def(py::init<>())
+        .def_readwrite("name", &t_memory_usage::m_name)
+        .def_readwrite("reserved", &t_memory_usage::m_reserved)
+        .def_readwrite("used", &t_memory_usage::m_used);
+
     /******************************************************************************
      *
      * t_dtype
@@ -403,6 +441,23 @@ PYBIND11_MODULE(libbinding, m)
         .value("OP_DELETE", OP_DELETE)
         .value("OP_CLEAR", OP_CLEAR);
 
+    /******************************************************************************
+     *
+     * t_backing_store
+     */
+    py::enum_<t_backing_store>(m, "t_backing_store")
+        .value("BACKING_STORE_MEMORY", BACKING_STORE_MEMORY)
+        .value("BACKING_STORE_DISK", BACKING_STORE_DISK);
+
+    /******************************************************************************
+     *
+     * t_access_hint
+     */
+    py::enum_<t_access_hint>(m, "t_access_hint")
+        .value("ACCESS_HINT_NORMAL", ACCESS_HINT_NORMAL)
+        .value("ACCESS_HINT_SEQUENTIAL", ACCESS_HINT_SEQUENTIAL)
+        .value("ACCESS_HINT_RANDOM", ACCESS_HINT_RANDOM);
+
     /******************************************************************************
      *
      * Perspective defs
@@ -94,9 +94,7 @@ class PerspectiveManager(_PerspectiveManagerInternal):
         if self._loop_callback is not None:
             # always bind the callback to the table's state manager
             self._loop_callback(lambda: table._table.get_pool().set_event_loop())
-            table._state_manager.queue_process = partial(
-                self._loop_callback, table._state_manager.call_process
-            )
+            self._set_queue_process(table)
         self._tables[name] = table
         return name
 
@@ -141,6 +139,25 @@ class PerspectiveManager(_PerspectiveManagerInternal):
         self._loop_callback = loop_callback
         for table in self._tables.values():
             loop_callback(lambda: table._table.get_pool().set_event_loop())
-            table._state_manager.queue_process = partial(
-                loop_callback, table._state_manager.call_process
+            self._set_queue_process(table)
+
+    def _set_queue_process(self, table):
+        """Process the updates of a hosted :obj:`~perspective.Table` on this
+        manager's event loop, waiting out the latency bound of a batching
+        policy with the loop's own `call_later` if `loop_callback` is bound to
+        a loop which has one, such as tornado's `IOLoop.add_callback`.
+        Otherwise a timer thread queues the wait's end with `loop_callback`.
+        """
+        state_manager = table._state_manager
+        state_manager.queue_process = partial(
+            self._loop_callback, state_manager.call_process_when_ready
+        )
+
+        loop = getattr(self._loop_callback, "__self__", None)
+        if callable(getattr(loop, "call_later", None)):
+            state_manager.call_later = loop.call_later
+        else:
+            loop_callback = self._loop_callback
+            state_manager.call_later = lambda delay, f, *args: (
+                state_manager._call_later_timer(delay, loop_callback, f, *args)
             )
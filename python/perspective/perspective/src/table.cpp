@@ -28,7 +28,8 @@ namespace binding {
  */
 
 std::shared_ptr<Table> make_table_py(t_val table, t_data_accessor accessor,
-        std::uint32_t limit, py::str index, t_op op, bool is_update, bool is_arrow, t_uindex port_id) {
+        std::uint32_t limit, py::str index, t_op op, bool is_update, bool is_arrow, t_uindex port_id,
+        t_val shared_pool) {
     bool table_initialized = !table.is_none();
     std::shared_ptr<t_pool> pool;
     std::shared_ptr<Table> tbl;
@@ -43,6 +44,10 @@ std::shared_ptr<Table> make_table_py(t_val table, t_data_accessor accessor,
         gnode = tbl->get_gnode();
         offset = tbl->get_offset();
         is_update = (is_update || gnode->mapping_size() > 0);
+    } else if (!shared_pool.is_none()) {
+        // Process the new Table's updates in the same pool as the Tables
+        // that already share it.
+        pool = shared_pool.cast<std::shared_ptr<t_pool>>();
     } else {
         pool = std::make_shared<t_pool>();
     }
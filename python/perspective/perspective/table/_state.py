@@ -6,6 +6,8 @@
 # the Apache License 2.0.  The full license can be found in the LICENSE file.
 #
 
+import threading
+
 
 class _PerspectiveStateManager(object):
     """Internal state management class that controls when `_process` is called
@@ -29,19 +31,36 @@ class _PerspectiveStateManager(object):
     Though each :obj:`~perspective.Table` contains a separate instance of the
     state manager, `TO_PROCESS`, which contains the `t_pool` objects for pending
     `_process` calls, is shared amongst all instances of the state manager.
+
+    When the Table has a batching policy with a latency bound, and an event
+    loop sets `call_later`, which has the signature of `loop.call_later(delay,
+    callback, *args)`, the pending updates are processed on the loop once the
+    bound is reached. Without an event loop, `call_later` is `None` and the
+    bound is checked by the next `update()`, so pending updates are always
+    processed on the caller's thread, at the latest when the Table is read.
     """
 
     TO_PROCESS = {}
 
-    def __init__(self):
+    def __init__(self, gnode_id):
         """Create a new instance of the state manager, and enable the default behavior
         of calling `_process()` synchronously.
 
         New instances of :obj:`_PerspectiveStateManager` have no awareness of whether
         an event loop is present - the instance's `queue_process` method must be
         overridden.
+
+        Args:
+            gnode_id (:obj`int`): the ID of the Table's gnode in its pool,
+                which the pool's batching policy is keyed by.
         """
         self.queue_process = self._queue_process_immediate
+        self.call_later = None
+        self._gnode_id = gnode_id
+
+        # Incremented whenever the pending updates are processed, so that a
+        # `call_later` callback scheduled for an earlier batch does nothing.
+        self._generation = 0
 
     def set_process(self, pool, table_id):
         """Queue a `_process` call on the specified pool and table ID.
@@ -56,6 +75,10 @@ class _PerspectiveStateManager(object):
         if table_id not in _PerspectiveStateManager.TO_PROCESS:
             _PerspectiveStateManager.TO_PROCESS[table_id] = pool
             self.queue_process(table_id)
+        elif pool.is_batch_ready(self._gnode_id):
+            # The pending batch reached its row threshold or latency bound,
+            # so process it now instead of waiting for `queue_process`.
+            self.call_process(table_id)
 
     def call_process(self, table_id):
         """Given a table_id, find the corresponding pool and call `process()`
@@ -70,6 +93,34 @@ class _PerspectiveStateManager(object):
             pool._process()
             self.remove_process(table_id)
 
+    def call_process_when_ready(self, table_id):
+        """Call `call_process` for the table if its pending updates should
+        be processed according to its batching policy. Otherwise, if the
+        policy has a latency bound and `call_later` is set, schedule this
+        method once with `call_later` for when the bound is reached; in any
+        other case the batch waits for `set_process` to reach the policy's
+        threshold or bound, or for the table to be read.
+
+        Event loop implementations of `queue_process` should call this
+        method rather than `call_process`.
+
+        Args:
+            table_id (:obj`int`): The unique ID of the Table
+        """
+        pool = _PerspectiveStateManager.TO_PROCESS.get(table_id, None)
+        if pool is None:
+            return
+
+        if not pool.is_batching(self._gnode_id) or pool.is_batch_ready(self._gnode_id):
+            self.call_process(table_id)
+            return
+
+        wait_ms = pool.get_batch_wait_ms(self._gnode_id)
+        if wait_ms > 0 and self.call_later is not None:
+            self.call_later(
+                wait_ms / 1000.0, self._call_process_when_due, table_id, self._generation
+            )
+
     def remove_process(self, table_id):
         """Remove a pool from the execution cache, indicating that it should no
         longer be operated on.
@@ -78,6 +129,32 @@ class _PerspectiveStateManager(object):
             table_id (:obj`int`): The unique ID of the Table
         """
         _PerspectiveStateManager.TO_PROCESS.pop(table_id, None)
+        self._generation += 1
+
+    def _call_process_when_due(self, table_id, generation):
+        """The `call_later` callback of `call_process_when_ready`, which does
+        nothing if the batch it was scheduled for has been processed.
+
+        Args:
+            table_id (:obj`int`): The unique ID of the Table
+            generation (:obj`int`): `_generation` when it was scheduled
+        """
+        if generation == self._generation:
+            self.call_process_when_ready(table_id)
+
+    def _call_later_timer(self, delay, callback, *args):
+        """Call `callback` with `args` after `delay` seconds on a daemon timer
+        thread, for event loops without a `call_later` of their own, whose
+        callback hands the call back to the loop.
+
+        Args:
+            delay (:obj`float`): The delay in seconds
+            callback (:obj`callable`): The function to call
+        """
+        timer = threading.Timer(delay, callback, args)
+        timer.daemon = True
+        timer.start()
+        return timer
 
     def _queue_process_immediate(self, table_id):
         """Immediately execute `call_process` on the pool as soon
@@ -87,7 +164,11 @@ class _PerspectiveStateManager(object):
         without an event loop, meaning that calls to :obj:`~perspective.Table`'s
         `update()` method are immediately followed by a call to `_process`.
 
+        If the Table has a batching policy, the pending updates are instead
+        processed by the first `update()` that reaches the policy's row
+        threshold or latency bound, or when the table is read.
+
         Args:
             table_id (:obj`int`): The unique ID of the Table
         """
-        self.call_process(table_id)
+        self.call_process_when_ready(table_id)
@@ -105,6 +105,15 @@ def _pythontype_to_str(typestring):
     return _extract_type(typestring, mapping)
 
 
+def _memory_report_to_dict(report):
+    """Converts a list of `t_memory_usage` into a :obj:`dict` mapping the
+    dotted name of each component to its ``reserved`` and ``used`` bytes."""
+    return {
+        usage.name: {"reserved": usage.reserved, "used": usage.used}
+        for usage in report
+    }
+
+
 def _replace_expression_column_name(
     column_name_map, column_id_map, running_cidx, match_obj
 ):
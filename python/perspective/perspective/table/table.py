@@ -19,6 +19,7 @@ from ._utils import (
     _dtype_to_str,
     _str_to_pythontype,
     _parse_expression_strings,
+    _memory_report_to_dict,
 )
 from .libbinding import (
     make_table,
@@ -27,11 +28,13 @@ from .libbinding import (
     t_filter_op,
     t_op,
     t_dtype,
+    t_backing_store,
+    t_access_hint,
 )
 
 
 class Table(object):
-    def __init__(self, data, limit=None, index=None):
+    def __init__(self, data, limit=None, index=None, share_pool_with=None):
         """Construct a :class:`~perspective.Table` using the provided data or
         schema and optional configuration dictionary.
 
@@ -51,6 +54,12 @@ class Table(object):
                 :class:`~perspective.Table` should have.  Cannot be set at the
                 same time as ``index``. Updates past the limit will begin
                 writing at row 0.
+            share_pool_with (:obj:`Table`): Another
+                :class:`~perspective.Table` whose update pool this
+                :class:`~perspective.Table` should share.  Updates to
+                :class:`~perspective.Table` instances that share a pool are
+                processed together, in parallel across tables, though each
+                keeps its own batching policy.
         """
         self._is_arrow = isinstance(data, (bytes, bytearray))
         if self._is_arrow:
@@ -75,6 +84,7 @@ class Table(object):
             False,
             self._is_arrow,
             0,
+            share_pool_with._table.get_pool() if share_pool_with is not None else None,
         )
 
         self._gnode_id = self._table.get_gnode().get_id()
@@ -84,11 +94,11 @@ class Table(object):
         self._delete_callback = None
 
         pool = self._table.get_pool()
-        pool.set_update_delegate(self)
+        pool.set_gnode_update_delegate(self._gnode_id, self)
         pool._process()
 
         # Each table always contains its own instance of state manager.
-        self._state_manager = _PerspectiveStateManager()
+        self._state_manager = _PerspectiveStateManager(self._gnode_id)
 
     def make_port(self):
         """Create a new input port on the underlying `gnode`, and return an
@@ -110,6 +120,46 @@ class Table(object):
         specified by the user."""
         return self._limit
 
+    def set_batching(self, max_rows=0, max_latency_ms=0):
+        """Batch updates to this :class:`~perspective.Table`: rather than
+        processing each call to ``update()`` or ``remove()`` separately,
+        pending updates are merged and processed in a single step once
+        ``max_rows`` rows are pending, or ``max_latency_ms`` milliseconds have
+        elapsed since the first pending update. Reading from the
+        :class:`~perspective.Table` or its views always processes pending
+        updates first.
+
+        Without an event loop (see
+        :meth:`~perspective.PerspectiveManager.set_loop_callback`), the
+        latency bound is checked by the next ``update()`` rather than by a
+        timer, so updates are always processed on the caller's thread.
+        :class:`~perspective.Table` instances that share an update pool each
+        have their own policy, but processing one processes the pending
+        updates of all of them.
+
+        Args:
+            max_rows (:obj:`int`): the number of pending rows at which a batch
+                is processed immediately, or 0 to only use ``max_latency_ms``.
+            max_latency_ms (:obj:`int`): the maximum time an update may be
+                pending, or 0 to only use ``max_rows``. Batching is disabled
+                when both are 0.
+        """
+        self._table.get_pool().set_batching(
+            self._gnode_id, max_rows or 0, max_latency_ms or 0
+        )
+
+    def get_batch_stats(self):
+        """Returns a :obj:`dict` of counters for the batches of updates
+        processed by this :class:`~perspective.Table` - the number of
+        ``batches`` processed, and the number of ``rows_coalesced`` into
+        batches of more than one update.
+        """
+        pool = self._table.get_pool()
+        return {
+            "batches": pool.get_num_batches(self._gnode_id),
+            "rows_coalesced": pool.get_num_rows_coalesced(self._gnode_id),
+        }
+
     def clear(self):
         """Removes all the rows in the :class:`~perspective.Table`, but
         preserves everything else including the schema and any callbacks or
@@ -131,6 +181,82 @@ class Table(object):
         self.update(data)
         self._state_manager.call_process(self._table.get_id())
 
+    def save_snapshot(self, path):
+        """Writes the rows of this :class:`~perspective.Table` to a binary
+        snapshot file at ``path``, after processing any pending updates.
+
+        Args:
+            path (:obj:`str`): the file to write the snapshot to.
+        """
+        self._state_manager.call_process(self._table.get_id())
+        self._table.save_snapshot(path)
+
+    def load_snapshot(self, path):
+        """Restores a snapshot written by
+        :meth:`~perspective.Table.save_snapshot` into this
+        :class:`~perspective.Table`, which must be empty, have no
+        :class:`~perspective.View`, and have been created with the same
+        schema, ``index`` and ``limit`` as the saved
+        :class:`~perspective.Table`.
+
+        Args:
+            path (:obj:`str`): the snapshot file to restore.
+        """
+        self._state_manager.call_process(self._table.get_id())
+        self._table.load_snapshot(path)
+
+    def set_storage(self, path=None, access="normal"):
+        """Moves the rows of this :class:`~perspective.Table` to
+        memory-mapped files in the directory ``path``, so that it can grow
+        larger than memory and the OS can page out columns that are not
+        being read, or back to memory if ``path`` is ``None``. The
+        :class:`~perspective.Table` must not have any
+        :class:`~perspective.View`.
+
+        Keyword Args:
+            path (:obj:`str`): an existing directory for the column files,
+                which are deleted with the :class:`~perspective.Table`.
+            access (:obj:`str`): how the columns will mostly be read, one of
+                "normal", "sequential" or "random".
+        """
+        hints = {
+            "normal": t_access_hint.ACCESS_HINT_NORMAL,
+            "sequential": t_access_hint.ACCESS_HINT_SEQUENTIAL,
+            "random": t_access_hint.ACCESS_HINT_RANDOM,
+        }
+
+        if access not in hints:
+            raise PerspectiveError(
+                "Unknown access pattern `{}`, expected one of {}".format(
+                    access, ", ".join(sorted(hints))
+                )
+            )
+
+        self._state_manager.call_process(self._table.get_id())
+        if path is None:
+            self._table.set_backing_store(
+                t_backing_store.BACKING_STORE_MEMORY, "", hints[access]
+            )
+        else:
+            self._table.set_backing_store(
+                t_backing_store.BACKING_STORE_DISK, str(path), hints[access]
+            )
+
+    def get_memory_usage(self):
+        """Returns the memory held by this :class:`~perspective.Table`, as a
+        :obj:`dict` mapping each component to the number of bytes it has
+        ``reserved``, and the number of those bytes that are ``used``.
+
+        Components are named by dotted paths: ``columns.<name>.data``,
+        ``columns.<name>.status`` and ``columns.<name>.vocab`` for each
+        column, ``pkey_map`` and ``free_rows`` for the primary key index, and
+        ``lstore_pool`` for buffers retained between updates. The memory of
+        each :class:`~perspective.View` is reported by
+        :meth:`~perspective.View.get_memory_usage`.
+        """
+        self._state_manager.call_process(self._table.get_id())
+        return _memory_report_to_dict(self._table.get_memory_usage())
+
     def size(self):
         """Returns the row count of the :class:`~perspective.Table`."""
         self._state_manager.call_process(self._table.get_id())
@@ -279,6 +405,7 @@ class Table(object):
                 True,
                 True,
                 port_id,
+                None,
             )
             self._state_manager.set_process(
                 self._table.get_pool(), self._table.get_id()
@@ -316,6 +443,7 @@ class Table(object):
             True,
             False,
             port_id,
+            None,
         )
         self._state_manager.set_process(self._table.get_pool(), self._table.get_id())
 
@@ -353,6 +481,7 @@ class Table(object):
             True,
             False,
             port_id,
+            None,
         )
 
         self._state_manager.set_process(t.get_pool(), t.get_id())
@@ -14,7 +14,7 @@ from random import random
 from .view_config import ViewConfig
 from ._data_formatter import to_format, _parse_format_options
 from ._constants import COLUMN_SEPARATOR_STRING
-from ._utils import _str_to_pythontype
+from ._utils import _str_to_pythontype, _memory_report_to_dict
 from ._callback_cache import _PerspectiveCallBackCache
 from ._date_validator import _PerspectiveDateValidator
 from .libbinding import (
@@ -165,6 +165,19 @@ class View(object):
         """
         return self._view.num_rows()
 
+    def get_memory_usage(self):
+        """Returns the memory held by this :class:`~perspective.View`, as a
+        :obj:`dict` mapping each component to the number of bytes it has
+        ``reserved``, and the number of those bytes that are ``used``.
+
+        Components are named by dotted paths, e.g. ``tree.nodes``,
+        ``tree.aggregates.<name>.data`` and ``traversal`` for a pivoted
+        :class:`~perspective.View`, or ``traversal.sort_index`` for a flat
+        one. Sizes of trees and indices are estimates.
+        """
+        self._table._state_manager.call_process(self._table._table.get_id())
+        return _memory_report_to_dict(self._view.get_memory_usage())
+
     def num_columns(self):
         """The number of aggregated columns in the :class:`~perspective.View`.
         This is affected by the ``column_pivots`` that are applied to the
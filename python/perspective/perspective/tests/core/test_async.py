@@ -361,3 +361,44 @@ class TestAsync(object):
         assert sentinel["async"] == 2
         assert sentinel["sync"] == 12
         tbl2.delete()
+
+    def test_async_batching_max_latency(self):
+        tbl = Table({"a": int, "b": float, "c": str})
+        manager = PerspectiveManager()
+        manager.set_loop_callback(TestAsync.loop.add_callback)
+        manager.host(tbl)
+
+        updated = queue.Queue()
+        scheduled = {"count": 0}
+        call_later = tbl._state_manager.call_later
+
+        def counting_call_later(*args):
+            scheduled["count"] += 1
+            return call_later(*args)
+
+        tbl._state_manager.call_later = counting_call_later
+
+        @syncify
+        def _task():
+            view = tbl.view()
+            view.on_update(lambda port_id: updated.put(port_id))
+            tbl.set_batching(max_latency_ms=50)
+            for i in range(5):
+                tbl.update([data[i]])
+            return view
+
+        view = _task()
+
+        # The batch is processed once its latency bound is reached, through
+        # a single `call_later` on the loop rather than by re-queueing.
+        updated.get(timeout=5)
+        assert scheduled["count"] == 1
+
+        @syncify
+        def _stats_task():
+            stats = tbl.get_batch_stats()
+            view.delete()
+            tbl.delete()
+            return stats
+
+        assert _stats_task() == {"batches": 1, "rows_coalesced": 5}
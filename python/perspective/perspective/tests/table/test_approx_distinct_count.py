@@ -0,0 +1,53 @@
+################################################################################
+#
+# Copyright (c) 2019, the Perspective Authors.
+#
+# This file is part of the Perspective library, distributed under the terms of
+# the Apache License 2.0.  The full license can be found in the LICENSE file.
+#
+
+from perspective.table import Table
+
+
+class TestApproxDistinctCount(object):
+    """Approximate distinct counts are estimated from a HyperLogLog sketch
+    per tree node, which is exact for small counts."""
+
+    def test_approx_distinct_count(self):
+        tbl = Table({"g": ["x", "x", "x", "y"], "v": ["a", "b", "c", "a"]})
+        view = tbl.view(row_pivots=["g"], columns=["v"], aggregates={"v": "approx distinct count"})
+        assert view.to_dict() == {
+            "__ROW_PATH__": [[], ["x"], ["y"]],
+            "v": [3, 3, 1]
+        }
+        tbl.update({"g": ["y", "y"], "v": ["d", "a"]})
+        assert view.to_dict()["v"] == [4, 3, 2]
+
+    def test_approx_distinct_count_remove(self):
+        tbl = Table({"k": [1, 2, 3, 4], "g": ["x", "x", "x", "y"], "v": ["a", "b", "c", "a"]}, index="k")
+        view = tbl.view(row_pivots=["g"], columns=["v"], aggregates={"v": "approx distinct count"})
+        tbl.remove([3])
+        assert view.to_dict()["v"] == [2, 2, 1]
+        tbl.update({"k": [4], "v": ["e"]})
+        assert view.to_dict()["v"] == [3, 2, 1]
+
+    def test_approx_distinct_count_remove_from_large_group(self):
+        tbl = Table({"k": list(range(16)), "g": ["x"] * 16, "v": ["a"] * 15 + ["b"]}, index="k")
+        view = tbl.view(row_pivots=["g"], columns=["v"], aggregates={"v": "approx distinct count"})
+        assert view.to_dict()["v"] == [2, 2]
+        tbl.update({"k": [15], "v": ["a"]})
+        assert view.to_dict()["v"] == [1, 1]
+        tbl.update({"k": [15], "v": ["c"]})
+        tbl.remove([15])
+        assert view.to_dict()["v"] == [1, 1]
+
+    def test_approx_distinct_count_precision(self):
+        tbl = Table({"g": ["x"] * 10000, "v": list(range(10000))})
+        view = tbl.view(row_pivots=["g"], columns=["v"], aggregates={"v": "hll14"})
+        estimate = view.to_dict()["v"][0]
+        assert abs(estimate - 10000) < 500
+
+    def test_approx_distinct_count_schema(self):
+        tbl = Table({"g": ["x"], "v": ["a"]})
+        view = tbl.view(row_pivots=["g"], columns=["v"], aggregates={"v": "approx distinct count"})
+        assert view.schema() == {"v": int}
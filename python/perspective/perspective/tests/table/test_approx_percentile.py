@@ -0,0 +1,67 @@
+################################################################################
+#
+# Copyright (c) 2019, the Perspective Authors.
+#
+# This file is part of the Perspective library, distributed under the terms of
+# the Apache License 2.0.  The full license can be found in the LICENSE file.
+#
+
+from perspective.table import Table
+
+
+class TestApproxPercentile(object):
+    """Approximate percentiles are estimated from a t-digest per tree node,
+    which interpolates between values and is exact for small groups."""
+
+    def test_approx_percentile_median(self):
+        tbl = Table({"g": ["a", "a", "a", "b", "b"], "v": [1, 5, 3, 10, 20]})
+        view = tbl.view(row_pivots=["g"], columns=["v"], aggregates={"v": "approx median"})
+        assert view.to_dict() == {
+            "__ROW_PATH__": [[], ["a"], ["b"]],
+            "v": [5, 3, 15]
+        }
+
+    def test_approx_percentile_p95(self):
+        tbl = Table({"g": ["a", "a", "a", "b", "b"], "v": [1, 5, 3, 10, 20]})
+        view = tbl.view(row_pivots=["g"], columns=["v"], aggregates={"v": "approx p95"})
+        assert view.to_dict()["v"] == [20, 5, 20]
+
+    def test_approx_percentile_update(self):
+        tbl = Table({"g": ["x", "x", "x"], "v": [1, 2, 3]})
+        view = tbl.view(row_pivots=["g"], columns=["v"], aggregates={"v": "approx median"})
+        assert view.to_dict()["v"] == [2, 2]
+        tbl.update({"g": ["y"], "v": [10]})
+        assert view.to_dict()["v"] == [2.5, 2, 10]
+
+    def test_approx_percentile_remove(self):
+        tbl = Table({"k": [1, 2, 3, 4], "g": ["x", "x", "x", "y"], "v": [1, 2, 3, 10]}, index="k")
+        view = tbl.view(row_pivots=["g"], columns=["v"], aggregates={"v": "approx median"})
+        assert view.to_dict()["v"] == [2.5, 2, 10]
+        tbl.remove([3])
+        assert view.to_dict()["v"] == [2, 1.5, 10]
+        tbl.update({"k": [4], "v": [4]})
+        assert view.to_dict()["v"] == [2, 1.5, 4]
+
+    def test_approx_percentile_remove_tail(self):
+        values = list(range(1, 20)) + [1000000000]
+        tbl = Table({"k": list(range(20)), "g": ["x"] * 20, "v": values}, index="k")
+        view = tbl.view(row_pivots=["g"], columns=["v"], aggregates={"v": "approx p99"})
+        assert all(estimate > 1000000 for estimate in view.to_dict()["v"])
+        tbl.update({"k": [19], "v": [5]})
+        assert all(estimate <= 19 for estimate in view.to_dict()["v"])
+        tbl.update({"k": [19], "v": [1000000000]})
+        tbl.remove([19])
+        assert all(estimate <= 19 for estimate in view.to_dict()["v"])
+
+    def test_approx_percentile_large(self):
+        tbl = Table({"g": ["x", "y"] * 5000, "v": list(range(10000))})
+        view = tbl.view(row_pivots=["g"], columns=["v"], aggregates={"v": "approx p99"})
+        estimates = view.to_dict()["v"]
+        assert abs(estimates[0] - 9900) < 100
+        assert abs(estimates[1] - 9898) < 100
+        assert abs(estimates[2] - 9899) < 100
+
+    def test_approx_percentile_schema(self):
+        tbl = Table({"g": ["x"], "v": [1]})
+        view = tbl.view(row_pivots=["g"], columns=["v"], aggregates={"v": "approx p99"})
+        assert view.schema() == {"v": float}
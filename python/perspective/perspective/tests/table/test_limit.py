@@ -0,0 +1,125 @@
+################################################################################
+#
+# Copyright (c) 2019, the Perspective Authors.
+#
+# This file is part of the Perspective library, distributed under the terms of
+# the Apache License 2.0.  The full license can be found in the LICENSE file.
+#
+
+from perspective.table import Table
+
+
+class TestLimit(object):
+    """Tables with a `limit` and no index are ring buffers - updates that
+    write the next slots overwrite the oldest rows in place, and views are
+    updated from the evicted and appended rows."""
+
+    def test_limit_rolling_update(self):
+        tbl = Table({"a": [1, 2, 3], "b": ["x", "y", "z"]}, limit=3)
+        view = tbl.view()
+        tbl.update({"a": [4], "b": ["w"]})
+        assert view.to_dict() == {"a": [4, 2, 3], "b": ["w", "y", "z"]}
+        tbl.update({"a": [5, 6], "b": ["v", "u"]})
+        assert view.to_dict() == {"a": [4, 5, 6], "b": ["w", "v", "u"]}
+        assert tbl.size() == 3
+
+    def test_limit_grows_then_wraps(self):
+        tbl = Table({"a": int}, limit=4)
+        view = tbl.view()
+        tbl.update({"a": [1, 2]})
+        tbl.update({"a": [3]})
+        assert view.to_dict() == {"a": [1, 2, 3]}
+        tbl.update({"a": [4, 5]})
+        assert view.to_dict() == {"a": [5, 2, 3, 4]}
+        assert tbl.size() == 4
+
+    def test_limit_update_larger_than_limit(self):
+        tbl = Table({"a": [1, 2, 3]}, limit=3)
+        view = tbl.view()
+        tbl.update({"a": [4, 5, 6, 7]})
+        assert view.to_dict() == {"a": [7, 5, 6]}
+        tbl.update({"a": [8]})
+        assert view.to_dict() == {"a": [7, 8, 6]}
+
+    def test_limit_partial_update(self):
+        tbl = Table({"a": [1, 2], "b": ["x", "y"]}, limit=2)
+        view = tbl.view()
+        tbl.update({"a": [3]})
+        assert view.to_dict() == {"a": [3, 2], "b": ["x", "y"]}
+
+    def test_limit_null_update(self):
+        tbl = Table({"a": [1, 2], "b": ["x", "y"]}, limit=2)
+        view = tbl.view()
+        tbl.update({"a": [3], "b": [None]})
+        assert view.to_dict() == {"a": [3, 2], "b": [None, "y"]}
+
+    def test_limit_sort(self):
+        tbl = Table({"a": [1, 2, 3]}, limit=3)
+        view = tbl.view(sort=[["a", "desc"]])
+        tbl.update({"a": [10]})
+        assert view.to_dict() == {"a": [10, 3, 2]}
+        tbl.update({"a": [0, -1]})
+        assert view.to_dict() == {"a": [10, 0, -1]}
+
+    def test_limit_filter(self):
+        tbl = Table({"a": [1, 5, 2]}, limit=3)
+        view = tbl.view(filter=[["a", ">", 2]])
+        tbl.update({"a": [6]})
+        assert view.to_dict() == {"a": [6, 5]}
+        tbl.update({"a": [0]})
+        assert view.to_dict() == {"a": [6]}
+        tbl.update({"a": [3]})
+        assert view.to_dict() == {"a": [6, 3]}
+
+    def test_limit_row_pivots(self):
+        tbl = Table({"g": ["x", "y", "x"], "v": [1, 2, 3]}, limit=3)
+        view = tbl.view(row_pivots=["g"], columns=["v"])
+        tbl.update({"g": ["y"], "v": [10]})
+        assert view.to_dict() == {
+            "__ROW_PATH__": [[], ["x"], ["y"]],
+            "v": [15, 3, 12]
+        }
+        tbl.update({"g": ["z", "z"], "v": [1, 1]})
+        assert view.to_dict() == {
+            "__ROW_PATH__": [[], ["y"], ["z"]],
+            "v": [12, 10, 2]
+        }
+
+    def test_limit_row_pivots_count(self):
+        tbl = Table({"g": ["x", "y", "x"], "v": [1, 2, 3]}, limit=3)
+        view = tbl.view(row_pivots=["g"], columns=["v"], aggregates={"v": "count"})
+        tbl.update({"g": ["x", "y"], "v": [4, 5]})
+        assert view.to_dict() == {
+            "__ROW_PATH__": [[], ["x"], ["y"]],
+            "v": [3, 2, 1]
+        }
+
+    def test_limit_row_pivots_filter(self):
+        tbl = Table({"g": ["x", "y", "x"], "v": [1, 2, 3]}, limit=3)
+        view = tbl.view(row_pivots=["g"], columns=["v"], filter=[["v", ">", 1]])
+        tbl.update({"g": ["x"], "v": [4]})
+        assert view.to_dict() == {
+            "__ROW_PATH__": [[], ["x"], ["y"]],
+            "v": [9, 7, 2]
+        }
+        tbl.update({"g": ["y"], "v": [0]})
+        assert view.to_dict() == {
+            "__ROW_PATH__": [[], ["x"]],
+            "v": [7, 7]
+        }
+
+    def test_limit_column_pivots(self):
+        tbl = Table({"g": ["x", "y", "x"], "h": ["p", "p", "q"], "v": [1, 2, 3]}, limit=3)
+        view = tbl.view(row_pivots=["g"], column_pivots=["h"], columns=["v"])
+        tbl.update({"g": ["y"], "h": ["q"], "v": [10]})
+        assert view.to_records() == [
+            {"__ROW_PATH__": [], "p|v": 2, "q|v": 13},
+            {"__ROW_PATH__": ["x"], "p|v": None, "q|v": 3},
+            {"__ROW_PATH__": ["y"], "p|v": 2, "q|v": 10}
+        ]
+
+    def test_limit_expression(self):
+        tbl = Table({"v": [1, 2, 3]}, limit=3)
+        view = tbl.view(expressions=['// double \n "v" * 2'])
+        tbl.update({"v": [4, 5]})
+        assert view.to_dict() == {"v": [4, 5, 3], "double": [8, 10, 6]}
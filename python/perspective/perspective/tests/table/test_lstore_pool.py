@@ -0,0 +1,60 @@
+################################################################################
+#
+# Copyright (c) 2019, the Perspective Authors.
+#
+# This file is part of the Perspective library, distributed under the terms of
+# the Apache License 2.0.  The full license can be found in the LICENSE file.
+#
+
+from perspective.table import Table
+
+
+class TestLstorePool(object):
+    """The transient tables of each update are allocated from a pool owned
+    by the table's gnode, which keeps the blocks they release for the next
+    update."""
+
+    def test_lstore_pool_reused_across_updates(self):
+        tbl = Table({"a": int, "b": float, "c": str}, index="a")
+        view = tbl.view(row_pivots=["c"], columns=["b"])
+        data = {
+            "a": list(range(1000)),
+            "b": [i * 0.5 for i in range(1000)],
+            "c": [str(i % 10) for i in range(1000)]
+        }
+        tbl.update(data)
+        assert tbl.size() == 1000
+
+        gnode = tbl._table.get_gnode()
+        first = gnode.get_lstore_pool_stats()
+
+        for _ in range(5):
+            tbl.update(data)
+            assert tbl.size() == 1000
+
+        stats = gnode.get_lstore_pool_stats()
+        assert stats.num_resets > first.num_resets
+        assert stats.bytes_reused > first.bytes_reused
+        assert stats.bytes_reused - first.bytes_reused > stats.bytes_allocated - first.bytes_allocated
+        assert view.num_rows() == 11
+
+    def test_lstore_pool_does_not_grow_with_master_table(self):
+        tbl = Table({"a": int, "b": float, "c": str}, index="a")
+        gnode = tbl._table.get_gnode()
+
+        def update(i):
+            keys = list(range(i * 1000, (i + 1) * 1000))
+            tbl.update({"a": keys, "b": [k * 0.5 for k in keys], "c": [str(k) for k in keys]})
+            assert tbl.size() == (i + 1) * 1000
+
+        for i in range(2):
+            update(i)
+
+        first = gnode.get_lstore_pool_stats()
+
+        for i in range(2, 12):
+            update(i)
+
+        stats = gnode.get_lstore_pool_stats()
+        assert stats.bytes_allocated == first.bytes_allocated
+        assert stats.bytes_retained <= first.bytes_retained
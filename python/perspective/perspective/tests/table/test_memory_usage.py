@@ -0,0 +1,61 @@
+################################################################################
+#
+# Copyright (c) 2019, the Perspective Authors.
+#
+# This file is part of the Perspective library, distributed under the terms of
+# the Apache License 2.0.  The full license can be found in the LICENSE file.
+#
+
+from perspective.table import Table
+
+
+class TestMemoryUsage(object):
+
+    def test_table_memory_usage(self):
+        tbl = Table({"a": [1, 2, None], "b": ["x", "y", "x"]}, index="a")
+        usage = tbl.get_memory_usage()
+
+        for name in ["a", "b", "psp_pkey", "psp_op"]:
+            for component in ["data", "status"]:
+                entry = usage["columns.{}.{}".format(name, component)]
+                assert entry["reserved"] >= entry["used"]
+
+        assert usage["columns.a.data"]["used"] >= 3 * 8
+        assert usage["columns.b.vocab"]["used"] > 0
+        assert "columns.a.vocab" not in usage
+        assert usage["pkey_map"]["used"] > 0
+        assert "free_rows" in usage
+        assert "lstore_pool" in usage
+        assert "vocab_reclaimed" not in usage
+        assert tbl._table.get_gnode().get_vocab_bytes_reclaimed() == 0
+
+    def test_table_memory_usage_grows(self):
+        tbl = Table({"a": int, "b": str})
+        before = tbl.get_memory_usage()
+        tbl.update({"a": list(range(10000)), "b": [str(i) for i in range(10000)]})
+        after = tbl.get_memory_usage()
+        assert after["columns.a.data"]["used"] > before["columns.a.data"]["used"]
+        assert after["columns.b.vocab"]["used"] > before["columns.b.vocab"]["used"]
+
+    def test_view_memory_usage_flat(self):
+        tbl = Table({"a": [3, 1, 2]})
+        view = tbl.view(sort=[["a", "asc"]])
+        usage = view.get_memory_usage()
+        assert usage["traversal.sort_index"]["used"] > 0
+        assert usage["traversal.pkey_index"]["used"] > 0
+
+    def test_view_memory_usage_pivoted(self):
+        tbl = Table({"a": [1, 2, 3], "b": ["x", "y", "x"]})
+        view = tbl.view(row_pivots=["b"], columns=["a"])
+        usage = view.get_memory_usage()
+        assert usage["tree.nodes"]["used"] > 0
+        assert usage["tree.aggregates.a.data"]["used"] > 0
+        assert usage["traversal"]["used"] > 0
+
+    def test_view_memory_usage_two_sided(self):
+        tbl = Table({"a": [1, 2, 3], "b": ["x", "y", "x"]})
+        view = tbl.view(row_pivots=["b"], column_pivots=["b"], columns=["a"])
+        usage = view.get_memory_usage()
+        assert usage["trees.0.nodes"]["used"] > 0
+        assert usage["row_traversal"]["used"] > 0
+        assert usage["column_traversal"]["used"] > 0
@@ -0,0 +1,71 @@
+################################################################################
+#
+# Copyright (c) 2019, the Perspective Authors.
+#
+# This file is part of the Perspective library, distributed under the terms of
+# the Apache License 2.0.  The full license can be found in the LICENSE file.
+#
+
+from perspective.table import Table
+
+
+class TestOrderStatistic(object):
+    """Median and percentile aggregates are maintained per tree node from the
+    rows added to and removed from it by each update."""
+
+    def test_order_statistic_median(self):
+        tbl = Table({"g": ["a", "a", "a", "b", "b"], "v": [1, 5, 3, 10, 20]})
+        view = tbl.view(row_pivots=["g"], columns=["v"], aggregates={"v": "median"})
+        assert view.to_dict() == {
+            "__ROW_PATH__": [[], ["a"], ["b"]],
+            "v": [5, 3, 20]
+        }
+
+    def test_order_statistic_percentile(self):
+        tbl = Table({"g": ["a", "a", "a", "b", "b"], "v": [1, 5, 3, 10, 20]})
+        view = tbl.view(row_pivots=["g"], columns=["v"], aggregates={"v": "p90"})
+        assert view.to_dict() == {
+            "__ROW_PATH__": [[], ["a"], ["b"]],
+            "v": [20, 5, 20]
+        }
+
+    def test_order_statistic_update_value(self):
+        tbl = Table({"k": [1, 2, 3, 4], "g": ["x", "x", "x", "x"], "v": [1, 2, 3, 4]}, index="k")
+        view = tbl.view(row_pivots=["g"], columns=["v"], aggregates={"v": "median"})
+        assert view.to_dict()["v"] == [3, 3]
+        tbl.update({"k": [3], "v": [10]})
+        assert view.to_dict()["v"] == [4, 4]
+        tbl.update({"k": [1], "v": [20]})
+        assert view.to_dict()["v"] == [10, 10]
+
+    def test_order_statistic_update_pivot(self):
+        tbl = Table({"k": [1, 2, 3, 4, 5], "g": ["x", "x", "y", "y", "y"], "v": [5, 1, 4, 2, 3]}, index="k")
+        view = tbl.view(row_pivots=["g"], columns=["v"], aggregates={"v": "median"})
+        assert view.to_dict()["v"] == [3, 5, 3]
+        tbl.update({"k": [5], "g": ["x"]})
+        assert view.to_dict() == {
+            "__ROW_PATH__": [[], ["x"], ["y"]],
+            "v": [3, 3, 4]
+        }
+
+    def test_order_statistic_remove(self):
+        tbl = Table({"k": [1, 2, 3, 4, 5], "g": ["x", "x", "y", "y", "y"], "v": [5, 1, 4, 2, 3]}, index="k")
+        view = tbl.view(row_pivots=["g"], columns=["v"], aggregates={"v": "median"})
+        tbl.remove([1, 3])
+        assert view.to_dict() == {
+            "__ROW_PATH__": [[], ["x"], ["y"]],
+            "v": [2, 1, 3]
+        }
+
+    def test_order_statistic_filter(self):
+        tbl = Table({"g": ["x", "x", "x", "x"], "v": [1, 2, 3, 4]})
+        view = tbl.view(row_pivots=["g"], columns=["v"], aggregates={"v": "median"}, filter=[["v", ">", 1]])
+        assert view.to_dict()["v"] == [3, 3]
+        tbl.update({"g": ["x", "x"], "v": [0, 10]})
+        assert view.to_dict()["v"] == [4, 4]
+
+    def test_order_statistic_limit(self):
+        tbl = Table({"g": ["x", "x", "x"], "v": [1, 2, 3]}, limit=3)
+        view = tbl.view(row_pivots=["g"], columns=["v"], aggregates={"v": "median"})
+        tbl.update({"g": ["x", "x"], "v": [10, 20]})
+        assert view.to_dict()["v"] == [10, 10]
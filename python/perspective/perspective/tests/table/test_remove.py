@@ -31,3 +31,22 @@ class TestRemove(object):
             tbl.remove([i])
         assert tbl.view().to_records() == [{"a": 0, "b": "0"}]
         # assert tbl.size() == 0
+
+    def test_remove_most_then_update(self):
+        # enough free rows to compact the master table on the next update
+        tbl = Table({"a": int, "b": str, "c": float}, index="a")
+        tbl.update({
+            "a": list(range(10000)),
+            "b": [str(i) for i in range(10000)],
+            "c": [None if i % 3 == 0 else i * 0.5 for i in range(10000)]
+        })
+        tbl.remove([i for i in range(10000) if i % 100 != 0])
+        tbl.update({"a": [5, 9900], "b": ["x", "y"], "c": [1.5, None]})
+        view = tbl.view(filter=[["a", ">=", 9800]])
+        assert view.to_dict() == {
+            "a": [9800, 9900],
+            "b": ["9800", "y"],
+            "c": [4900.0, None]
+        }
+        assert tbl.view().num_rows() == 101
+        assert tbl.view(filter=[["c", "is null"]]).num_rows() == 34
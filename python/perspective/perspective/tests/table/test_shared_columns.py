@@ -0,0 +1,78 @@
+################################################################################
+#
+# Copyright (c) 2019, the Perspective Authors.
+#
+# This file is part of the Perspective library, distributed under the terms of
+# the Apache License 2.0.  The full license can be found in the LICENSE file.
+#
+
+from perspective.table import Table
+
+
+class TestSharedColumns(object):
+    """Updates that are already sorted by primary key share their columns
+    with the input port and master table instead of being copied, so check
+    that later updates do not write through to data that is still read."""
+
+    def test_shared_columns_implicit_index(self):
+        tbl = Table({"a": [1, 2, 3], "b": ["x", "y", "z"]})
+        view = tbl.view()
+        tbl.update({"a": [4, 5], "b": ["w", "v"]})
+        tbl.update({"a": [6], "b": ["u"]})
+        assert view.to_dict() == {
+            "a": [1, 2, 3, 4, 5, 6],
+            "b": ["x", "y", "z", "w", "v", "u"]
+        }
+
+    def test_shared_columns_sorted_index(self):
+        tbl = Table({"a": [1, 2, 3], "b": [1.5, 2.5, 3.5]}, index="a")
+        view = tbl.view()
+        tbl.update({"a": [4, 5], "b": [4.5, 5.5]})
+        tbl.update({"a": [2, 6], "b": [None, 6.5]})
+        assert view.to_dict() == {
+            "a": [1, 2, 3, 4, 5, 6],
+            "b": [1.5, None, 3.5, 4.5, 5.5, 6.5]
+        }
+
+    def test_shared_columns_partial_update(self):
+        tbl = Table({"a": ["x", "y", "z"], "b": [1, 2, 3], "c": [True, False, True]}, index="a")
+        view = tbl.view()
+        tbl.update({"a": ["x", "z"], "b": [10, 30]})
+        assert view.to_dict() == {
+            "a": ["x", "y", "z"],
+            "b": [10, 2, 30],
+            "c": [True, False, True]
+        }
+
+    def test_shared_columns_unsorted_update(self):
+        tbl = Table({"a": [3, 1, 2, 1], "b": ["c", "a", "b", "d"]}, index="a")
+        view = tbl.view()
+        assert view.to_dict() == {"a": [1, 2, 3], "b": ["d", "b", "c"]}
+        tbl.update({"a": [5, 4], "b": ["e", "f"]})
+        assert view.to_dict() == {"a": [1, 2, 3, 4, 5], "b": ["d", "b", "c", "f", "e"]}
+
+    def test_shared_columns_pivoted_view(self):
+        tbl = Table({"a": [1, 2, 3, 4], "b": ["x", "y", "x", "y"]}, index="a")
+        view = tbl.view(row_pivots=["b"], columns=["a"])
+        tbl.update({"a": [5, 6], "b": ["x", "z"]})
+        assert view.to_dict() == {
+            "__ROW_PATH__": [[], ["x"], ["y"], ["z"]],
+            "a": [21, 9, 6, 6]
+        }
+
+    def test_shared_columns_remove_missing_keys(self):
+        tbl = Table({"a": [1, 2, 3], "b": ["x", "y", "z"]}, index="a")
+        view = tbl.view()
+        tbl.remove([2, 7, 8])
+        assert view.to_dict() == {"a": [1, 3], "b": ["x", "z"]}
+        tbl.update({"a": [4, 9], "b": ["w", "v"]})
+        tbl.remove([9, 10])
+        assert view.to_dict() == {"a": [1, 3, 4], "b": ["x", "z", "w"]}
+
+    def test_shared_columns_update_after_clear(self):
+        tbl = Table({"a": [1, 2, 3], "b": ["x", "y", "z"]}, index="a")
+        view = tbl.view()
+        tbl.clear()
+        tbl.update({"a": [1, 2], "b": ["p", "q"]})
+        tbl.update({"a": [2, 3], "b": ["r", "s"]})
+        assert view.to_dict() == {"a": [1, 2, 3], "b": ["p", "r", "s"]}
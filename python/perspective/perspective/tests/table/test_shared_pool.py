@@ -0,0 +1,93 @@
+################################################################################
+#
+# Copyright (c) 2019, the Perspective Authors.
+#
+# This file is part of the Perspective library, distributed under the terms of
+# the Apache License 2.0.  The full license can be found in the LICENSE file.
+#
+
+from perspective.table import Table
+
+
+class TestSharedPool(object):
+    """Tables created with `share_pool_with` register their gnodes in one
+    update pool, which processes the gnodes of all of them together."""
+
+    def test_shared_pool_updates(self):
+        tbl = Table({"a": int})
+        tables = [tbl] + [Table({"a": int}, share_pool_with=tbl) for _ in range(3)]
+        views = [t.view() for t in tables]
+
+        for i, t in enumerate(tables):
+            t.update([{"a": i}, {"a": i * 10}])
+
+        for i, view in enumerate(views):
+            assert view.to_dict() == {"a": [i, i * 10]}
+
+    def test_shared_pool_notifies_each_table(self, sentinel):
+        tbl = Table({"a": int})
+        tbl2 = Table({"a": int}, share_pool_with=tbl)
+        s = sentinel(0)
+        s2 = sentinel(0)
+
+        def callback(port_id):
+            s.set(s.get() + 1)
+
+        def callback2(port_id):
+            s2.set(s2.get() + 1)
+
+        view = tbl.view()
+        view2 = tbl2.view()
+        view.on_update(callback)
+        view2.on_update(callback2)
+
+        tbl.update([{"a": 1}])
+        assert s.get() == 1
+        assert s2.get() == 0
+
+        tbl2.update([{"a": 2}])
+        tbl2.update([{"a": 3}])
+        assert s.get() == 1
+        assert s2.get() == 2
+
+    def test_shared_pool_batch(self, sentinel):
+        s = sentinel(0)
+        s2 = sentinel(0)
+
+        def callback(port_id):
+            s.set(s.get() + 1)
+
+        def callback2(port_id):
+            s2.set(s2.get() + 1)
+
+        tbl = Table({"a": int})
+        tbl2 = Table({"a": int}, share_pool_with=tbl)
+        view = tbl.view()
+        view2 = tbl2.view()
+        view.on_update(callback)
+        view2.on_update(callback2)
+        tbl.set_batching(max_rows=100, max_latency_ms=60000)
+        tbl.update([{"a": 1}])
+        tbl.update([{"a": 2}])
+        assert s.get() == 0
+
+        # The policy only applies to `tbl`, so `tbl2` processes its update
+        # immediately, along with the pending updates of `tbl`.
+        tbl2.update([{"a": 3}])
+        assert s.get() == 1
+        assert s2.get() == 1
+        tbl2.update([{"a": 4}])
+        assert s2.get() == 2
+
+        assert tbl.get_batch_stats() == {"batches": 1, "rows_coalesced": 2}
+        assert tbl2.get_batch_stats() == {"batches": 2, "rows_coalesced": 0}
+        assert view.to_dict() == {"a": [1, 2]}
+        assert view2.to_dict() == {"a": [3, 4]}
+
+    def test_shared_pool_delete(self):
+        tbl = Table({"a": int})
+        tbl2 = Table({"a": int}, share_pool_with=tbl)
+        tbl2.update([{"a": 1}])
+        tbl2.delete()
+        tbl.update([{"a": 2}])
+        assert tbl.view().to_dict() == {"a": [2]}
@@ -0,0 +1,54 @@
+################################################################################
+#
+# Copyright (c) 2019, the Perspective Authors.
+#
+# This file is part of the Perspective library, distributed under the terms of
+# the Apache License 2.0.  The full license can be found in the LICENSE file.
+#
+
+import os
+from pytest import raises
+from perspective import PerspectiveCppError
+from perspective.table import Table
+
+
+class TestSnapshot(object):
+
+    def test_snapshot_indexed(self, tmpdir):
+        path = os.path.join(str(tmpdir), "indexed.psp")
+        schema = {"a": str, "b": int, "c": float}
+        tbl = Table(schema, index="a")
+        tbl.update({"a": ["x", "y", "z"], "b": [1, None, 3], "c": [1.5, 2.5, None]})
+        tbl.remove(["y"])
+        tbl.save_snapshot(path)
+
+        restored = Table(schema, index="a")
+        restored.load_snapshot(path)
+        assert restored.view().to_dict() == tbl.view().to_dict()
+
+        # primary keys and free rows are restored with the rows
+        restored.update({"a": ["x", "w"], "b": [10, 20]})
+        assert restored.view().to_dict() == {
+            "a": ["w", "x", "z"],
+            "b": [20, 10, 3],
+            "c": [None, 1.5, None]
+        }
+
+    def test_snapshot_unindexed(self, tmpdir):
+        path = os.path.join(str(tmpdir), "unindexed.psp")
+        tbl = Table({"a": [1, 2, 3], "b": ["a", "b", "c"]})
+        tbl.save_snapshot(path)
+
+        restored = Table({"a": int, "b": str})
+        restored.load_snapshot(path)
+        restored.update({"a": [4], "b": ["d"]})
+        assert restored.view().to_dict() == {"a": [1, 2, 3, 4], "b": ["a", "b", "c", "d"]}
+
+    def test_snapshot_mismatched_index(self, tmpdir):
+        path = os.path.join(str(tmpdir), "mismatched.psp")
+        tbl = Table({"a": [1, 2, 3]}, index="a")
+        tbl.save_snapshot(path)
+
+        restored = Table({"a": int})
+        with raises(PerspectiveCppError):
+            restored.load_snapshot(path)
@@ -0,0 +1,53 @@
+################################################################################
+#
+# Copyright (c) 2019, the Perspective Authors.
+#
+# This file is part of the Perspective library, distributed under the terms of
+# the Apache License 2.0.  The full license can be found in the LICENSE file.
+#
+
+from perspective.table import Table
+
+
+class TestSparseTree(object):
+    """The children of each tree node are kept in sort order as nodes are
+    inserted, re-sorted and dropped by updates."""
+
+    def test_sparse_tree_children_inserted_out_of_order(self):
+        tbl = Table({"g": ["c", "a"], "v": [1, 2]})
+        view = tbl.view(row_pivots=["g"], columns=["v"])
+        tbl.update({"g": ["b", "d", "a"], "v": [3, 4, 5]})
+        assert view.to_dict() == {
+            "__ROW_PATH__": [[], ["a"], ["b"], ["c"], ["d"]],
+            "v": [15, 7, 3, 1, 4]
+        }
+
+    def test_sparse_tree_sort_by_aggregate(self):
+        tbl = Table({"g": ["x", "y", "z"], "v": [1, 2, 3]}, index="g")
+        view = tbl.view(row_pivots=["g"], columns=["v"], sort=[["v", "desc"]])
+        assert view.to_dict()["__ROW_PATH__"] == [[], ["z"], ["y"], ["x"]]
+        tbl.update({"g": ["x"], "v": [10]})
+        assert view.to_dict() == {
+            "__ROW_PATH__": [[], ["x"], ["z"], ["y"]],
+            "v": [15, 10, 3, 2]
+        }
+
+    def test_sparse_tree_drop_and_reinsert(self):
+        tbl = Table({"k": [1, 2, 3], "g": ["x", "y", "x"], "h": ["p", "q", "q"]}, index="k")
+        view = tbl.view(row_pivots=["g", "h"], columns=["k"], aggregates={"k": "count"})
+        tbl.remove([1, 3])
+        assert view.to_dict() == {
+            "__ROW_PATH__": [[], ["y"], ["y", "q"]],
+            "k": [1, 1, 1]
+        }
+        tbl.update({"k": [4, 5], "g": ["x", "a"], "h": ["r", "p"]})
+        assert view.to_dict() == {
+            "__ROW_PATH__": [[], ["a"], ["a", "p"], ["x"], ["x", "r"], ["y"], ["y", "q"]],
+            "k": [3, 1, 1, 1, 1, 1, 1]
+        }
+
+    def test_sparse_tree_column_pivots(self):
+        tbl = Table({"g": ["x", "y"], "h": ["q", "p"], "v": [1, 2]})
+        view = tbl.view(row_pivots=["g"], column_pivots=["h"], columns=["v"])
+        tbl.update({"g": ["x"], "h": ["o"], "v": [3]})
+        assert view.column_paths() == ["__ROW_PATH__", "o|v", "p|v", "q|v"]
@@ -0,0 +1,56 @@
+################################################################################
+#
+# Copyright (c) 2019, the Perspective Authors.
+#
+# This file is part of the Perspective library, distributed under the terms of
+# the Apache License 2.0.  The full license can be found in the LICENSE file.
+#
+
+import os
+from pytest import raises
+from perspective import PerspectiveCppError, PerspectiveError
+from perspective.table import Table
+
+
+class TestStorage(object):
+
+    def test_storage_indexed(self, tmpdir):
+        tbl = Table({"a": ["x", "y", "z"], "b": [1, None, 3]}, index="a")
+        tbl.set_storage(str(tmpdir), access="random")
+        assert len(os.listdir(str(tmpdir))) > 0
+        assert tbl.view().to_dict() == {"a": ["x", "y", "z"], "b": [1, None, 3]}
+
+        # existing primary keys still map to their rows
+        tbl.update({"a": ["y", "w"], "b": [2, 4]})
+        tbl.remove(["z"])
+        assert tbl.view().to_dict() == {"a": ["w", "x", "y"], "b": [4, 1, 2]}
+
+    def test_storage_grows_past_initial_capacity(self, tmpdir):
+        tbl = Table({"a": int, "b": str})
+        tbl.set_storage(str(tmpdir), access="sequential")
+
+        for i in range(10):
+            tbl.update({"a": list(range(i * 1000, (i + 1) * 1000)), "b": [str(i)] * 1000})
+
+        assert tbl.size() == 10000
+        view = tbl.view(columns=["a"])
+        assert view.to_dict(start_row=9998, end_row=10000) == {"a": [9998, 9999]}
+
+    def test_storage_back_to_memory(self, tmpdir):
+        tbl = Table({"a": [1, 2, 3]})
+        tbl.set_storage(str(tmpdir))
+        tbl.set_storage()
+        tbl.update({"a": [4]})
+        assert tbl.view().to_dict() == {"a": [1, 2, 3, 4]}
+
+    def test_storage_unknown_access(self, tmpdir):
+        tbl = Table({"a": [1, 2, 3]})
+        with raises(PerspectiveError):
+            tbl.set_storage(str(tmpdir), access="backwards")
+
+    def test_storage_with_view(self, tmpdir):
+        tbl = Table({"a": [1, 2, 3]})
+        view = tbl.view()
+        with raises(PerspectiveCppError):
+            tbl.set_storage(str(tmpdir))
+        assert view.to_dict() == {"a": [1, 2, 3]}
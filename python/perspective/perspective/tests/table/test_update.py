@@ -5,6 +5,7 @@
 # This file is part of the Perspective library, distributed under the terms of
 # the Apache License 2.0.  The full license can be found in the LICENSE file.
 #
+import time
 import numpy as np
 from datetime import date, datetime
 from perspective.table import Table
@@ -415,6 +416,35 @@ class TestUpdate(object):
         }])
         assert view.to_records() == [{"a": 3, "b": 2}, {"a": 2, "b": 3}]
 
+    def test_update_implicit_index_append_then_update(self):
+        tbl = Table([{"a": 1, "b": "x"}])
+        view = tbl.view()
+        pivoted = tbl.view(row_pivots=["b"], columns=["a"])
+        tbl.update([{"a": 2, "b": "y"}, {"a": 3, "b": "x"}])
+        tbl.update([{"a": 4, "b": "y"}])
+        assert view.to_records() == [
+            {"a": 1, "b": "x"}, {"a": 2, "b": "y"}, {"a": 3, "b": "x"}, {"a": 4, "b": "y"}
+        ]
+        assert pivoted.to_columns()["a"] == [10, 4, 6]
+
+        # updating an existing row after appends
+        tbl.update([{"__INDEX__": 1, "a": 20}])
+        tbl.update([{"a": 5, "b": "x"}])
+        assert view.to_records() == [
+            {"a": 1, "b": "x"}, {"a": 20, "b": "y"}, {"a": 3, "b": "x"},
+            {"a": 4, "b": "y"}, {"a": 5, "b": "x"}
+        ]
+        assert pivoted.to_columns()["a"] == [33, 9, 24]
+
+    def test_update_implicit_index_append_then_remove(self):
+        tbl = Table([{"a": 1}, {"a": 2}])
+        view = tbl.view()
+        tbl.update([{"a": 3}])
+        tbl.remove([0])
+        tbl.update([{"a": 4}])
+        assert view.to_records() == [{"a": 2}, {"a": 3}, {"a": 4}]
+        assert tbl.size() == 3
+
     def test_update_explicit_index(self):
         data = [{"a": 1, "b": 2}, {"a": 2, "b": 3}]
         tbl = Table(data, index="a")
@@ -425,6 +455,64 @@ class TestUpdate(object):
         }])
         assert view.to_records() == [{"a": 1, "b": 3}, {"a": 2, "b": 3}]
 
+    def test_update_explicit_index_unfiltered_then_filtered_view(self):
+        data = [{"a": 1, "b": 2}, {"a": 2, "b": 3}]
+        tbl = Table(data, index="a")
+        view = tbl.view()
+        tbl.update([{"a": 1, "b": 4}])
+        assert view.to_records() == [{"a": 1, "b": 4}, {"a": 2, "b": 3}]
+        filtered = tbl.view(filter=[["b", ">", 3]])
+        pivoted = tbl.view(row_pivots=["a"], columns=["b"])
+        tbl.update([{"a": 2, "b": 5}, {"a": 1, "b": 1}])
+        assert view.to_records() == [{"a": 1, "b": 1}, {"a": 2, "b": 5}]
+        assert filtered.to_records() == [{"a": 2, "b": 5}]
+        assert pivoted.to_columns() == {"__ROW_PATH__": [[], [1], [2]], "b": [6, 1, 5]}
+
+    def test_update_explicit_index_overwrite_strings(self):
+        # overwrite enough distinct strings to compact the vocabulary
+        tbl = Table({"a": int, "b": str}, index="a")
+        view = tbl.view()
+        pivoted = tbl.view(row_pivots=["b"], columns=["a"], aggregates={"a": "count"})
+        for i in range(4):
+            tbl.update({
+                "a": list(range(1000)),
+                "b": ["{}-{}".format(i, j) * 100 for j in range(1000)]
+            })
+        tbl.update({"a": [0, 1], "b": ["x", "y"]})
+        tbl.remove([2])
+        records = view.to_records()
+        assert len(records) == 999
+        assert records[0] == {"a": 0, "b": "x"}
+        assert records[1] == {"a": 1, "b": "y"}
+        assert records[2] == {"a": 3, "b": "3-3" * 100}
+        assert records[-1] == {"a": 999, "b": "3-999" * 100}
+        assert pivoted.num_rows() == 1000
+        assert tbl._table.get_gnode().get_vocab_bytes_reclaimed() > 0
+
+    def test_update_explicit_string_index_remove_and_readd(self):
+        # enough distinct keys to compact the vocabulary of the index
+        tbl = Table({"a": str, "b": int}, index="a")
+        view = tbl.view()
+        for i in range(4):
+            keys = ["{}-{}".format(i, j) * 100 for j in range(1000)]
+            tbl.update({"a": keys, "b": list(range(1000))})
+            tbl.remove(keys[1:])
+        tbl.update({"a": ["0-0" * 100, "x"], "b": [-1, -2]})
+        assert tbl.size() == 5
+        assert view.to_dict() == {
+            "a": ["0-0" * 100, "1-0" * 100, "2-0" * 100, "3-0" * 100, "x"],
+            "b": [-1, 0, 0, 0, -2]
+        }
+
+    def test_update_explicit_index_nulls_and_filters(self):
+        tbl = Table({"a": [1, 2, 3, 4], "b": ["x", None, "y", None]}, index="a")
+        tbl.update({"a": [1, 2], "b": [None, "z"]})
+        tbl.remove([3])
+        view = tbl.view(filter=[["b", "is null"]])
+        assert view.to_dict() == {"a": [1, 4], "b": [None, None]}
+        view2 = tbl.view(filter=[["b", "is not null"]])
+        assert view2.to_dict() == {"a": [2], "b": ["z"]}
+
     def test_update_explicit_index_multi(self):
         data = [{"a": 1, "b": 2}, {"a": 2, "b": 3}, {"a": 3, "b": 4}]
         tbl = Table(data, index="a")
@@ -483,3 +571,78 @@ class TestUpdate(object):
             "b": 3
         }])
         assert view.to_records() == [{"a": 1, "b": 3}, {"a": 2, "b": 3}]
+
+    def test_update_batching_max_rows(self, sentinel):
+        s = sentinel(0)
+
+        def callback(port_id):
+            s.set(s.get() + 1)
+
+        tbl = Table({"a": int})
+        view = tbl.view()
+        view.on_update(callback)
+        tbl.set_batching(max_rows=3, max_latency_ms=60000)
+        tbl.update([{"a": 1}])
+        tbl.update([{"a": 2}])
+        assert s.get() == 0
+        tbl.update([{"a": 3}])
+        assert s.get() == 1
+        assert view.to_records() == [{"a": 1}, {"a": 2}, {"a": 3}]
+        assert tbl.get_batch_stats()["rows_coalesced"] == 3
+
+    def test_update_batching_flushed_by_read(self):
+        tbl = Table({"a": int}, index="a")
+        view = tbl.view()
+        tbl.set_batching(max_rows=100, max_latency_ms=60000)
+        tbl.update([{"a": 1}])
+        tbl.update([{"a": 2}])
+        tbl.update([{"a": 1}])
+        assert view.to_records() == [{"a": 1}, {"a": 2}]
+        assert tbl.get_batch_stats()["rows_coalesced"] == 3
+
+    def test_update_batching_disabled(self):
+        tbl = Table({"a": int})
+        view = tbl.view()
+        tbl.update([{"a": 1}])
+        tbl.update([{"a": 2}])
+        assert view.to_records() == [{"a": 1}, {"a": 2}]
+        assert tbl.get_batch_stats()["rows_coalesced"] == 0
+
+    def test_update_batching_max_rows_only(self, sentinel):
+        s = sentinel(0)
+
+        def callback(port_id):
+            s.set(s.get() + 1)
+
+        tbl = Table({"a": int})
+        view = tbl.view()
+        view.on_update(callback)
+        tbl.set_batching(max_rows=3)
+        tbl.update([{"a": 1}])
+        tbl.update([{"a": 2}])
+        assert s.get() == 0
+        tbl.update([{"a": 3}])
+        assert s.get() == 1
+        assert tbl.get_batch_stats() == {"batches": 1, "rows_coalesced": 3}
+
+    def test_update_batching_max_latency_on_next_update(self, sentinel):
+        s = sentinel(0)
+
+        def callback(port_id):
+            s.set(s.get() + 1)
+
+        tbl = Table({"a": int})
+        view = tbl.view()
+        view.on_update(callback)
+        tbl.set_batching(max_latency_ms=50)
+        tbl.update([{"a": 1}])
+        tbl.update([{"a": 2}])
+        time.sleep(0.1)
+
+        # Without an event loop, nothing processes the batch in the
+        # background - the next update checks the latency bound.
+        assert s.get() == 0
+        tbl.update([{"a": 3}])
+        assert s.get() == 1
+        assert tbl.get_batch_stats() == {"batches": 1, "rows_coalesced": 3}
+        assert view.to_records() == [{"a": 1}, {"a": 2}, {"a": 3}]
@@ -0,0 +1,48 @@
+################################################################################
+#
+# Copyright (c) 2019, the Perspective Authors.
+#
+# This file is part of the Perspective library, distributed under the terms of
+# the Apache License 2.0.  The full license can be found in the LICENSE file.
+#
+
+from perspective.table import Table
+
+
+class TestValueCounts(object):
+    """Aggregates over the distinct values under a tree node are maintained
+    from the rows added to and removed from it by each update."""
+
+    def test_value_counts_distinct_count(self):
+        tbl = Table({"k": [1, 2, 3, 4], "g": ["x", "x", "y", "y"], "v": ["a", "b", "a", "a"]}, index="k")
+        view = tbl.view(row_pivots=["g"], columns=["v"], aggregates={"v": "distinct count"})
+        assert view.to_dict()["v"] == [2, 2, 1]
+        tbl.update({"k": [4], "v": ["c"]})
+        assert view.to_dict()["v"] == [3, 2, 2]
+        tbl.remove([2])
+        assert view.to_dict()["v"] == [2, 1, 2]
+
+    def test_value_counts_unique(self):
+        tbl = Table({"k": [1, 2, 3], "g": ["x", "x", "y"], "v": ["a", "a", "b"]}, index="k")
+        view = tbl.view(row_pivots=["g"], columns=["v"], aggregates={"v": "unique"})
+        assert view.to_dict()["v"] == ["-", "a", "b"]
+        tbl.update({"k": [2], "v": ["c"]})
+        assert view.to_dict()["v"] == ["-", "-", "b"]
+        tbl.update({"k": [2], "v": ["a"]})
+        assert view.to_dict()["v"] == ["-", "a", "b"]
+
+    def test_value_counts_join(self):
+        tbl = Table({"g": ["x", "x", "y"], "v": ["b", "a", "b"]})
+        view = tbl.view(row_pivots=["g"], columns=["v"], aggregates={"v": "join"})
+        assert view.to_dict()["v"] == ["a, b, ", "a, b, ", "b, "]
+        tbl.update({"g": ["y"], "v": ["c"]})
+        assert view.to_dict()["v"] == ["a, b, c, ", "a, b, ", "b, c, "]
+
+    def test_value_counts_pivot_change(self):
+        tbl = Table({"k": [1, 2, 3], "g": ["x", "x", "y"], "v": ["a", "b", "a"]}, index="k")
+        view = tbl.view(row_pivots=["g"], columns=["v"], aggregates={"v": "distinct count"})
+        tbl.update({"k": [2], "g": ["y"]})
+        assert view.to_dict() == {
+            "__ROW_PATH__": [[], ["x"], ["y"]],
+            "v": [2, 1, 2]
+        }
@@ -540,6 +540,51 @@ class TestViewExpression(object):
 
         assert view.to_columns() == {"a": ["abc", "abcd"], "computed": [3, 4]}
 
+    def test_view_expression_numeric_nulls(self):
+        table = Table({"a": [1.5, None, 3.5, 4.5], "b": [2.0, 4.0, 0.0, None]})
+        view = table.view(
+            expressions=[
+                '// divide \n "a" / "b"',
+                '// percent \n percent_of("a", "b")',
+                '// null \n is_null("b")',
+                '// max \n max("a", "b", 3)',
+                '// negate \n -("a" * 2) + 1',
+                '// floor \n floor("a") % 2',
+            ]
+        )
+        result = view.to_columns()
+        assert result["divide"] == [0.75, None, None, None]
+        assert result["percent"] == [75, None, None, None]
+        assert result["null"] == [0, 0, 0, 1]
+        assert result["max"] == [3, None, 3.5, None]
+        assert result["negate"] == [-2, None, -6, -8]
+        assert result["floor"] == [1, None, 1, 0]
+
+    def test_view_expression_numeric_comparison(self):
+        table = Table({"a": [1.5, 2.5, 3.5, 4.5], "b": [2.5, 2.5, 0.5, 5.5]})
+        view = table.view(
+            expressions=[
+                '// lt \n "a" < "b"',
+                '// eq \n "a" == "b"',
+                '// literal \n ("a" + 1) >= 3.5',
+            ]
+        )
+        result = view.to_columns()
+        assert result["lt"] == [1, 0, 0, 1]
+        assert result["eq"] == [0, 1, 0, 0]
+        assert result["literal"] == [0, 1, 1, 1]
+
+    def test_view_expression_numeric_partial_update(self):
+        table = Table(
+            {"x": [1, 2, 3], "a": [1.5, 2.5, 3.5], "b": [1.0, 2.0, 3.0]}, index="x"
+        )
+        view = table.view(expressions=['// computed \n "a" * "b" + 1'])
+        assert view.to_columns()["computed"] == [2.5, 6, 11.5]
+        table.update({"x": [1, 3], "a": [10.5, 0.5]})
+        assert view.to_columns()["computed"] == [11.5, 6, 2.5]
+        table.update({"x": [2, 4], "b": [0.5, 1.0]})
+        assert view.to_columns()["computed"] == [11.5, 2.25, 2.5, None]
+
     def test_view_day_of_week_date(self):
         table = Table({"a": [date(2020, 3, i) for i in range(9, 14)]})
         view = table.view(